@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+################################################################################
+#         Distributed under the Boost Software License, Version 1.0.           #
+#            (See accompanying file LICENSE or copy at                         #
+#                 https://www.boost.org/LICENSE_1_0.txt)                       #
+################################################################################
+
+"""
+Compare two iris_benchmarks results against each other.
+
+Results are the json written by google benchmark, e.g.
+
+    iris_benchmarks --benchmark_out=baseline.json --benchmark_out_format=json
+
+The script prints the change in time for every benchmark present in both files
+and exits with a non-zero status if any got slower by more than the threshold,
+so it can be used to gate a change against a stored baseline.
+
+If a benchmark was run with repetitions then the mean aggregate is compared,
+otherwise the single run is used.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path, metric):
+    """
+    Load a benchmark results file.
+
+    Returns a dict of benchmark name to (time, unit).
+    """
+    with open(path) as f:
+        data = json.load(f)
+
+    runs = {}
+    means = {}
+
+    for benchmark in data.get('benchmarks', []):
+        if benchmark.get('error_occurred', False):
+            continue
+
+        name = benchmark.get('run_name', benchmark['name'])
+        value = (benchmark[metric], benchmark.get('time_unit', 'ns'))
+
+        if benchmark.get('run_type') == 'aggregate':
+            if benchmark.get('aggregate_name') == 'mean':
+                means[name] = value
+        else:
+            # keep the first repetition, the mean will replace it if present
+            runs.setdefault(name, value)
+
+    runs.update(means)
+    return runs
+
+
+def to_ns(value):
+    """
+    Convert a (time, unit) pair to nanoseconds.
+    """
+    scale = {'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+    time, unit = value
+    return time * scale[unit]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two iris_benchmarks json results.')
+    parser.add_argument('baseline', help='results to compare against')
+    parser.add_argument('contender', help='new results')
+    parser.add_argument(
+        '--threshold',
+        type=float,
+        default=5.0,
+        help='percentage slowdown that counts as a regression (default: 5)')
+    parser.add_argument(
+        '--metric',
+        choices=['real_time', 'cpu_time'],
+        default='real_time',
+        help='time to compare (default: real_time)')
+    parser.add_argument('--filter', default='', help='only compare benchmarks containing this string')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    names = [name for name in baseline if name in contender and args.filter in name]
+    if not names:
+        print('no benchmarks in common')
+        return 1
+
+    width = max(len(name) for name in names)
+    print(f'{"benchmark":<{width}}  {"baseline":>14}  {"contender":>14}  {"change":>8}')
+
+    regressions = []
+
+    for name in names:
+        old = to_ns(baseline[name])
+        new = to_ns(contender[name])
+        change = ((new - old) / old) * 100.0 if old != 0.0 else 0.0
+
+        marker = ''
+        if change > args.threshold:
+            marker = '  REGRESSION'
+            regressions.append(name)
+        elif change < -args.threshold:
+            marker = '  improvement'
+
+        print(f'{name:<{width}}  {old:>12.1f}ns  {new:>12.1f}ns  {change:>+7.1f}%{marker}')
+
+    for name in sorted(set(baseline) - set(contender)):
+        print(f'{name}: missing from contender')
+
+    for name in sorted(set(contender) - set(baseline)):
+        print(f'{name}: new benchmark')
+
+    if regressions:
+        print(f'\n{len(regressions)} benchmark(s) regressed by more than {args.threshold}%')
+        return 1
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+void matrix4_multiply(benchmark::State &state)
+{
+    auto a = iris::Matrix4::make_look_at({1.0f, 2.0f, 3.0f}, {}, {0.0f, 1.0f, 0.0f});
+    const auto b = iris::Matrix4{iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.3f}, {4.0f, 5.0f, 6.0f}};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+
+void matrix4_multiply_vector(benchmark::State &state)
+{
+    auto m = iris::Matrix4{iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.3f}, {4.0f, 5.0f, 6.0f}};
+    const iris::Vector3 v{1.0f, 2.0f, 3.0f};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m);
+        benchmark::DoNotOptimize(m * v);
+    }
+}
+
+void matrix4_invert(benchmark::State &state)
+{
+    auto m = iris::Matrix4::make_perspective_projection(0.785f, 800.0f, 600.0f, 0.1f, 100.0f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m);
+        benchmark::DoNotOptimize(iris::Matrix4::invert(m));
+    }
+}
+
+void matrix4_transpose(benchmark::State &state)
+{
+    auto m = iris::Matrix4::make_look_at({1.0f, 2.0f, 3.0f}, {}, {0.0f, 1.0f, 0.0f});
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(m);
+        benchmark::DoNotOptimize(iris::Matrix4::transpose(m));
+    }
+}
+
+void matrix4_from_quaternion(benchmark::State &state)
+{
+    auto q = iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.3f};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(q);
+        benchmark::DoNotOptimize(iris::Matrix4{q});
+    }
+}
+
+}
+
+BENCHMARK(matrix4_multiply);
+BENCHMARK(matrix4_multiply_vector);
+BENCHMARK(matrix4_invert);
+BENCHMARK(matrix4_transpose);
+BENCHMARK(matrix4_from_quaternion);
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "core/quaternion.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+void quaternion_multiply(benchmark::State &state)
+{
+    auto a = iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.3f};
+    const auto b = iris::Quaternion{{1.0f, 0.0f, 0.0f}, 1.2f};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+
+void quaternion_from_euler(benchmark::State &state)
+{
+    auto yaw = 0.1f;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(yaw);
+        benchmark::DoNotOptimize(iris::Quaternion{yaw, 0.2f, 0.3f});
+    }
+}
+
+void quaternion_normalise(benchmark::State &state)
+{
+    const auto q = iris::Quaternion{1.0f, 2.0f, 3.0f, 4.0f};
+
+    for (auto _ : state)
+    {
+        auto copy = q;
+        benchmark::DoNotOptimize(copy.normalise());
+    }
+}
+
+void quaternion_slerp(benchmark::State &state)
+{
+    const auto from = iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.3f};
+    const auto to = iris::Quaternion{{1.0f, 0.0f, 0.0f}, 1.2f};
+    auto amount = 0.25f;
+
+    for (auto _ : state)
+    {
+        auto q = from;
+        benchmark::DoNotOptimize(amount);
+        q.slerp(to, amount);
+        benchmark::DoNotOptimize(q);
+    }
+}
+
+}
+
+BENCHMARK(quaternion_multiply);
+BENCHMARK(quaternion_from_euler);
+BENCHMARK(quaternion_normalise);
+BENCHMARK(quaternion_slerp);
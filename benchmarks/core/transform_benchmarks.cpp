@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/transform.h"
+#include "core/vector3.h"
+
+namespace
+{
+
+iris::Transform make_transform(float angle)
+{
+    return {{1.0f, 2.0f, 3.0f}, {{0.0f, 1.0f, 0.0f}, angle}, {1.0f, 2.0f, 1.0f}};
+}
+
+void transform_matrix(benchmark::State &state)
+{
+    auto transform = make_transform(0.3f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(transform);
+        benchmark::DoNotOptimize(transform.matrix());
+    }
+}
+
+void transform_set_matrix(benchmark::State &state)
+{
+    const auto matrix = make_transform(0.3f).matrix();
+    iris::Transform transform{};
+
+    for (auto _ : state)
+    {
+        transform.set_matrix(matrix);
+        benchmark::DoNotOptimize(transform);
+    }
+}
+
+void transform_multiply(benchmark::State &state)
+{
+    auto a = make_transform(0.3f);
+    const auto b = make_transform(1.2f);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+
+void transform_interpolate(benchmark::State &state)
+{
+    const auto from = make_transform(0.3f);
+    const auto to = make_transform(1.2f);
+
+    for (auto _ : state)
+    {
+        auto transform = from;
+        transform.interpolate(to, 0.5f);
+        benchmark::DoNotOptimize(transform);
+    }
+}
+
+}
+
+BENCHMARK(transform_matrix);
+BENCHMARK(transform_set_matrix);
+BENCHMARK(transform_multiply);
+BENCHMARK(transform_interpolate);
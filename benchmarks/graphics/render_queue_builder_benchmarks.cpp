@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "core/transform.h"
+#include "core/vector3.h"
+#include "graphics/lights/directional_light.h"
+#include "graphics/lights/point_light.h"
+#include "graphics/material.h"
+#include "graphics/render_pass.h"
+#include "graphics/render_queue_builder.h"
+#include "graphics/render_target.h"
+#include "graphics/scene.h"
+
+#include "fakes/fake_material.h"
+#include "fakes/fake_render_target.h"
+
+namespace
+{
+
+/**
+ * Build a render queue for a fake scene, materials and render targets are
+ * fakes so this is just the cost of walking the scene and emitting commands.
+ *
+ * Arguments are (entities, point lights, shadow casting directional lights).
+ */
+void render_queue_builder_build(benchmark::State &state)
+{
+    FakeMaterial material{};
+    FakeRenderTarget render_target{};
+
+    const iris::RenderQueueBuilder builder{
+        [&material](auto *, auto *, const auto *, auto) { return &material; },
+        [&render_target](auto, auto) { return &render_target; }};
+
+    iris::Scene scene{};
+
+    for (auto i = 0u; i < state.range(0); ++i)
+    {
+        scene.create_entity(nullptr, nullptr, iris::Transform{{static_cast<float>(i), 0.0f, 0.0f}, {}, {1.0f}});
+    }
+
+    for (auto i = 0u; i < state.range(1); ++i)
+    {
+        scene.create_light<iris::PointLight>(iris::Vector3{static_cast<float>(i), 10.0f, 0.0f});
+    }
+
+    for (auto i = 0u; i < state.range(2); ++i)
+    {
+        scene.create_light<iris::DirectionalLight>(iris::Vector3{-1.0f, -1.0f, 0.0f}, true);
+    }
+
+    const std::vector<iris::RenderPass> passes{{std::addressof(scene), nullptr, nullptr}};
+
+    for (auto _ : state)
+    {
+        // build inserts shadow passes, so always start from the original
+        auto copy = passes;
+        benchmark::DoNotOptimize(builder.build(copy));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(render_queue_builder_build)->Args({16, 0, 1})->Args({256, 4, 1})->Args({4096, 8, 2});
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/matrix4.h"
+#include "core/quaternion.h"
+#include "core/transform.h"
+#include "core/vector3.h"
+#include "graphics/animation.h"
+#include "graphics/bone.h"
+#include "graphics/keyframe.h"
+#include "graphics/skeleton.h"
+#include "graphics/weight.h"
+
+namespace
+{
+
+/**
+ * Helper method to create a balanced binary tree of bones, with an animation
+ * that has keyframes for every bone.
+ *
+ * @param bone_count
+ *   Number of bones.
+ *
+ * @param keyframe_count
+ *   Number of keyframes per bone.
+ *
+ * @returns
+ *   Skeleton with a single animation called "animation".
+ */
+iris::Skeleton create_skeleton(std::size_t bone_count, std::size_t keyframe_count)
+{
+    std::vector<iris::Bone> bones{};
+    std::map<std::string, std::vector<iris::KeyFrame>> frames{};
+
+    for (auto i = 0u; i < bone_count; ++i)
+    {
+        const auto name = "bone" + std::to_string(i);
+        const auto parent = (i == 0u) ? std::string{} : "bone" + std::to_string((i - 1u) / 2u);
+
+        bones.emplace_back(name, parent, std::vector<iris::Weight>{}, iris::Matrix4{}, iris::Matrix4{});
+
+        for (auto j = 0u; j < keyframe_count; ++j)
+        {
+            const auto angle = static_cast<float>(j) / static_cast<float>(keyframe_count);
+
+            frames[name].emplace_back(
+                iris::Transform{{0.0f, 1.0f, 0.0f}, {{0.0f, 0.0f, 1.0f}, angle}, {1.0f}},
+                std::chrono::milliseconds(j * 100u));
+        }
+    }
+
+    const auto duration = std::chrono::milliseconds(keyframe_count * 100u);
+
+    iris::Skeleton skeleton{std::move(bones), {iris::Animation{duration, "animation", frames}}};
+    skeleton.set_animation("animation");
+
+    return skeleton;
+}
+
+/**
+ * Advance a skeleton, i.e. interpolate keyframes and update every bone
+ * transform.
+ *
+ * Argument is number of bones, skeletons are limited to 100.
+ */
+void skeleton_advance(benchmark::State &state)
+{
+    auto skeleton = create_skeleton(static_cast<std::size_t>(state.range(0)), 16u);
+
+    for (auto _ : state)
+    {
+        skeleton.advance();
+        benchmark::DoNotOptimize(skeleton.transforms().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(skeleton_advance)->Arg(1)->Arg(32)->Arg(100);
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "core/data_buffer.h"
+#include "core/resource_loader.h"
+#include "graphics/texture.h"
+#include "graphics/texture_manager.h"
+#include "graphics/texture_usage.h"
+
+#include "fakes/fake_texture.h"
+
+namespace
+{
+
+/**
+ * Texture manager which doesn't talk to a graphics api, so only the image
+ * parsing is measured.
+ */
+class FakeTextureManager : public iris::TextureManager
+{
+  protected:
+    std::unique_ptr<iris::Texture> do_create(const iris::DataBuffer &, std::uint32_t, std::uint32_t, iris::TextureUsage)
+        override
+    {
+        return std::make_unique<FakeTexture>();
+    }
+};
+
+/**
+ * Helper method to append a little endian integer to a buffer.
+ *
+ * @param buffer
+ *   Buffer to append to.
+ *
+ * @param value
+ *   Value to write.
+ *
+ * @param size
+ *   Number of bytes to write.
+ */
+void write_le(std::string &buffer, std::uint32_t value, std::size_t size)
+{
+    for (auto i = 0u; i < size; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (i * 8u)) & 0xffu));
+    }
+}
+
+/**
+ * Helper method to write a 24 bit uncompressed bmp to the temp directory and
+ * point the resource loader at it.
+ *
+ * @param size
+ *   Width and height of image.
+ *
+ * @returns
+ *   Resource name of image.
+ */
+std::string write_image(std::uint32_t size)
+{
+    const auto row_size = ((size * 3u) + 3u) & ~3u;
+    const auto image_size = row_size * size;
+
+    std::string bmp{"BM"};
+    write_le(bmp, 54u + image_size, 4u);
+    write_le(bmp, 0u, 4u);
+    write_le(bmp, 54u, 4u);
+    write_le(bmp, 40u, 4u);
+    write_le(bmp, size, 4u);
+    write_le(bmp, size, 4u);
+    write_le(bmp, 1u, 2u);
+    write_le(bmp, 24u, 2u);
+    write_le(bmp, 0u, 4u);
+    write_le(bmp, image_size, 4u);
+    write_le(bmp, 2835u, 4u);
+    write_le(bmp, 2835u, 4u);
+    write_le(bmp, 0u, 4u);
+    write_le(bmp, 0u, 4u);
+
+    for (auto y = 0u; y < size; ++y)
+    {
+        for (auto x = 0u; x < row_size; ++x)
+        {
+            bmp.push_back(static_cast<char>((x ^ y) & 0xffu));
+        }
+    }
+
+    const auto root = std::filesystem::temp_directory_path();
+    const auto resource = "iris_benchmark_" + std::to_string(size) + ".bmp";
+
+    std::ofstream out{root / resource, std::ios::out | std::ios::binary};
+    out.write(bmp.data(), bmp.size());
+
+    iris::ResourceLoader::instance().set_root_directory(root);
+
+    return resource;
+}
+
+/**
+ * Load (and then unload) an image. The resource loader caches file data so
+ * this is the cost of decoding and expanding to RGBA.
+ *
+ * Argument is width and height of image.
+ */
+void texture_manager_load(benchmark::State &state)
+{
+    const auto resource = write_image(static_cast<std::uint32_t>(state.range(0)));
+    FakeTextureManager texture_manager{};
+
+    for (auto _ : state)
+    {
+        texture_manager.unload(texture_manager.load(resource));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+
+}
+
+BENCHMARK(texture_manager_load)->Arg(64)->Arg(512)->Arg(2048)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "jobs/concurrent_queue.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/spsc_queue.h"
+
+namespace
+{
+
+/**
+ * Enqueue then dequeue a single element, i.e. the uncontended cost of a round
+ * trip.
+ */
+template <class Queue>
+void queue_round_trip(benchmark::State &state)
+{
+    Queue queue{};
+    auto value = std::uint64_t{0u};
+
+    for (auto _ : state)
+    {
+        queue.enqueue(value);
+        queue.try_dequeue(value);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Move a fixed number of elements from producer threads to consumer threads.
+ *
+ * Arguments are (producers, consumers).
+ */
+template <class Queue>
+void queue_transfer(benchmark::State &state)
+{
+    static constexpr auto count = std::size_t{1u} << 16u;
+
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+
+    for (auto _ : state)
+    {
+        Queue queue{};
+        std::atomic<std::size_t> consumed = 0u;
+        std::vector<std::thread> threads{};
+
+        for (auto i = 0u; i < producers; ++i)
+        {
+            threads.emplace_back(
+                [&queue, producers]
+                {
+                    for (auto j = std::size_t{0u}; j < count / producers; ++j)
+                    {
+                        queue.enqueue(j);
+                    }
+                });
+        }
+
+        for (auto i = 0u; i < consumers; ++i)
+        {
+            threads.emplace_back(
+                [&queue, &consumed]
+                {
+                    std::size_t value = 0u;
+
+                    while (consumed.load(std::memory_order_relaxed) < count)
+                    {
+                        if (queue.try_dequeue(value))
+                        {
+                            consumed.fetch_add(1u, std::memory_order_relaxed);
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+}
+
+BENCHMARK_TEMPLATE(queue_round_trip, iris::ConcurrentQueue<std::uint64_t>);
+BENCHMARK_TEMPLATE(queue_round_trip, iris::MpmcQueue<std::uint64_t>);
+BENCHMARK_TEMPLATE(queue_round_trip, iris::SpscQueue<std::uint64_t>);
+
+BENCHMARK_TEMPLATE(queue_transfer, iris::ConcurrentQueue<std::size_t>)
+    ->Args({1, 1})
+    ->Args({4, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_transfer, iris::MpmcQueue<std::size_t>)
+    ->Args({1, 1})
+    ->Args({4, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(queue_transfer, iris::SpscQueue<std::size_t>)->Args({1, 1})->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "jobs/fiber/fiber_event.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_mutex.h"
+#include "jobs/fiber/fiber_semaphore.h"
+#include "jobs/job.h"
+
+#include "helper.h"
+
+namespace
+{
+
+constexpr auto worker_count = std::size_t{4u};
+constexpr auto iterations = 256;
+
+/**
+ * Many more fibers than workers all contending on a single mutex.
+ *
+ * Argument is the number of fibers.
+ */
+void fiber_mutex_contention(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{worker_count};
+    iris::FiberMutex mutex{};
+    auto value = 0;
+
+    const std::vector<iris::Job> jobs(
+        static_cast<std::size_t>(state.range(0)),
+        [&mutex, &value]
+        {
+            for (auto i = 0; i < iterations; ++i)
+            {
+                std::scoped_lock lock(mutex);
+                ++value;
+                busy_work(8u);
+            }
+        });
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+    }
+
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations() * state.range(0) * iterations);
+}
+
+/**
+ * Many more fibers than workers sharing a semaphore with one permit per
+ * worker.
+ *
+ * Argument is the number of fibers.
+ */
+void fiber_semaphore_contention(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{worker_count};
+    iris::FiberSemaphore semaphore{static_cast<std::ptrdiff_t>(worker_count)};
+
+    const std::vector<iris::Job> jobs(
+        static_cast<std::size_t>(state.range(0)),
+        [&semaphore]
+        {
+            for (auto i = 0; i < iterations; ++i)
+            {
+                semaphore.acquire();
+                busy_work(8u);
+                semaphore.release();
+            }
+        });
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * iterations);
+}
+
+/**
+ * Many fibers suspended on a single event which is then set, i.e. the cost of
+ * suspending and rescheduling a batch of fibers.
+ *
+ * Argument is the number of waiting fibers.
+ */
+void fiber_event_broadcast(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{worker_count};
+    iris::FiberEvent event{};
+
+    std::vector<iris::Job> jobs(static_cast<std::size_t>(state.range(0)), [&event] { event.wait(); });
+    jobs.emplace_back(
+        [&event]
+        {
+            busy_work(1024u);
+            event.set();
+        });
+
+    for (auto _ : state)
+    {
+        event.reset();
+        job_system.wait_for_jobs(jobs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(fiber_mutex_contention)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(fiber_semaphore_contention)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(fiber_event_broadcast)->Arg(16)->Arg(256)->UseRealTime();
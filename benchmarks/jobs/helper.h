@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+/**
+ * Helper method to simulate a small amount of cpu bound work, roughly a few
+ * nanoseconds per iteration.
+ *
+ * @param iterations
+ *   Number of iterations of work to do.
+ */
+inline void busy_work(std::uint32_t iterations)
+{
+    auto value = 1.0f;
+
+    for (auto i = 0u; i < iterations; ++i)
+    {
+        value = (value * 1.0001f) + 0.5f;
+        benchmark::DoNotOptimize(value);
+    }
+}
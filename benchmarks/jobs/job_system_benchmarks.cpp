@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/idle_strategy.h"
+#include "jobs/job.h"
+#include "jobs/thread/thread_job_system.h"
+
+#include "helper.h"
+
+namespace
+{
+
+/**
+ * Helper method to create a batch of small jobs.
+ *
+ * @param count
+ *   Number of jobs.
+ *
+ * @param work
+ *   Iterations of busy work each job does.
+ *
+ * @returns
+ *   Jobs.
+ */
+std::vector<iris::Job> create_jobs(std::size_t count, std::uint32_t work)
+{
+    return std::vector<iris::Job>(count, [work] { busy_work(work); });
+}
+
+/**
+ * Jobs per second for a batch of small jobs.
+ *
+ * Argument is number of jobs per batch.
+ */
+template <class JobSystem>
+void job_system_throughput(benchmark::State &state)
+{
+    JobSystem job_system{};
+    const auto jobs = create_jobs(static_cast<std::size_t>(state.range(0)), 16u);
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Jobs per second as the number of fiber workers grows.
+ *
+ * Argument is number of workers.
+ */
+void fiber_job_system_scaling(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{static_cast<std::size_t>(state.range(0))};
+    const auto jobs = create_jobs(4096u, 256u);
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+
+/**
+ * Latency of a single job submitted to an otherwise idle job system, along
+ * with how often workers had to be woken (each wakeup is a futex wake
+ * syscall, or the platform equivalent).
+ *
+ * Argument is whether workers spin before parking (1) or park straight away
+ * (0).
+ */
+void fiber_job_system_wake_latency(benchmark::State &state)
+{
+    iris::FiberJobSystemConfig config{};
+    config.worker_count = 4u;
+    if (state.range(0) == 0)
+    {
+        config.idle = {.spin_count = 0u, .yield_count = 0u};
+    }
+
+    iris::FiberJobSystem job_system{config};
+    std::atomic<bool> done = false;
+    const std::vector<iris::Job> jobs{[&done] { done.store(true, std::memory_order_release); }};
+
+    const auto before = job_system.stats();
+
+    for (auto _ : state)
+    {
+        done = false;
+        job_system.add_jobs(jobs);
+
+        while (!done.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    const auto after = job_system.stats();
+    const auto wakeups = after.wakeups - before.wakeups;
+
+    state.counters["parks"] =
+        benchmark::Counter(static_cast<double>(after.parks - before.parks), benchmark::Counter::kAvgIterations);
+    state.counters["wake_calls"] = benchmark::Counter(
+        static_cast<double>(after.wake_calls - before.wake_calls), benchmark::Counter::kAvgIterations);
+    state.counters["wakeups"] = benchmark::Counter(static_cast<double>(wakeups), benchmark::Counter::kAvgIterations);
+    state.counters["wake_latency_ns"] =
+        (wakeups == 0u) ? 0.0
+                        : static_cast<double>(after.wake_latency_ns - before.wake_latency_ns) /
+                              static_cast<double>(wakeups);
+}
+
+}
+
+BENCHMARK_TEMPLATE(job_system_throughput, iris::ThreadJobSystem)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK_TEMPLATE(job_system_throughput, iris::FiberJobSystem)->Arg(64)->Arg(1024)->UseRealTime();
+
+BENCHMARK(fiber_job_system_scaling)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Arg(32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(fiber_job_system_wake_latency)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/job.h"
+#include "jobs/job_trace.h"
+
+namespace
+{
+
+/**
+ * Cost of recording a single trace event. A job records at least enqueue,
+ * start and end so the per job overhead is roughly three times this.
+ */
+void job_tracer_record(benchmark::State &state)
+{
+    auto id = std::uint64_t{0u};
+
+    for (auto _ : state)
+    {
+        iris::JobTracer::record(iris::JobTraceEventType::START, ++id, 0u);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Cost of the events every job records, this is the tracing overhead per job
+ * without the noise of scheduling.
+ */
+void job_tracer_job_events(benchmark::State &state)
+{
+    auto id = std::uint64_t{0u};
+
+    for (auto _ : state)
+    {
+        ++id;
+        iris::JobTracer::record(iris::JobTraceEventType::ENQUEUE, id, 0u);
+        iris::JobTracer::record(iris::JobTraceEventType::START, id, 0u);
+        iris::JobTracer::record(iris::JobTraceEventType::END, id, 0u);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * Per job cost of a batch of empty jobs. Comparing the results from a build
+ * with IRIS_ENABLE_JOB_TRACING against one without gives the overhead of the
+ * instrumentation.
+ */
+void job_tracer_empty_jobs(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{};
+    const std::vector<iris::Job> jobs(1024u, [] {});
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+
+#if defined(IRIS_ENABLE_JOB_TRACING)
+    state.SetLabel("traced");
+#else
+    state.SetLabel("untraced");
+#endif
+}
+
+}
+
+BENCHMARK(job_tracer_record);
+BENCHMARK(job_tracer_job_events);
+BENCHMARK(job_tracer_empty_jobs)->UseRealTime();
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "core/vector3.h"
+#include "jobs/fiber/fiber_job_system_manager.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+namespace
+{
+
+constexpr auto image_size = std::size_t{256u};
+
+/**
+ * Simple sphere, see the jobs sample for a fuller path tracer.
+ */
+struct Sphere
+{
+    iris::Vector3 origin;
+    float radius;
+    iris::Vector3 colour;
+};
+
+const std::array<Sphere, 4u> spheres{{
+    {{0.0f, -1001.0f, -5.0f}, 1000.0f, {0.8f, 0.8f, 0.8f}},
+    {{-1.5f, 0.0f, -6.0f}, 1.0f, {0.9f, 0.2f, 0.2f}},
+    {{0.0f, 0.0f, -4.0f}, 1.0f, {0.2f, 0.9f, 0.2f}},
+    {{1.5f, 0.0f, -6.0f}, 1.0f, {0.2f, 0.2f, 0.9f}},
+}};
+
+/**
+ * Find the nearest sphere a ray hits.
+ *
+ * @param origin
+ *   Ray origin.
+ *
+ * @param direction
+ *   Normalised ray direction.
+ *
+ * @returns
+ *   Distance to nearest hit and index of sphere, index is spheres.size() for a
+ *   miss.
+ */
+std::pair<float, std::size_t> trace(const iris::Vector3 &origin, const iris::Vector3 &direction)
+{
+    auto nearest = std::numeric_limits<float>::max();
+    auto hit = spheres.size();
+
+    for (auto i = 0u; i < spheres.size(); ++i)
+    {
+        const auto l = spheres[i].origin - origin;
+        const auto tca = l.dot(direction);
+        const auto d2 = l.dot(l) - (tca * tca);
+        const auto r2 = spheres[i].radius * spheres[i].radius;
+
+        if (d2 <= r2)
+        {
+            const auto thc = std::sqrt(r2 - d2);
+            const auto t = ((tca - thc) > 0.001f) ? tca - thc : tca + thc;
+
+            if ((t > 0.001f) && (t < nearest))
+            {
+                nearest = t;
+                hit = i;
+            }
+        }
+    }
+
+    return {nearest, hit};
+}
+
+/**
+ * Shade a single pixel with a primary ray and a shadow ray.
+ *
+ * @param index
+ *   Pixel index.
+ *
+ * @returns
+ *   Pixel colour.
+ */
+iris::Vector3 shade(std::size_t index)
+{
+    static const auto light = iris::Vector3::normalise({1.0f, 1.0f, 1.0f});
+
+    const auto x = (static_cast<float>(index % image_size) / image_size) - 0.5f;
+    const auto y = 0.5f - (static_cast<float>(index / image_size) / image_size);
+    const auto direction = iris::Vector3::normalise({x, y, -1.0f});
+
+    const auto [distance, hit] = trace({}, direction);
+    if (hit == spheres.size())
+    {
+        return {0.5f, 0.7f, 1.0f};
+    }
+
+    const auto point = direction * distance;
+    const auto normal = iris::Vector3::normalise(point - spheres[hit].origin);
+    const auto in_shadow = trace(point, light).second != spheres.size();
+    const auto diffuse = in_shadow ? 0.1f : std::max(0.1f, normal.dot(light));
+
+    return spheres[hit].colour * diffuse;
+}
+
+/**
+ * Ray trace a small image with a parallel_for over every pixel, this mirrors
+ * the jobs sample.
+ *
+ * Argument is the grain, zero lets parallel_for pick.
+ */
+template <class Manager>
+void parallel_for_ray_trace(benchmark::State &state)
+{
+    Manager manager{};
+    manager.create_job_system();
+
+    std::vector<iris::Vector3> pixels(image_size * image_size);
+    const auto grain = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        manager.parallel_for(0u, pixels.size(), grain, [&pixels](std::size_t i) { pixels[i] = shade(i); });
+        benchmark::DoNotOptimize(pixels.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * pixels.size());
+}
+
+/**
+ * Single threaded baseline for parallel_for_ray_trace.
+ */
+void serial_ray_trace(benchmark::State &state)
+{
+    std::vector<iris::Vector3> pixels(image_size * image_size);
+
+    for (auto _ : state)
+    {
+        for (auto i = 0u; i < pixels.size(); ++i)
+        {
+            pixels[i] = shade(i);
+        }
+        benchmark::DoNotOptimize(pixels.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * pixels.size());
+}
+
+}
+
+BENCHMARK(serial_ray_trace)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(parallel_for_ray_trace, iris::FiberJobSystemManager)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(256)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(parallel_for_ray_trace, iris::ThreadJobSystemManager)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(256)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
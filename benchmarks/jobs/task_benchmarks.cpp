@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <utility>
+#include <vector>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job.h"
+#include "jobs/task.h"
+#include "jobs/task_awaitables.h"
+
+namespace
+{
+
+constexpr auto suspend_count = 1024u;
+
+/**
+ * Coroutine which repeatedly suspends on a single empty job.
+ *
+ * @param job_system
+ *   Job system to run on.
+ */
+iris::Task<> suspend_task(iris::JobSystem &job_system)
+{
+    co_await iris::schedule(job_system);
+
+    for (auto i = 0u; i < suspend_count; ++i)
+    {
+        std::vector<iris::InplaceJob> jobs{};
+        jobs.emplace_back([] {});
+        co_await iris::run_jobs(job_system, std::move(jobs));
+    }
+}
+
+/**
+ * Coroutine which repeatedly hops back on to the job system.
+ *
+ * @param job_system
+ *   Job system to run on.
+ */
+iris::Task<> schedule_task(iris::JobSystem &job_system)
+{
+    for (auto i = 0u; i < suspend_count; ++i)
+    {
+        co_await iris::schedule(job_system);
+    }
+}
+
+/**
+ * Suspend and resume a coroutine by waiting on a single empty job.
+ */
+void task_suspend_resume(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{};
+
+    for (auto _ : state)
+    {
+        iris::sync_wait(suspend_task(job_system));
+    }
+
+    state.SetItemsProcessed(state.iterations() * suspend_count);
+}
+
+/**
+ * Resume a coroutine as a job.
+ */
+void task_schedule(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{};
+
+    for (auto _ : state)
+    {
+        iris::sync_wait(schedule_task(job_system));
+    }
+
+    state.SetItemsProcessed(state.iterations() * suspend_count);
+}
+
+/**
+ * Suspend and resume a fiber by waiting on a single empty job, the fiber
+ * equivalent of task_suspend_resume.
+ */
+void fiber_suspend_resume(benchmark::State &state)
+{
+    iris::FiberJobSystem job_system{};
+    const std::vector<iris::Job> empty{[] {}};
+
+    const std::vector<iris::Job> jobs{[&job_system, &empty]
+                                      {
+                                          for (auto i = 0u; i < suspend_count; ++i)
+                                          {
+                                              job_system.wait_for_jobs(empty);
+                                          }
+                                      }};
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * suspend_count);
+}
+
+}
+
+BENCHMARK(task_suspend_resume)->UseRealTime();
+BENCHMARK(task_schedule)->UseRealTime();
+BENCHMARK(fiber_suspend_resume)->UseRealTime();
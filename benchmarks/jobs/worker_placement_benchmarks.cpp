@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/job.h"
+
+namespace
+{
+
+/**
+ * Memory bound jobs, each summing its own slice of a buffer much larger than
+ * the last level cache. Run with pinned and unpinned workers to see the effect
+ * of placement.
+ *
+ * Argument is whether workers are pinned.
+ */
+void worker_placement_memory_bound(benchmark::State &state)
+{
+    static constexpr auto slice_size = std::size_t{1u} << 20u;
+    static constexpr auto slice_count = std::size_t{64u};
+
+    iris::FiberJobSystemConfig config{};
+    config.placement.pin_workers = state.range(0) != 0;
+
+    iris::FiberJobSystem job_system{config};
+    std::vector<std::uint64_t> buffer(slice_size * slice_count, 1u);
+    std::vector<std::uint64_t> sums(slice_count);
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0u; i < slice_count; ++i)
+    {
+        jobs.emplace_back(
+            [&buffer, &sums, i]
+            {
+                const auto *begin = buffer.data() + (i * slice_size);
+                sums[i] = std::accumulate(begin, begin + slice_size, std::uint64_t{0u});
+            });
+    }
+
+    for (auto _ : state)
+    {
+        job_system.wait_for_jobs(jobs);
+        benchmark::DoNotOptimize(sums.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * buffer.size() * sizeof(std::uint64_t));
+    state.SetLabel(config.placement.pin_workers ? "pinned" : "unpinned");
+}
+
+}
+
+BENCHMARK(worker_placement_memory_bound)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
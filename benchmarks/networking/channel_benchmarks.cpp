@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "core/data_buffer.h"
+#include "networking/channel/channel_type.h"
+#include "networking/channel/reliable_ordered_channel.h"
+#include "networking/channel/unreliable_sequenced_channel.h"
+#include "networking/channel/unreliable_unordered_channel.h"
+#include "networking/packet.h"
+#include "networking/packet_type.h"
+
+namespace
+{
+
+/**
+ * Send a batch of packets from one channel to another, with any packets the
+ * receiver sends back (e.g. acks) delivered to the sender. There is no loss
+ * so this is the cost of the happy path.
+ *
+ * Argument is number of packets per batch.
+ */
+template <class Channel, iris::ChannelType Type>
+void channel_loopback(benchmark::State &state)
+{
+    const iris::Packet packet{iris::PacketType::DATA, Type, iris::DataBuffer(64u, std::byte{0xaa})};
+
+    for (auto _ : state)
+    {
+        Channel sender{};
+        Channel receiver{};
+
+        for (auto i = 0u; i < state.range(0); ++i)
+        {
+            sender.enqueue_send(packet);
+        }
+
+        for (const auto &sent : sender.yield_send_queue())
+        {
+            receiver.enqueue_receive(sent);
+        }
+
+        for (const auto &reply : receiver.yield_send_queue())
+        {
+            sender.enqueue_receive(reply);
+        }
+
+        benchmark::DoNotOptimize(receiver.yield_receive_queue());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Send a single message through a reliable channel, fragmenting it if it is
+ * larger than a packet. The counters give the number of datagrams and bytes
+ * (including UDP/IP headers) put on the wire per message.
+ *
+ * Argument is message size in bytes.
+ */
+void reliable_ordered_message(benchmark::State &state)
+{
+    // size of an IPv4 and UDP header
+    static constexpr auto udp_ip_header_size = 28u;
+
+    const iris::DataBuffer message(static_cast<std::size_t>(state.range(0)), std::byte{0xaa});
+    auto datagrams = 0u;
+    auto wire_bytes = 0u;
+
+    for (auto _ : state)
+    {
+        iris::ReliableOrderedChannel sender{};
+        iris::ReliableOrderedChannel receiver{};
+
+        sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, message});
+
+        const auto sent = sender.yield_send_queue();
+        for (const auto &packet : sent)
+        {
+            receiver.enqueue_receive(packet);
+        }
+
+        benchmark::DoNotOptimize(receiver.yield_receive_queue());
+
+        datagrams = static_cast<unsigned>(sent.size());
+        wire_bytes = 0u;
+        for (const auto &packet : sent)
+        {
+            wire_bytes += static_cast<unsigned>(packet.packet_size()) + udp_ip_header_size;
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    state.counters["datagrams"] = datagrams;
+    state.counters["wire_bytes"] = wire_bytes;
+}
+
+}
+
+BENCHMARK_TEMPLATE2(channel_loopback, iris::UnreliableUnorderedChannel, iris::ChannelType::UNRELIABLE_UNORDERED)
+    ->Arg(1)
+    ->Arg(64);
+BENCHMARK_TEMPLATE2(channel_loopback, iris::UnreliableSequencedChannel, iris::ChannelType::UNRELIABLE_SEQUENCED)
+    ->Arg(1)
+    ->Arg(64);
+BENCHMARK_TEMPLATE2(channel_loopback, iris::ReliableOrderedChannel, iris::ChannelType::RELIABLE_ORDERED)
+    ->Arg(1)
+    ->Arg(64);
+
+// 68 bytes is the world snapshot the networking sample sends
+BENCHMARK(reliable_ordered_message)->Arg(68)->Arg(1024)->Arg(4096)->Arg(16384);
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/data_buffer.h"
+#include "core/quaternion.h"
+#include "core/vector3.h"
+#include "networking/data_buffer_deserialiser.h"
+#include "networking/data_buffer_serialiser.h"
+
+namespace
+{
+
+/**
+ * Serialise the state of a number of entities, as a server would for a
+ * snapshot.
+ *
+ * Argument is number of entities.
+ */
+void data_buffer_serialiser_entities(benchmark::State &state)
+{
+    const iris::Vector3 position{1.0f, 2.0f, 3.0f};
+    const iris::Quaternion rotation{{0.0f, 1.0f, 0.0f}, 0.3f};
+
+    for (auto _ : state)
+    {
+        iris::DataBufferSerialiser serialiser{};
+
+        for (auto i = 0u; i < state.range(0); ++i)
+        {
+            serialiser.push(static_cast<std::uint32_t>(i));
+            serialiser.push(position);
+            serialiser.push(rotation);
+        }
+
+        benchmark::DoNotOptimize(serialiser.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Deserialise the state of a number of entities.
+ *
+ * Argument is number of entities.
+ */
+void data_buffer_deserialiser_entities(benchmark::State &state)
+{
+    iris::DataBufferSerialiser serialiser{};
+
+    for (auto i = 0u; i < state.range(0); ++i)
+    {
+        serialiser.push(static_cast<std::uint32_t>(i));
+        serialiser.push(iris::Vector3{1.0f, 2.0f, 3.0f});
+        serialiser.push(iris::Quaternion{{0.0f, 1.0f, 0.0f}, 0.3f});
+    }
+
+    const auto data = serialiser.data();
+
+    for (auto _ : state)
+    {
+        iris::DataBufferDeserialiser deserialiser{data};
+
+        for (auto i = 0u; i < state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(deserialiser.pop_tuple<std::uint32_t, iris::Vector3, iris::Quaternion>());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Round trip a buffer, i.e. the length prefixed copy in and out.
+ *
+ * Argument is buffer size in bytes.
+ */
+void data_buffer_serialiser_buffer(benchmark::State &state)
+{
+    const iris::DataBuffer buffer(static_cast<std::size_t>(state.range(0)), std::byte{0xaa});
+
+    for (auto _ : state)
+    {
+        iris::DataBufferSerialiser serialiser{};
+        serialiser.push(buffer);
+
+        iris::DataBufferDeserialiser deserialiser{serialiser.data()};
+        benchmark::DoNotOptimize(deserialiser.pop<iris::DataBuffer>());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(data_buffer_serialiser_entities)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(data_buffer_deserialiser_entities)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(data_buffer_serialiser_buffer)->Arg(16)->Arg(1024)->Arg(65536);
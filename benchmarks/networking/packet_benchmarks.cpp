@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "core/data_buffer.h"
+#include "networking/channel/channel_type.h"
+#include "networking/packet.h"
+#include "networking/packet_type.h"
+
+namespace
+{
+
+/**
+ * Build a packet from a body, as is done for every send.
+ *
+ * Argument is body size in bytes.
+ */
+void packet_create(benchmark::State &state)
+{
+    const iris::DataBuffer body(static_cast<std::size_t>(state.range(0)), std::byte{0xaa});
+
+    for (auto _ : state)
+    {
+        iris::Packet packet{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, body};
+        benchmark::DoNotOptimize(packet);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Parse a packet from raw bytes, as is done for every receive.
+ *
+ * Argument is body size in bytes.
+ */
+void packet_parse(benchmark::State &state)
+{
+    const iris::Packet packet{
+        iris::PacketType::DATA,
+        iris::ChannelType::RELIABLE_ORDERED,
+        iris::DataBuffer(static_cast<std::size_t>(state.range(0)), std::byte{0xaa})};
+    const iris::DataBuffer raw{packet.data(), packet.data() + packet.packet_size()};
+
+    for (auto _ : state)
+    {
+        iris::Packet parsed{raw};
+        benchmark::DoNotOptimize(parsed.is_valid());
+    }
+
+    state.SetBytesProcessed(state.iterations() * raw.size());
+}
+
+/**
+ * Copy the body out of a packet.
+ *
+ * Argument is body size in bytes.
+ */
+void packet_body_buffer(benchmark::State &state)
+{
+    const iris::Packet packet{
+        iris::PacketType::DATA,
+        iris::ChannelType::RELIABLE_ORDERED,
+        iris::DataBuffer(static_cast<std::size_t>(state.range(0)), std::byte{0xaa})};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(packet.body_buffer());
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(packet_create)->Arg(16)->Arg(120)->Arg(1024);
+BENCHMARK(packet_parse)->Arg(16)->Arg(120)->Arg(1024);
+BENCHMARK(packet_body_buffer)->Arg(16)->Arg(120)->Arg(1024);
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "core/data_buffer.h"
+#include "networking/channel/channel_type.h"
+#include "networking/packet.h"
+#include "networking/packet_coalescer.h"
+#include "networking/packet_type.h"
+
+namespace
+{
+
+/**
+ * Coalesce a tick of chatty traffic: small messages spread over all channels,
+ * each with an ack, then split the datagrams back in to packets. The counters
+ * give the number of packets and the number of datagrams they were sent in.
+ *
+ * Argument is number of messages per tick.
+ */
+void packet_coalesce(benchmark::State &state)
+{
+    static constexpr iris::ChannelType channels[] = {
+        iris::ChannelType::UNRELIABLE_UNORDERED,
+        iris::ChannelType::UNRELIABLE_SEQUENCED,
+        iris::ChannelType::RELIABLE_ORDERED};
+
+    std::vector<iris::Packet> packets{};
+    for (auto i = 0u; i < state.range(0); ++i)
+    {
+        packets.emplace_back(iris::PacketType::DATA, channels[i % 3u], iris::DataBuffer(32u, std::byte{0xaa}));
+        packets.emplace_back(iris::PacketType::ACK, iris::ChannelType::RELIABLE_ORDERED, iris::DataBuffer{});
+    }
+
+    iris::PacketCoalescer coalescer{};
+    std::size_t datagrams = 0u;
+
+    for (auto _ : state)
+    {
+        coalescer.add(packets);
+        datagrams = coalescer.size();
+
+        for (auto i = 0u; i < coalescer.size(); ++i)
+        {
+            benchmark::DoNotOptimize(iris::PacketCoalescer::split(coalescer[i]));
+        }
+
+        coalescer.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * packets.size());
+    state.counters["packets"] = static_cast<double>(packets.size());
+    state.counters["datagrams"] = static_cast<double>(datagrams);
+}
+
+}
+
+BENCHMARK(packet_coalesce)->Arg(8)->Arg(64);
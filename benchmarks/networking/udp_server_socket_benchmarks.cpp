@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "core/data_buffer.h"
+#include "networking/datagram.h"
+#include "networking/server_socket_data.h"
+#include "networking/socket.h"
+#include "networking/udp_server_socket.h"
+#include "networking/udp_socket.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+static constexpr auto port = 8899u;
+
+// roughly the size of a small game packet
+static constexpr auto datagram_size = 128u;
+
+/**
+ * Receive a tick's worth of datagrams on a loopback server socket, either one
+ * recvfrom per datagram or as batches. The client sends are not timed.
+ *
+ * Argument is number of datagrams per tick, this is kept small enough to fit in
+ * the default socket receive buffer.
+ */
+template <bool Batched>
+void udp_server_receive(benchmark::State &state)
+{
+    iris::UdpServerSocket server{"127.0.0.1", port};
+    iris::UdpSocket client{"127.0.0.1", port};
+
+    const iris::DataBuffer data(datagram_size, std::byte{0xaa});
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    std::vector<iris::ServerSocketData> batch{};
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        for (auto i = 0u; i < count; ++i)
+        {
+            client.write(data);
+        }
+        state.ResumeTiming();
+
+        auto received = std::size_t{0u};
+        auto read = std::size_t{1u};
+
+        // a timed out read means the kernel dropped some, so give up
+        while ((received < count) && (read != 0u))
+        {
+            if constexpr (Batched)
+            {
+                read = server.read_batch(100ms, batch);
+            }
+            else
+            {
+                read = server.read(100ms) ? 1u : 0u;
+            }
+
+            received += read;
+        }
+
+        if (received != count)
+        {
+            state.SkipWithError("datagrams dropped");
+            break;
+        }
+
+        benchmark::DoNotOptimize(batch);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * datagram_size);
+}
+
+/**
+ * Send a tick's worth of datagrams from a loopback server socket, either one
+ * sendto per datagram or as batches. Draining them on the client is not timed.
+ *
+ * Argument is number of datagrams per tick.
+ */
+template <bool Batched>
+void udp_server_send(benchmark::State &state)
+{
+    iris::UdpServerSocket server{"127.0.0.1", port};
+    iris::UdpSocket client{"127.0.0.1", port};
+
+    // server only knows about a client once it has sent something
+    client.write({std::byte{0x0}});
+    auto *client_socket = server.read().client;
+
+    const iris::DataBuffer data(datagram_size, std::byte{0xaa});
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    const std::vector<iris::Datagram> datagrams(count, {client_socket, data.data(), data.size()});
+
+    for (auto _ : state)
+    {
+        if constexpr (Batched)
+        {
+            server.write_batch(datagrams);
+        }
+        else
+        {
+            for (const auto &datagram : datagrams)
+            {
+                datagram.client->write(datagram.data, datagram.size);
+            }
+        }
+
+        state.PauseTiming();
+        for (auto i = 0u; i < count; ++i)
+        {
+            benchmark::DoNotOptimize(client.read(datagram_size, 100ms));
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * datagram_size);
+}
+
+}
+
+BENCHMARK_TEMPLATE(udp_server_receive, false)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(udp_server_receive, true)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(udp_server_send, false)->Arg(32)->Arg(128);
+BENCHMARK_TEMPLATE(udp_server_send, true)->Arg(32)->Arg(128);
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+namespace iris
+{
+
+/**
+ * Description of a single logical cpu (hardware thread).
+ */
+struct LogicalCpu
+{
+    /** Id of cpu, as used by Thread::bind_to_core. */
+    std::size_t id;
+
+    /** Id of physical core, unique across packages. */
+    std::size_t core;
+
+    /** Id of physical package (socket). */
+    std::size_t package;
+
+    /** Id of NUMA node. */
+    std::size_t node;
+
+    /** True if this is the first hardware thread on its core. */
+    bool primary;
+};
+
+/**
+ * Layout of the logical cpus on the current machine.
+ */
+class CpuTopology
+{
+  public:
+    /**
+     * Construct a new CpuTopology.
+     *
+     * @param cpus
+     *   Logical cpus, primary flags will be set from the core ids.
+     */
+    explicit CpuTopology(std::vector<LogicalCpu> cpus);
+
+    /**
+     * Detect the topology of the current machine. Uses sysfs where available,
+     * otherwise assumes one core per hardware thread on a single node. On
+     * linux only the cpus the process is allowed to run on are included.
+     *
+     * @returns
+     *   Detected topology.
+     */
+    static CpuTopology detect();
+
+    /**
+     * Read a topology from a sysfs tree, this is normally /sys/devices/system
+     * but can be anywhere for testing.
+     *
+     * Online cpus are read from cpu/cpuN/topology/{core_id,physical_package_id}
+     * and nodes from node/nodeN/cpulist. If there are no nodes then everything
+     * is on node zero.
+     *
+     * @param root
+     *   Root of sysfs tree.
+     *
+     * @returns
+     *   Topology read from tree.
+     */
+    static CpuTopology from_sysfs(const std::filesystem::path &root);
+
+    /**
+     * Create a topology of independent cores on a single node.
+     *
+     * @param count
+     *   Number of cores.
+     *
+     * @returns
+     *   Flat topology.
+     */
+    static CpuTopology flat(std::size_t count);
+
+    /**
+     * Get a topology with only the supplied cpus, e.g. those a process is
+     * allowed to run on. Primary flags are recomputed, so if only a secondary
+     * hardware thread of a core is kept it becomes the primary.
+     *
+     * @param ids
+     *   Ids of cpus to keep, unknown ids are ignored.
+     *
+     * @returns
+     *   Restricted topology.
+     */
+    CpuTopology restrict_to(const std::vector<std::size_t> &ids) const;
+
+    /**
+     * Get all logical cpus, ordered by id.
+     *
+     * @returns
+     *   Logical cpus.
+     */
+    const std::vector<LogicalCpu> &cpus() const;
+
+    /**
+     * Get the number of physical cores.
+     *
+     * @returns
+     *   Physical core count.
+     */
+    std::size_t physical_core_count() const;
+
+    /**
+     * Get the number of NUMA nodes.
+     *
+     * @returns
+     *   Node count.
+     */
+    std::size_t node_count() const;
+
+  private:
+    /** Logical cpus. */
+    std::vector<LogicalCpu> cpus_;
+};
+
+}
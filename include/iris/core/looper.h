@@ -16,6 +16,10 @@ namespace iris
  * This class provides a game looper. It takes two functions, one that is called
  * at a fixed time step and another that is run as frequently as possible. This
  * is based on the https://gafferongames.com/post/fix_your_timestep/ article.
+ *
+ * Both functions are called in sequence on the calling thread, see
+ * PipelinedLooper for a version which simulates the next frame whilst the
+ * current one renders.
  */
 class Looper
 {
@@ -0,0 +1,402 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_system.h"
+#include "jobs/job_trace.h"
+
+namespace iris
+{
+
+/**
+ * A game looper which overlaps simulation and rendering. Whilst the calling
+ * (render) thread renders frame N the simulation of frame N + 1 runs as a job,
+ * so on a multi-core machine a frame costs max(simulate, render) rather than
+ * simulate + render.
+ *
+ * Each frame the fixed time step function is called as many times as needed
+ * to consume the elapsed time (as in Looper), then the snapshot function
+ * copies whatever the renderer needs in to a FrameData. The render function
+ * gets that snapshot read-only, so it never touches simulation state that is
+ * being updated.
+ *
+ * Simulation is always sequential, frame N + 1 is only started once frame N
+ * is done. The depth is how many simulated frames can be waiting to render,
+ * each one adds a frame of latency but absorbs more variance in frame times.
+ * Rendering only waits on the simulation when no simulated frame is queued, so
+ * a slow simulation frame is hidden whilst the queued frames are rendered.
+ *
+ * @tparam FrameData
+ *   Render data for a frame, must be default constructible.
+ */
+template <class FrameData>
+class PipelinedLooper
+{
+  public:
+    /**
+     * Definition of a function to run at the fixed time step, this is called
+     * from the job system.
+     *
+     * @param clock
+     *   Total elapsed time since loop started.
+     *
+     * @param delta
+     *   Duration of step.
+     *
+     * @returns
+     *   True if loop should continue, false if it should exit.
+     */
+    using LoopFunction = std::function<bool(std::chrono::microseconds, std::chrono::microseconds)>;
+
+    /**
+     * Definition of a function to capture render data once a frame has been
+     * simulated, this is called from the job system.
+     *
+     * @param frame
+     *   Render data to fill in, this still has the contents of an older frame.
+     */
+    using SnapshotFunction = std::function<void(FrameData &)>;
+
+    /**
+     * Definition of a function to render a simulated frame, this is called on
+     * the thread that called run.
+     *
+     * @param frame
+     *   Render data for frame.
+     *
+     * @param clock
+     *   Simulation time of frame.
+     *
+     * @param delta
+     *   Duration of frame.
+     *
+     * @returns
+     *   True if loop should continue, false if it should exit.
+     */
+    using RenderFunction =
+        std::function<bool(const FrameData &, std::chrono::microseconds, std::chrono::microseconds)>;
+
+    /**
+     * Construct a new PipelinedLooper.
+     *
+     * @param clock
+     *   Start time of looping.
+     *
+     * @param timestep
+     *   How frequently to call the fixed time step function.
+     *
+     * @param depth
+     *   Number of simulated frames that can be waiting to render (1-3).
+     *
+     * @param job_system
+     *   Job system to simulate on.
+     *
+     * @param fixed_timestep
+     *   Function to call at the supplied fixed timestep.
+     *
+     * @param snapshot
+     *   Function to capture render data for a simulated frame.
+     *
+     * @param render
+     *   Function to render a frame.
+     */
+    PipelinedLooper(
+        std::chrono::microseconds clock,
+        std::chrono::microseconds timestep,
+        std::size_t depth,
+        JobSystem &job_system,
+        LoopFunction fixed_timestep,
+        SnapshotFunction snapshot,
+        RenderFunction render)
+        : clock_(clock)
+        , timestep_(timestep)
+        , depth_(depth)
+        , job_system_(job_system)
+        , fixed_timestep_(std::move(fixed_timestep))
+        , snapshot_(std::move(snapshot))
+        , render_(std::move(render))
+        , frames_(depth + 1u)
+        , mutex_()
+        , condition_()
+    {
+        expect((depth >= 1u) && (depth <= 3u), "pipeline depth must be 1-3");
+    }
+
+    // disable copy and move, jobs refer to the looper
+    PipelinedLooper(const PipelinedLooper &) = delete;
+    PipelinedLooper &operator=(const PipelinedLooper &) = delete;
+    PipelinedLooper(PipelinedLooper &&) = delete;
+    PipelinedLooper &operator=(PipelinedLooper &&) = delete;
+
+    /**
+     * Run the loop. Will continue until one of the supplied functions returns
+     * false, or throws in which case the exception is rethrown here. Clock
+     * time will start incrementing from this call.
+     *
+     * Frames still in the pipeline when the loop stops are not rendered.
+     */
+    void run()
+    {
+        auto run = true;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration accumulator(0);
+
+        // wall time since the last frame started simulating
+        std::chrono::steady_clock::duration unsimulated(0);
+
+        // next frame to simulate and next frame to render
+        std::size_t simulated = 0u;
+        std::size_t rendered = 0u;
+
+        std::exception_ptr exception{};
+
+        try
+        {
+            do
+            {
+                IRIS_TRACE_FRAME();
+
+                const auto end = std::chrono::steady_clock::now();
+                const auto frame_time = end - start;
+                start = end;
+
+                accumulator += frame_time;
+                unsimulated += frame_time;
+
+                // whilst the pipeline is filling, or when the only frame left
+                // to render is still simulating, there is nothing to do until
+                // the running simulation finishes
+                if ((simulated != 0u) && ((simulated <= depth_) || (rendered + 1u == simulated)))
+                {
+                    run &= wait_for(simulated - 1u);
+                }
+
+                // simulation is sequential, so the next frame can only start
+                // once the previous one has finished, we don't wait for it
+                // here as there are finished frames to render
+                if (run && ((simulated - rendered) < frames_.size()) &&
+                    ((simulated == 0u) || is_ready(simulated - 1u)))
+                {
+                    if (simulated != 0u)
+                    {
+                        run &= wait_for(simulated - 1u);
+                    }
+
+                    if (run)
+                    {
+                        // work out the steps here, so frame timing only
+                        // depends on the render thread
+                        auto &frame = frames_[simulated % frames_.size()];
+                        frame.clock = clock_;
+                        frame.delta = std::chrono::duration_cast<std::chrono::microseconds>(unsimulated);
+                        frame.steps = accumulator / timestep_;
+                        frame.ready = false;
+
+                        accumulator -= timestep_ * frame.steps;
+                        clock_ += timestep_ * frame.steps;
+                        unsimulated = {};
+
+                        simulate(frame);
+                        ++simulated;
+                    }
+                }
+
+                // once the pipeline has filled render the oldest frame, this
+                // has always finished simulating by now
+                if (run && (simulated > depth_) && (rendered != simulated))
+                {
+                    run &= wait_for(rendered);
+
+                    if (run)
+                    {
+                        const auto &oldest = frames_[rendered % frames_.size()];
+                        run &= render_(oldest.data, oldest.clock + timestep_ * oldest.steps, oldest.delta);
+                        ++rendered;
+                    }
+                }
+            } while (run);
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        // jobs refer to us, so we can't leave until the last one is done
+        if (simulated != 0u)
+        {
+            try
+            {
+                wait_for(simulated - 1u);
+            }
+            catch (...)
+            {
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+  private:
+    /**
+     * A frame in the pipeline.
+     */
+    struct Frame
+    {
+        /** Render data. */
+        FrameData data = {};
+
+        /** Simulation time at the start of the frame. */
+        std::chrono::microseconds clock = {};
+
+        /** Duration of frame. */
+        std::chrono::microseconds delta = {};
+
+        /** Number of fixed steps to simulate. */
+        std::int64_t steps = 0;
+
+        /** Whether the simulation job has finished, guarded by mutex. */
+        bool ready = true;
+
+        /** Whether the simulation asked to continue. */
+        bool run = true;
+
+        /** Any exception thrown by the simulation. */
+        std::exception_ptr exception = nullptr;
+    };
+
+    /**
+     * Start simulating a frame on the job system.
+     *
+     * @param frame
+     *   Frame to simulate.
+     */
+    void simulate(Frame &frame)
+    {
+        std::vector<InplaceJob> jobs{};
+        jobs.emplace_back(
+            [this, &frame]
+            {
+                auto run = true;
+                std::exception_ptr exception{};
+
+                try
+                {
+                    for (auto i = std::int64_t{0}; run && (i < frame.steps); ++i)
+                    {
+                        run &= fixed_timestep_(frame.clock + timestep_ * i, timestep_);
+                    }
+
+                    snapshot_(frame.data);
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+
+                // notify whilst holding the lock, as once it is released the
+                // looper may be destroyed
+                std::unique_lock lock(mutex_);
+                frame.run = run;
+                frame.exception = exception;
+                frame.ready = true;
+                condition_.notify_all();
+            });
+
+        job_system_.add_jobs(std::move(jobs));
+    }
+
+    /**
+     * Check if a frame has finished simulating, without waiting.
+     *
+     * @param index
+     *   Index of frame.
+     *
+     * @returns
+     *   True if the frame is ready.
+     */
+    bool is_ready(std::size_t index)
+    {
+        std::unique_lock lock(mutex_);
+        return frames_[index % frames_.size()].ready;
+    }
+
+    /**
+     * Wait for a frame to finish simulating.
+     *
+     * @param index
+     *   Index of frame.
+     *
+     * @returns
+     *   True if the simulation asked to continue.
+     */
+    bool wait_for(std::size_t index)
+    {
+        auto &frame = frames_[index % frames_.size()];
+
+        std::unique_lock lock(mutex_);
+        condition_.wait(lock, [&frame] { return frame.ready; });
+
+        if (frame.exception)
+        {
+            std::rethrow_exception(std::exchange(frame.exception, nullptr));
+        }
+
+        return frame.run;
+    }
+
+    /** Elapsed time of loop. */
+    std::chrono::microseconds clock_;
+
+    /** Fixed time step. */
+    std::chrono::microseconds timestep_;
+
+    /** Number of simulated frames that can wait to render. */
+    std::size_t depth_;
+
+    /** Job system to simulate on. */
+    JobSystem &job_system_;
+
+    /** Function to run at fixed time step. */
+    LoopFunction fixed_timestep_;
+
+    /** Function to capture render data. */
+    SnapshotFunction snapshot_;
+
+    /** Function to render a frame. */
+    RenderFunction render_;
+
+    /** Ring of frames, one more than the depth so we can simulate whilst depth frames wait. */
+    std::vector<Frame> frames_;
+
+    /** Guards frame state shared with jobs. */
+    std::mutex mutex_;
+
+    /** Signalled when a frame finishes simulating. */
+    std::condition_variable condition_;
+};
+
+}
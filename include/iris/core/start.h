@@ -42,4 +42,21 @@ void start(int argc, char **argv, std::function<void(int, char **)> entry);
  */
 void start_debug(int argc, char **argv, std::function<void(int, char **)> entry);
 
+/**
+ * Start the engine without any graphics e.g. for a dedicated server. Only the
+ * jobs and physics apis are initialised, the graphics api is set to "null"
+ * which provides a window, mesh and texture manager that do nothing. This
+ * allows code shared with a client to still run without paying for rendering.
+ *
+ * @param argc
+ *   argc from main()
+ *
+ * @param argv
+ *   argv from main()
+ *
+ * @param entry
+ *   Entry point into game, will be passed argc and argv back.
+ */
+void start_headless(int argc, char **argv, std::function<void(int, char **)> entry);
+
 }
@@ -69,7 +69,9 @@ class Thread
      * suggestion to the kernel, rather than be honored.
      *
      * @param core
-     *   Id of core to bind to in the range [0, number of cores)
+     *   Id of logical cpu to bind to, as reported by CpuTopology. Ids need not
+     *   be contiguous, on some platforms an id the process cannot run on will
+     *   throw.
      */
     void bind_to_core(std::size_t core);
 
@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "graphics/mesh.h"
+#include "graphics/vertex_data.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of Mesh for headless mode. No vertex or index data is kept.
+ */
+class NullMesh : public Mesh
+{
+  public:
+    ~NullMesh() override = default;
+
+    /**
+     * Update the vertex data, this is a no-op.
+     *
+     * @param data
+     *   New vertex data.
+     */
+    void update_vertex_data(const std::vector<VertexData> &data) override;
+
+    /**
+     * Update the index data, this is a no-op.
+     *
+     * @param data
+     *   New index data.
+     */
+    void update_index_data(const std::vector<std::uint32_t> &data) override;
+};
+
+}
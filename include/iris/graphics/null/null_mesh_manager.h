@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graphics/mesh.h"
+#include "graphics/mesh_manager.h"
+#include "graphics/vertex_data.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of MeshManager for headless mode.
+ */
+class NullMeshManager : public MeshManager
+{
+  public:
+    ~NullMeshManager() override = default;
+
+  protected:
+    /**
+     * Create a Mesh object, the supplied data is discarded.
+     *
+     * @param vertices
+     *   Collection of vertices for the Mesh.
+     *
+     * @param indices
+     *   Collection of indices for the Mesh.
+     *
+     * @returns
+     *   Loaded Mesh.
+     */
+    std::unique_ptr<Mesh> create_mesh(
+        const std::vector<iris::VertexData> &vertices,
+        const std::vector<std::uint32_t> &indices) const override;
+};
+
+}
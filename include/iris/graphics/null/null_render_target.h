@@ -0,0 +1,36 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+#include "graphics/render_target.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of RenderTarget for headless mode.
+ */
+class NullRenderTarget : public RenderTarget
+{
+  public:
+    /**
+     * Construct a new NullRenderTarget.
+     *
+     * @param width
+     *   Width of target.
+     *
+     * @param height
+     *   Height of target.
+     */
+    NullRenderTarget(std::uint32_t width, std::uint32_t height);
+
+    ~NullRenderTarget() override = default;
+};
+
+}
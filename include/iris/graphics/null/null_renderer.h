@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graphics/null/null_render_target.h"
+#include "graphics/render_pass.h"
+#include "graphics/render_target.h"
+#include "graphics/renderer.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of Renderer for headless mode. Render passes are ignored, so
+ * no render queue is built and rendering does nothing.
+ */
+class NullRenderer : public Renderer
+{
+  public:
+    ~NullRenderer() override = default;
+
+    /**
+     * Set the render passes, these are ignored.
+     *
+     * @param render_passes
+     *   Collection of RenderPass objects to render.
+     */
+    void set_render_passes(const std::vector<RenderPass> &render_passes) override;
+
+    /**
+     * Create a RenderTarget with custom dimensions.
+     *
+     * @param width
+     *   Width of render target.
+     *
+     * @param height
+     *   Height of render target.
+     *
+     * @returns
+     *   RenderTarget.
+     */
+    RenderTarget *create_render_target(std::uint32_t width, std::uint32_t height) override;
+
+  private:
+    /** Collection of created RenderTarget objects. */
+    std::vector<std::unique_ptr<NullRenderTarget>> render_targets_;
+};
+
+}
@@ -0,0 +1,41 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+#include "graphics/texture.h"
+#include "graphics/texture_usage.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of Texture for headless mode. Only the dimensions are kept,
+ * the pixel data is discarded.
+ */
+class NullTexture : public Texture
+{
+  public:
+    /**
+     * Construct a new NullTexture.
+     *
+     * @param width
+     *   Width of image.
+     *
+     * @param height
+     *   Height of image.
+     *
+     * @param usage
+     *   Usage of the texture.
+     */
+    NullTexture(std::uint32_t width, std::uint32_t height, TextureUsage usage);
+
+    ~NullTexture() override = default;
+};
+
+}
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "core/data_buffer.h"
+#include "graphics/texture.h"
+#include "graphics/texture_manager.h"
+#include "graphics/texture_usage.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of TextureManager for headless mode.
+ */
+class NullTextureManager : public TextureManager
+{
+  public:
+    ~NullTextureManager() override = default;
+
+  protected:
+    /**
+     * Create a Texture object, only the dimensions of the data are kept.
+     *
+     * @param data
+     *   Raw data of image, this is discarded.
+     *
+     * @param width
+     *   Width of image.
+     *
+     * @param height
+     *   Height of image.
+     *
+     * @param usage
+     *   Usage of the texture.
+     */
+    std::unique_ptr<Texture> do_create(
+        const DataBuffer &data,
+        std::uint32_t width,
+        std::uint32_t height,
+        TextureUsage usage) override;
+};
+
+}
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "events/event.h"
+#include "graphics/window.h"
+
+namespace iris
+{
+
+/**
+ * Implementation of Window for headless mode. Nothing is displayed and there
+ * are never any events.
+ */
+class NullWindow : public Window
+{
+  public:
+    /**
+     * Construct a new NullWindow.
+     *
+     * @param width
+     *   Width of window.
+     *
+     * @param height
+     *   Height of window.
+     */
+    NullWindow(std::uint32_t width, std::uint32_t height);
+    ~NullWindow() override = default;
+
+    /**
+     * Get the natural scale for the screen, this is always 1.
+     *
+     * @returns
+     *   Screen scale factor.
+     */
+    std::uint32_t screen_scale() const override;
+
+    /**
+     * Pump the next user input event, there are never any.
+     *
+     * @returns
+     *   Empty optional.
+     */
+    std::optional<Event> pump_event() override;
+
+    /**
+     * Render the current scene, this is a no-op.
+     */
+    void render() const override;
+};
+
+}
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_system.h"
+
+namespace iris
+{
+
+/**
+ * A one-shot value that a single coroutine can await and any thread can
+ * complete. This is intended for bridging callbacks from outside the job
+ * system, such as I/O finishing on a ServiceThread, in to tasks.
+ *
+ * If constructed with a JobSystem the waiting coroutine is resumed as a job,
+ * otherwise it is resumed inline by whoever calls complete.
+ */
+template <class T = void>
+class Completion
+{
+  public:
+    /**
+     * Awaiter for completion.
+     */
+    struct Awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return completion.is_complete();
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            // if this fails then we have been completed in the meantime, so
+            // carry on without suspending
+            void *expected = nullptr;
+            return completion.state_.compare_exchange_strong(
+                expected, handle.address(), std::memory_order_acq_rel, std::memory_order_acquire);
+        }
+
+        T await_resume()
+        {
+            if constexpr (!std::is_void_v<T>)
+            {
+                return std::move(*completion.value_);
+            }
+        }
+
+        /** Completion being awaited. */
+        Completion &completion;
+    };
+
+    /**
+     * Construct a Completion that resumes its waiter inline.
+     */
+    Completion()
+        : state_(nullptr)
+        , value_()
+        , job_system_(nullptr)
+        , priority_(JobPriority::NORMAL)
+    {
+    }
+
+    /**
+     * Construct a Completion that resumes its waiter on a job system.
+     *
+     * @param job_system
+     *   Job system to resume on.
+     *
+     * @param priority
+     *   Priority to resume at.
+     */
+    explicit Completion(JobSystem &job_system, JobPriority priority = JobPriority::NORMAL)
+        : state_(nullptr)
+        , value_()
+        , job_system_(&job_system)
+        , priority_(priority)
+    {
+    }
+
+    Completion(const Completion &) = delete;
+    Completion &operator=(const Completion &) = delete;
+    Completion(Completion &&) = delete;
+    Completion &operator=(Completion &&) = delete;
+
+    /**
+     * Complete with a value, resuming any waiter. Must only be called once.
+     *
+     * @param args
+     *   Arguments to construct value with (none for void).
+     */
+    template <class... Args>
+    void complete(Args &&...args)
+    {
+        if constexpr (!std::is_void_v<T>)
+        {
+            value_.emplace(std::forward<Args>(args)...);
+        }
+
+        auto *waiter = state_.exchange(completed(), std::memory_order_acq_rel);
+        expect(waiter != completed(), "already complete");
+
+        if (waiter != nullptr)
+        {
+            const auto handle = std::coroutine_handle<>::from_address(waiter);
+
+            if (job_system_ != nullptr)
+            {
+                std::vector<InplaceJob> jobs{};
+                jobs.emplace_back([handle] { handle.resume(); });
+                job_system_->add_jobs(std::move(jobs), priority_);
+            }
+            else
+            {
+                handle.resume();
+            }
+        }
+    }
+
+    /**
+     * Check if complete has been called.
+     *
+     * @returns
+     *   True if complete, otherwise false.
+     */
+    bool is_complete() const
+    {
+        return state_.load(std::memory_order_acquire) == completed();
+    }
+
+    Awaiter operator co_await() noexcept
+    {
+        return {*this};
+    }
+
+  private:
+    /**
+     * Sentinel value for state, it is never dereferenced.
+     *
+     * @returns
+     *   Sentinel pointer.
+     */
+    static void *completed()
+    {
+        return reinterpret_cast<void *>(std::uintptr_t{1u});
+    }
+
+    /** Either nullptr, the waiting coroutine address or completed(). */
+    std::atomic<void *> state_;
+
+    /** Completed value. */
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> value_;
+
+    /** Job system to resume on, nullptr to resume inline. */
+    JobSystem *job_system_;
+
+    /** Priority to resume at. */
+    JobPriority priority_;
+};
+
+}
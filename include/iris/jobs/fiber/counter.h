@@ -7,13 +7,18 @@
 #pragma once
 
 #include <atomic>
-#include <mutex>
 
 namespace iris
 {
 
+class Fiber;
+
 /**
- * A thread-safe counter. Can be decremented and checked.
+ * A thread-safe counter. Can be decremented and checked. Fibers can park
+ * themselves on a counter, they are handed back (exactly once) to whoever
+ * decrements it to zero.
+ *
+ * Waiting fibers are kept in an intrusive list, so parking does not allocate.
  */
 class Counter
 {
@@ -38,24 +43,60 @@ class Counter
      * @returns
      *   Value of counter.
      */
-    operator int();
+    operator int() const;
 
     /**
-     * Prefix decrement counter.
+     * Prefix decrement counter. Must not be used if fibers could be waiting on
+     * the counter, as they would never be released.
      */
     void operator--();
 
     /**
-     * Postfix decrement counter.
+     * Postfix decrement counter. Must not be used if fibers could be waiting on
+     * the counter, as they would never be released.
      */
     void operator--(int);
 
+    /**
+     * Decrement counter. If this takes the counter to zero then all waiting
+     * fibers are released to the caller, who is responsible for making them
+     * runnable.
+     *
+     * @returns
+     *   Head of list of released fibers (linked via Fiber::next_waiter), or
+     *   nullptr if counter is not zero or nothing was waiting.
+     */
+    Fiber *decrement();
+
+    /**
+     * Park a fiber on the counter. The caller should suspend the fiber after
+     * this returns true.
+     *
+     * @param fiber
+     *   Fiber to park.
+     *
+     * @returns
+     *   True if fiber was parked, false if the counter has already been
+     *   released (in which case there is nothing to wait for).
+     */
+    bool add_waiter(Fiber *fiber);
+
+    /**
+     * Check if the counter has reached zero and released its waiters. Once
+     * this is true whoever decremented the counter is done with it, so it is
+     * safe to destroy.
+     *
+     * @returns
+     *   True if counter has been released, otherwise false.
+     */
+    bool is_released() const;
+
   private:
     /** Value of counter. */
-    int value_;
+    std::atomic<int> value_;
 
-    /** Lock for object. */
-    std::mutex mutex_;
+    /** Head of intrusive list of waiting fibers. */
+    std::atomic<Fiber *> waiters_;
 };
 
 }
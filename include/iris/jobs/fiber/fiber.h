@@ -8,11 +8,13 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include "core/static_buffer.h"
 #include "jobs/fiber/counter.h"
-#include "jobs/job.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
 
 namespace iris
 {
@@ -33,7 +35,7 @@ class Fiber
      * @param job
      *   Job to run.
      */
-    explicit Fiber(Job job);
+    explicit Fiber(InplaceJob job);
 
     /**
      * Construct a Fiber with a job and a counter.
@@ -44,7 +46,21 @@ class Fiber
      * @param counter
      *   Counter to decrement when job is done.
      */
-    Fiber(Job job, Counter *counter);
+    Fiber(InplaceJob job, Counter *counter);
+
+    /**
+     * Construct a Fiber with a job, a counter and a specific stack size.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param counter
+     *   Counter to decrement when job is done.
+     *
+     * @param stack_pages
+     *   Number of usable pages for the stack, must be at least two.
+     */
+    Fiber(InplaceJob job, Counter *counter, std::size_t stack_pages);
 
     ~Fiber();
 
@@ -53,10 +69,25 @@ class Fiber
     Fiber(Fiber &&other) = delete;
     Fiber &operator=(Fiber &&other) = delete;
 
+    /**
+     * Reset a finished (or never started) fiber so it can run a new job. The
+     * stack is reused.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param counter
+     *   Counter to decrement when job is done.
+     */
+    void reset(InplaceJob job, Counter *counter);
+
     /**
      * Start the fiber.
+     *
+     * @returns
+     *   True if the job ran to completion, false if the fiber was suspended.
      */
-    void start();
+    bool start();
 
     /**
      * Suspends a Fibers execution, execution will continue from where
@@ -69,8 +100,20 @@ class Fiber
      * was called.
      *
      * It is undefined behavior to resume a non-suspended Fiber.
+     *
+     * @returns
+     *   True if the job ran to completion, false if the fiber was suspended
+     *   again.
+     */
+    bool resume();
+
+    /**
+     * Check if the fiber has been started.
+     *
+     * @returns
+     *   True if start has been called, otherwise false.
      */
-    void resume();
+    bool is_started() const;
 
     /**
      * Check if a Fiber is safe to call methods on. It is only not safe when it
@@ -94,6 +137,84 @@ class Fiber
      */
     bool is_being_waited_on() const;
 
+    /**
+     * Get the counter to decrement when this fiber finishes.
+     *
+     * @returns
+     *   Counter, or nullptr if nothing is waiting on this fiber.
+     */
+    Counter *counter() const;
+
+    /**
+     * Get the next fiber in the list of waiters released by a Counter.
+     *
+     * @returns
+     *   Next waiting fiber, or nullptr if this is the last.
+     */
+    Fiber *next_waiter() const;
+
+    /**
+     * Get the priority the fiber should be scheduled at.
+     *
+     * @returns
+     *   Fiber priority.
+     */
+    JobPriority priority() const;
+
+    /**
+     * Set the priority the fiber should be scheduled at. This is reset to
+     * NORMAL when the fiber is reset.
+     *
+     * @param priority
+     *   New priority.
+     */
+    void set_priority(JobPriority priority);
+
+    /**
+     * Get the id of the job the fiber is running, used to tell jobs apart in
+     * traces as fibers are reused.
+     *
+     * @returns
+     *   Job id.
+     */
+    std::uint64_t id() const;
+
+    /**
+     * Set the id of the job the fiber is running. This is reset to 0 when the
+     * fiber is reset.
+     *
+     * @param id
+     *   New job id.
+     */
+    void set_id(std::uint64_t id);
+
+    /**
+     * Get the number of usable pages in the fibers stack.
+     *
+     * @returns
+     *   Stack size in pages.
+     */
+    std::size_t stack_pages() const;
+
+    /**
+     * Fill the fibers stack with a known pattern, so stack_high_water can
+     * later tell how much of it was used. Must not be called whilst the fiber
+     * is running or suspended.
+     *
+     * Not all platforms give us access to the stack, in which case this does
+     * nothing.
+     */
+    void paint_stack();
+
+    /**
+     * Get how much of the stack has been used since it was last painted.
+     *
+     * @returns
+     *   Deepest stack use in bytes, always zero if the stack was never painted
+     *   or painting is not supported.
+     */
+    std::size_t stack_high_water() const;
+
     /**
      * Get any exception thrown during the execution of this fiber.
      *
@@ -119,8 +240,14 @@ class Fiber
     static Fiber **this_fiber();
 
   private:
+    // counter manages the intrusive waiter list
+    friend class Counter;
+
+    // pool tracks which cache a fiber was acquired through
+    friend class FiberPool;
+
     /** Job to run in Fiber. */
-    Job job_;
+    InplaceJob job_;
 
     /** optional counter. */
     Counter *counter_;
@@ -134,6 +261,24 @@ class Fiber
     /** Flag if fiber is not safe to operator on. */
     std::atomic<bool> safe_;
 
+    /** Flag if fiber has been started. */
+    bool started_;
+
+    /** Next fiber in intrusive list of fibers waiting on a Counter. */
+    Fiber *next_waiter_;
+
+    /** Priority fiber is scheduled at. */
+    JobPriority priority_;
+
+    /** Id of job fiber is running. */
+    std::uint64_t id_;
+
+    /** Index of FiberPool cache fiber was acquired through. */
+    std::size_t pool_cache_;
+
+    /** Number of usable pages in stack. */
+    std::size_t stack_pages_;
+
     /** Pointer to implementation. */
     struct implementation;
     std::unique_ptr<implementation> impl_;
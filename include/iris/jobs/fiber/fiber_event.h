@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+
+#include "jobs/fiber/fiber_wait_queue.h"
+
+namespace iris
+{
+
+/**
+ * A manual reset event. Waiting fibers are suspended, rather than blocking
+ * their worker thread, until the event is set. Non-fiber threads block as
+ * normal.
+ */
+class FiberEvent
+{
+  public:
+    /**
+     * Construct an unset FiberEvent.
+     */
+    FiberEvent();
+
+    // disable copy and move
+    FiberEvent(const FiberEvent &) = delete;
+    FiberEvent &operator=(const FiberEvent &) = delete;
+    FiberEvent(FiberEvent &&) = delete;
+    FiberEvent &operator=(FiberEvent &&) = delete;
+
+    /**
+     * Set the event, waking all waiters. The event stays set until reset.
+     */
+    void set();
+
+    /**
+     * Reset the event.
+     */
+    void reset();
+
+    /**
+     * Wait for the event to be set, returns immediately if already set.
+     */
+    void wait();
+
+    /**
+     * Check if event is set.
+     *
+     * @returns
+     *   True if event is set, otherwise false.
+     */
+    bool is_set();
+
+  private:
+    /** Guards state. */
+    std::mutex guard_;
+
+    /** Flag indicating if event is set. */
+    bool set_;
+
+    /** Queue of waiters. */
+    FiberWaitQueue waiters_;
+};
+
+}
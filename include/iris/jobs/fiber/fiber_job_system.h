@@ -6,28 +6,162 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
-#include "core/semaphore.h"
 #include "core/thread.h"
 #include "jobs/concurrent_queue.h"
 #include "jobs/fiber/counter.h"
 #include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_pool.h"
+#include "jobs/idle_strategy.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 #include "jobs/job_system.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/work_stealing_deque.h"
+#include "jobs/worker_placement.h"
 
 namespace iris
 {
 
+/**
+ * Settings for a FiberJobSystem.
+ */
+struct FiberJobSystemConfig
+{
+    /**
+     * Number of worker threads, zero means one per hardware thread (less one
+     * for the calling thread) or, if pinning workers, one per placement slot.
+     * When pinning with no reserved cpus a core is also kept free for the
+     * calling thread.
+     */
+    std::size_t worker_count = 0u;
+
+    /** Number of usable pages for each fibers stack. */
+    std::size_t stack_pages = 10u;
+
+    /**
+     * Number of usable pages for the stacks of jobs at each priority (indexed
+     * by JobPriority), zero means use stack_pages.
+     */
+    std::array<std::size_t, job_priority_count> priority_stack_pages = {};
+
+    /** Maximum number of idle fibers kept for reuse, per stack size. */
+    std::size_t max_pooled_fibers = 1024u;
+
+    /**
+     * Paint fiber stacks so the deepest stack use of each priority is
+     * reported in FiberPoolStats, at the cost of clearing each stack after
+     * use.
+     */
+    bool paint_stacks = false;
+
+    /** How to place workers on cpus. */
+    WorkerPlacement placement = {};
+
+    /** How idle workers wait for more work. */
+    IdleStrategy idle = {};
+};
+
+/**
+ * Snapshot of counters from a FiberJobSystem.
+ */
+struct FiberJobSystemStats
+{
+    /** Number of fibers taken off a queue by a worker. */
+    std::uint64_t dequeues;
+
+    /** Number of fibers started. */
+    std::uint64_t starts;
+
+    /** Number of suspended fibers resumed. */
+    std::uint64_t resumes;
+
+    /** Number of times a worker ran out of work and parked. */
+    std::uint64_t parks;
+
+    /**
+     * Number of calls made to wake parked workers, each one is potentially a
+     * syscall. Divide by starts to get the cost per job.
+     */
+    std::uint64_t wake_calls;
+
+    /**
+     * Number of times a parked worker was woken by a wake call issued after it
+     * started parking.
+     */
+    std::uint64_t wakeups;
+
+    /**
+     * Total nanoseconds between waking workers and them running, divide by
+     * wakeups to get the mean latency.
+     */
+    std::uint64_t wake_latency_ns;
+
+    /** Fiber pool counters. */
+    FiberPoolStats pool;
+};
+
 /**
  * Implementation of JobSystem that schedules its jobs using fibers.
+ *
+ * Each worker thread owns a work stealing deque. Fibers created on a worker
+ * are pushed to its own deque, idle workers steal from a random victim,
+ * preferring workers on their own NUMA node. Fibers created on non-worker
+ * threads go via a shared lock-free bounded queue, which spills in to a locked
+ * queue if it ever fills up.
+ *
+ * Workers can optionally be pinned to cpus, see WorkerPlacement.
+ *
+ * A fiber waiting on jobs is parked on their counter and only becomes runnable
+ * again once they have all finished, so workers never see a fiber they cannot
+ * run.
+ *
+ * Finished fibers are returned to a pool so their stacks can be reused.
+ *
+ * Idle workers spin, then yield, then park (see IdleStrategy). Adding fibers
+ * only wakes parked workers, and no more of them than there are new fibers,
+ * so adding work whilst workers are busy or spinning costs no syscalls.
+ *
+ * There is a set of queues for each JobPriority. Workers prefer more urgent
+ * fibers but regularly check less urgent queues first, see priority_order. A
+ * fiber keeps its priority whilst waiting on other jobs.
+ *
+ * Fibers should synchronise with FiberMutex, FiberEvent and FiberSemaphore
+ * rather than std primitives, so waiting does not block the worker thread.
  */
 class FiberJobSystem : public JobSystem
 {
   public:
+    /**
+     * Construct a new FiberJobSystem with one worker per hardware thread (less
+     * one for the calling thread).
+     */
     FiberJobSystem();
+
+    /**
+     * Construct a new FiberJobSystem.
+     *
+     * @param worker_count
+     *   Number of worker threads to create, zero means one per hardware
+     *   thread (less one for the calling thread).
+     */
+    explicit FiberJobSystem(std::size_t worker_count);
+
+    /**
+     * Construct a new FiberJobSystem.
+     *
+     * @param config
+     *   Settings for job system.
+     */
+    explicit FiberJobSystem(const FiberJobSystemConfig &config);
+
     ~FiberJobSystem() override;
 
     /**
@@ -37,8 +171,24 @@ class FiberJobSystem : public JobSystem
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    void add_jobs(const std::vector<Job> &jobs) override;
+    void add_jobs(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added these are executed in a fire-and-forget
+     * manner.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    void add_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) override;
 
     /**
      * Add a collection of jobs. Once added this call blocks until all
@@ -46,21 +196,175 @@ class FiberJobSystem : public JobSystem
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    void wait_for_jobs(const std::vector<Job> &jobs) override;
+    void wait_for_jobs(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added this call blocks until all jobs have
+     * finished executing.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    void wait_for_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Get a snapshot of the internal counters.
+     *
+     * @returns
+     *   Current counter values.
+     */
+    FiberJobSystemStats stats() const;
+
+    /**
+     * Get the job system the calling thread is a worker for.
+     *
+     * @returns
+     *   Job system if called from one of its workers, otherwise nullptr.
+     */
+    static FiberJobSystem *current();
 
   private:
+    // wait queue reschedules the fibers it suspends
+    friend class FiberWaitQueue;
+
+    /**
+     * Main function for worker threads. Responsible for taking fibers off the
+     * queues, executing them and performing all necessary bookkeeping.
+     *
+     * @param index
+     *   Index of worker.
+     */
+    void job_thread(std::size_t index);
+
+    /**
+     * Make a fiber available to run at its priority and wake a worker for it.
+     *
+     * @param fiber
+     *   Fiber to schedule.
+     */
+    void schedule(Fiber *fiber);
+
+    /**
+     * Make a fiber available to run at its priority, without waking any
+     * workers. If called from one of our workers it will be pushed to that
+     * workers deque, otherwise on to the shared queue.
+     *
+     * @param fiber
+     *   Fiber to enqueue.
+     */
+    void enqueue(Fiber *fiber);
+
+    /**
+     * Signal that new fibers have been enqueued, waking at most count parked
+     * workers.
+     *
+     * @param count
+     *   Number of fibers enqueued.
+     */
+    void wake_workers(std::size_t count);
+
+    /**
+     * Park the calling worker until fibers are enqueued.
+     *
+     * @param epoch
+     *   Value of work epoch read before the worker last looked for fibers, if
+     *   it has since changed then this returns immediately.
+     */
+    void park(std::uint32_t epoch);
+
+    /**
+     * Tell all workers to exit and join them.
+     */
+    void stop_workers();
+
+    /**
+     * Get the fiber pool cache for the calling thread.
+     *
+     * @returns
+     *   Index of workers own cache if called from one of our workers,
+     *   otherwise the shared cache.
+     */
+    std::size_t pool_cache() const;
+
+    /**
+     * Suspend the calling fiber until a collection of scheduled fibers have
+     * finished, then return them to the pool.
+     *
+     * @param counter
+     *   Counter the fibers will decrement.
+     *
+     * @param fibers
+     *   Fibers to wait on.
+     */
+    void wait_for_fibers(Counter &counter, const std::vector<Fiber *> &fibers);
+
+    /** Where to run workers, empty if they are not pinned. */
+    std::vector<WorkerSlot> slots_;
+
+    /** Pool of fibers for running jobs. */
+    FiberPool pool_;
+
     /** Flag indicating of system is running. */
     std::atomic<bool> running_;
 
-    /** Semaphore signally how many fibers are available. */
-    Semaphore jobs_semaphore_;
+    /** How idle workers wait for more work. */
+    IdleStrategy idle_;
+
+    /** Incremented whenever fibers are enqueued, parked workers wait on this. */
+    std::atomic<std::uint32_t> work_epoch_;
+
+    /** Number of workers parked, or about to park. */
+    std::atomic<std::uint32_t> sleepers_;
+
+    /** Time of the last wake, in steady clock nanoseconds. */
+    std::atomic<std::int64_t> last_wake_;
 
     /** Worker threads which execute fibers. */
     std::vector<Thread> workers_;
 
-    /** Queue of fibers.*/
-    ConcurrentQueue<std::tuple<Fiber *, Counter *>> fibers_;
+    /** NUMA node of each worker. */
+    std::vector<std::size_t> worker_nodes_;
+
+    /** Per worker deques of fibers, indexed by priority then worker. */
+    std::array<std::vector<std::unique_ptr<WorkStealingDeque<Fiber *>>>, job_priority_count> queues_;
+
+    /** Shared queues of fibers added from non-worker threads, indexed by priority. */
+    std::array<MpmcQueue<Fiber *>, job_priority_count> fibers_;
+
+    /** Fibers that did not fit in the shared queues, indexed by priority. */
+    std::array<ConcurrentQueue<Fiber *>, job_priority_count> overflow_;
+
+    /** Number of fibers taken off a queue. */
+    std::atomic<std::uint64_t> dequeues_;
+
+    /** Number of fibers started. */
+    std::atomic<std::uint64_t> starts_;
+
+    /** Number of fibers resumed. */
+    std::atomic<std::uint64_t> resumes_;
+
+    /** Number of times a worker parked. */
+    std::atomic<std::uint64_t> parks_;
+
+    /** Number of calls made to wake workers. */
+    std::atomic<std::uint64_t> wake_calls_;
+
+    /** Number of times a parked worker woke. */
+    std::atomic<std::uint64_t> wakeups_;
+
+    /** Total wake latency in nanoseconds. */
+    std::atomic<std::uint64_t> wake_latency_ns_;
+
+    /** Id to give the next job enqueued. */
+    std::atomic<std::uint64_t> next_job_id_;
 };
 
 }
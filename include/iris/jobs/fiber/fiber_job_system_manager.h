@@ -10,7 +10,9 @@
 #include <vector>
 
 #include "jobs/fiber/fiber_job_system.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 #include "jobs/job_system_manager.h"
 
 namespace iris
@@ -39,8 +41,24 @@ class FiberJobSystemManager : public JobSystemManager
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    void add(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added these are executed in a fire-and-forget
+     * manner.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    void add(const std::vector<Job> &jobs) override;
+    void add(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) override;
 
     /**
      * Add a collection of jobs. Once added this call blocks until all
@@ -48,8 +66,24 @@ class FiberJobSystemManager : public JobSystemManager
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    void wait(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added this call blocks until all jobs have
+     * finished executing.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    void wait(const std::vector<Job> &jobs) override;
+    void wait(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) override;
 
   private:
     /** Current JobSystem. */
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+
+#include "jobs/fiber/fiber_wait_queue.h"
+
+namespace iris
+{
+
+/**
+ * A mutex that suspends the calling fiber, rather than blocking its worker
+ * thread, whilst waiting to acquire. Non-fiber threads block as normal.
+ *
+ * Satisfies Lockable, so can be used with std::unique_lock and
+ * std::scoped_lock.
+ */
+class FiberMutex
+{
+  public:
+    /**
+     * Construct an unlocked FiberMutex.
+     */
+    FiberMutex();
+
+    // disable copy and move
+    FiberMutex(const FiberMutex &) = delete;
+    FiberMutex &operator=(const FiberMutex &) = delete;
+    FiberMutex(FiberMutex &&) = delete;
+    FiberMutex &operator=(FiberMutex &&) = delete;
+
+    /**
+     * Acquire the mutex, waiting if it is already held.
+     */
+    void lock();
+
+    /**
+     * Try and acquire the mutex without waiting.
+     *
+     * @returns
+     *   True if mutex was acquired, otherwise false.
+     */
+    bool try_lock();
+
+    /**
+     * Release the mutex, waking the longest waiter.
+     */
+    void unlock();
+
+  private:
+    /** Guards state. */
+    std::mutex guard_;
+
+    /** Flag indicating if mutex is held. */
+    bool locked_;
+
+    /** Queue of waiters. */
+    FiberWaitQueue waiters_;
+};
+
+}
@@ -0,0 +1,236 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "jobs/fiber/counter.h"
+#include "jobs/fiber/fiber.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
+
+namespace iris
+{
+
+/**
+ * Snapshot of counters from a FiberPool.
+ */
+struct FiberPoolStats
+{
+    /** Number of acquires satisfied by a pooled fiber. */
+    std::uint64_t hits;
+
+    /** Number of acquires that had to create a new fiber. */
+    std::uint64_t misses;
+
+    /** Number of fibers currently acquired. */
+    std::uint64_t live;
+
+    /** Highest number of fibers acquired at any one time. */
+    std::uint64_t peak_live;
+
+    /**
+     * Deepest stack use, in bytes, of any finished job at each priority.
+     * Always zero unless stacks are painted.
+     */
+    std::array<std::size_t, job_priority_count> stack_high_water;
+};
+
+/**
+ * Pool of recycled fibers, which allows reusing their (guarded) stacks rather
+ * than allocating new ones for every job.
+ *
+ * Idle fibers are kept in a number of caches, typically one per worker thread
+ * plus a shared one, so threads don't contend with each other. Acquiring
+ * checks the requested cache then the shared one. Releasing to a full cache
+ * destroys the fiber.
+ *
+ * Each priority can have its own stack size, fibers are only reused for jobs
+ * that need the same size. Stacks can optionally be painted, so the pool can
+ * record the high water mark of each priority and stacks can be right-sized.
+ */
+class FiberPool
+{
+  public:
+    /**
+     * Construct a new FiberPool.
+     *
+     * @param cache_count
+     *   Number of caches, in addition to the shared one.
+     *
+     * @param stack_pages
+     *   Number of usable pages for each fibers stack.
+     *
+     * @param max_pooled
+     *   Maximum number of idle fibers kept, split evenly between caches.
+     */
+    FiberPool(std::size_t cache_count, std::size_t stack_pages, std::size_t max_pooled);
+
+    /**
+     * Construct a new FiberPool with per priority stack sizes.
+     *
+     * @param cache_count
+     *   Number of caches, in addition to the shared one.
+     *
+     * @param stack_pages
+     *   Number of usable pages for each fibers stack, indexed by priority.
+     *
+     * @param max_pooled
+     *   Maximum number of idle fibers kept for each stack size, split evenly
+     *   between caches.
+     *
+     * @param paint_stacks
+     *   If true then stacks are painted and their high water mark recorded
+     *   when fibers are released.
+     */
+    FiberPool(
+        std::size_t cache_count,
+        const std::array<std::size_t, job_priority_count> &stack_pages,
+        std::size_t max_pooled,
+        bool paint_stacks);
+
+    /**
+     * Destroy all pooled fibers. Fibers still acquired are not owned by the
+     * pool and are not destroyed.
+     */
+    ~FiberPool();
+
+    // disable copy and move
+    FiberPool(const FiberPool &) = delete;
+    FiberPool &operator=(const FiberPool &) = delete;
+    FiberPool(FiberPool &&) = delete;
+    FiberPool &operator=(FiberPool &&) = delete;
+
+    /**
+     * Get a fiber ready to run a job, reusing a pooled one if possible.
+     *
+     * @param cache
+     *   Index of cache to try first.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param counter
+     *   Counter to decrement when job is done, may be nullptr.
+     *
+     * @param priority
+     *   Priority of job, this sets the stack size and the fibers priority.
+     *
+     * @returns
+     *   Fiber, ownership remains with the pool until released.
+     */
+    Fiber *acquire(
+        std::size_t cache,
+        InplaceJob job,
+        Counter *counter,
+        JobPriority priority = JobPriority::NORMAL);
+
+    /**
+     * Return a finished fiber to the pool. The fiber's job is destroyed
+     * immediately, so any captured state does not outlive the job.
+     *
+     * @param cache
+     *   Index of cache to return fiber to. Fibers acquired through the shared
+     *   cache are always returned to it.
+     *
+     * @param fiber
+     *   Fiber to return.
+     */
+    void release(std::size_t cache, Fiber *fiber);
+
+    /**
+     * Get index of shared cache, this can be used safely from any thread.
+     *
+     * @returns
+     *   Shared cache index.
+     */
+    std::size_t shared_cache() const;
+
+    /**
+     * Get a snapshot of the pool counters.
+     *
+     * @returns
+     *   Current counter values.
+     */
+    FiberPoolStats stats() const;
+
+  private:
+    /**
+     * A cache of idle fibers.
+     */
+    struct Cache
+    {
+        /** Lock for cache, only contended if cache is shared. */
+        std::mutex mutex;
+
+        /** Idle fibers, indexed by size class. */
+        std::vector<std::vector<Fiber *>> fibers;
+    };
+
+    /**
+     * Try and pop an idle fiber from a cache.
+     *
+     * @param cache
+     *   Cache to pop from.
+     *
+     * @param size_class
+     *   Size class of fiber.
+     *
+     * @returns
+     *   Fiber, or nullptr if cache had no fibers of that size.
+     */
+    Fiber *try_pop(Cache &cache, std::size_t size_class);
+
+    /**
+     * Get the size class of a fiber.
+     *
+     * @param fiber
+     *   Fiber to get size class of.
+     *
+     * @returns
+     *   Index of size class.
+     */
+    std::size_t size_class(const Fiber *fiber) const;
+
+    /** Distinct stack sizes, in pages. */
+    std::vector<std::size_t> class_pages_;
+
+    /** Size class for each priority. */
+    std::array<std::size_t, job_priority_count> priority_classes_;
+
+    /** Whether stacks should be painted. */
+    bool paint_stacks_;
+
+    /** Maximum number of idle fibers per cache. */
+    std::size_t cache_capacity_;
+
+    /** Caches, the last is the shared cache. */
+    std::vector<std::unique_ptr<Cache>> caches_;
+
+    /** Number of pool hits. */
+    std::atomic<std::uint64_t> hits_;
+
+    /** Number of pool misses. */
+    std::atomic<std::uint64_t> misses_;
+
+    /** Number of fibers currently acquired. */
+    std::atomic<std::uint64_t> live_;
+
+    /** Peak number of fibers acquired. */
+    std::atomic<std::uint64_t> peak_live_;
+
+    /** Stack high water mark for each priority. */
+    std::array<std::atomic<std::size_t>, job_priority_count> stack_high_water_;
+};
+
+}
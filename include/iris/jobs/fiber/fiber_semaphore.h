@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+
+#include "jobs/fiber/fiber_wait_queue.h"
+
+namespace iris
+{
+
+/**
+ * A counting semaphore. Fibers waiting to acquire are suspended, rather than
+ * blocking their worker thread. Non-fiber threads block as normal.
+ */
+class FiberSemaphore
+{
+  public:
+    /**
+     * Construct a new FiberSemaphore.
+     *
+     * @param initial
+     *   Initial count.
+     */
+    explicit FiberSemaphore(std::ptrdiff_t initial = 0);
+
+    // disable copy and move
+    FiberSemaphore(const FiberSemaphore &) = delete;
+    FiberSemaphore &operator=(const FiberSemaphore &) = delete;
+    FiberSemaphore(FiberSemaphore &&) = delete;
+    FiberSemaphore &operator=(FiberSemaphore &&) = delete;
+
+    /**
+     * Decrement the count, waiting if it is zero.
+     */
+    void acquire();
+
+    /**
+     * Try and decrement the count without waiting.
+     *
+     * @returns
+     *   True if count was decremented, otherwise false.
+     */
+    bool try_acquire();
+
+    /**
+     * Increment the count, waking a waiter for each increment.
+     *
+     * @param update
+     *   Amount to increment count by.
+     */
+    void release(std::ptrdiff_t update = 1);
+
+  private:
+    /** Guards state. */
+    std::mutex guard_;
+
+    /** Current count. */
+    std::ptrdiff_t count_;
+
+    /** Queue of waiters. */
+    FiberWaitQueue waiters_;
+};
+
+}
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+namespace iris
+{
+
+class Fiber;
+class FiberJobSystem;
+
+/**
+ * A FIFO queue of things waiting on a fiber synchronisation primitive. This is
+ * the building block for FiberMutex, FiberEvent and FiberSemaphore.
+ *
+ * If the caller is a fiber running on a FiberJobSystem worker then it is
+ * suspended, so the worker can get on with other fibers, and rescheduled when
+ * notified. Any other caller falls back to blocking on a condition variable.
+ *
+ * All methods must be called whilst holding the mutex guarding the primitives
+ * state, waiters are kept in an intrusive list on their own stacks so waiting
+ * does not allocate.
+ */
+class FiberWaitQueue
+{
+  public:
+    /**
+     * Construct an empty FiberWaitQueue.
+     */
+    FiberWaitQueue();
+
+    // disable copy and move
+    FiberWaitQueue(const FiberWaitQueue &) = delete;
+    FiberWaitQueue &operator=(const FiberWaitQueue &) = delete;
+    FiberWaitQueue(FiberWaitQueue &&) = delete;
+    FiberWaitQueue &operator=(FiberWaitQueue &&) = delete;
+
+    /**
+     * Wait until notified. The lock is released whilst waiting and reacquired
+     * before returning. There are no spurious wakeups, but another thread may
+     * acquire the lock first so callers should recheck their condition.
+     *
+     * @param lock
+     *   Lock guarding primitive state, must be locked.
+     */
+    void wait(std::unique_lock<std::mutex> &lock);
+
+    /**
+     * Wake the longest waiting waiter.
+     *
+     * @returns
+     *   True if a waiter was woken, false if nothing was waiting.
+     */
+    bool notify_one();
+
+    /**
+     * Wake all waiters.
+     */
+    void notify_all();
+
+    /**
+     * Check if anything is waiting.
+     *
+     * @returns
+     *   True if queue is empty, otherwise false.
+     */
+    bool empty() const;
+
+  private:
+    /**
+     * Intrusive list node, lives on the waiters stack.
+     */
+    struct Waiter
+    {
+        /** Suspended fiber, nullptr if waiter is blocked on the condition variable. */
+        Fiber *fiber;
+
+        /** Job system to reschedule fiber on. */
+        FiberJobSystem *job_system;
+
+        /** Flag indicating waiter has been notified. */
+        bool notified;
+
+        /** Next waiter in queue. */
+        Waiter *next;
+    };
+
+    /**
+     * Remove the head waiter and wake it. The waiter must not be touched after
+     * this as it may have already returned.
+     */
+    void wake_front();
+
+    /** Longest waiting waiter. */
+    Waiter *head_;
+
+    /** Most recent waiter. */
+    Waiter *tail_;
+
+    /** Condition variable for non-fiber waiters. */
+    std::condition_variable condition_;
+};
+
+}
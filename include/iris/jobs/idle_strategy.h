@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(IRIS_ARCH_X86_64)
+#include <immintrin.h>
+#endif
+
+namespace iris
+{
+
+/**
+ * How a worker with nothing to do waits for more work. It first spins,
+ * checking for work between pause instructions, then yields its time slice
+ * and finally parks until woken.
+ *
+ * Spinning avoids the latency of being woken for short gaps between jobs, at
+ * the cost of burning cpu when there really is nothing to do. Setting both
+ * counts to zero parks immediately.
+ */
+struct IdleStrategy
+{
+    /** Number of times to check for work between pause instructions. */
+    std::uint32_t spin_count = 256u;
+
+    /** Number of times to check for work between yields. */
+    std::uint32_t yield_count = 16u;
+};
+
+/**
+ * Hint to the cpu that the caller is spinning, this lets a sibling hardware
+ * thread make progress and saves power.
+ */
+inline void cpu_relax()
+{
+#if defined(IRIS_ARCH_X86_64)
+    _mm_pause();
+#elif defined(IRIS_ARCH_ARM64)
+    asm volatile("yield");
+#endif
+}
+
+}
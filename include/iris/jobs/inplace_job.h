@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "jobs/job.h"
+#include "jobs/job_arena.h"
+
+namespace iris
+{
+
+/**
+ * A move-only job which stores its callable in a fixed size inline buffer, so
+ * submitting it does not allocate. Callables too big for the buffer can be
+ * placed in a JobArena, in which case only a pointer is stored inline.
+ *
+ * A Job (std::function) can also be wrapped, it is moved into the inline
+ * buffer so no further allocation occurs.
+ */
+class InplaceJob
+{
+  public:
+    /** Size of inline buffer in bytes. */
+    static constexpr std::size_t capacity = 64u;
+
+    /**
+     * Check if a callable can be stored inline.
+     */
+    template <class F>
+    static constexpr bool fits_inline = (sizeof(F) <= capacity) && (alignof(F) <= alignof(std::max_align_t)) &&
+                                        std::is_nothrow_move_constructible_v<F>;
+
+    /**
+     * Construct an empty InplaceJob.
+     */
+    InplaceJob()
+        : vtable_(nullptr)
+    {
+    }
+
+    /**
+     * Construct an empty InplaceJob.
+     */
+    InplaceJob(std::nullptr_t)
+        : InplaceJob()
+    {
+    }
+
+    /**
+     * Construct an InplaceJob from a Job. This is explicit so a braced list of
+     * Jobs is not ambiguous between overloads taking either type.
+     *
+     * @param job
+     *   Job to run, will be moved inline.
+     */
+    explicit InplaceJob(Job job)
+        : InplaceJob()
+    {
+        static_assert(fits_inline<Job>, "Job too big for inline storage");
+
+        if (job)
+        {
+            emplace_inline<Job>(std::move(job));
+        }
+    }
+
+    /**
+     * Construct an InplaceJob from a callable, which must fit inline.
+     *
+     * @param function
+     *   Callable to run.
+     */
+    template <
+        class F,
+        class = std::enable_if_t<
+            !std::is_same_v<std::decay_t<F>, InplaceJob> && !std::is_same_v<std::decay_t<F>, Job> &&
+            std::is_invocable_v<std::decay_t<F> &>>>
+    explicit InplaceJob(F &&function)
+        : InplaceJob()
+    {
+        static_assert(fits_inline<std::decay_t<F>>, "callable too big for inline storage, use a JobArena");
+
+        emplace_inline<std::decay_t<F>>(std::forward<F>(function));
+    }
+
+    /**
+     * Construct an InplaceJob from a callable, which is stored inline if it
+     * fits or allocated in the supplied arena if not.
+     *
+     * @param function
+     *   Callable to run.
+     *
+     * @param arena
+     *   Arena to allocate from if callable does not fit inline. Must outlive
+     *   the job.
+     */
+    template <class F>
+    InplaceJob(F &&function, JobArena &arena)
+        : InplaceJob()
+    {
+        using Callable = std::decay_t<F>;
+
+        if constexpr (fits_inline<Callable>)
+        {
+            emplace_inline<Callable>(std::forward<F>(function));
+        }
+        else
+        {
+            auto *ptr = ::new (arena.allocate(sizeof(Callable), alignof(Callable))) Callable(std::forward<F>(function));
+            ::new (static_cast<void *>(storage_)) Callable *(ptr);
+            vtable_ = &arena_vtable<Callable>;
+        }
+    }
+
+    ~InplaceJob()
+    {
+        reset();
+    }
+
+    InplaceJob(InplaceJob &&other) noexcept
+        : InplaceJob()
+    {
+        take(other);
+    }
+
+    InplaceJob &operator=(InplaceJob &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            take(other);
+        }
+
+        return *this;
+    }
+
+    InplaceJob(const InplaceJob &) = delete;
+    InplaceJob &operator=(const InplaceJob &) = delete;
+
+    /**
+     * Run the job.
+     */
+    void operator()()
+    {
+        vtable_->invoke(storage_);
+    }
+
+    /**
+     * Check if job holds a callable.
+     *
+     * @returns
+     *   True if job is not empty.
+     */
+    explicit operator bool() const
+    {
+        return vtable_ != nullptr;
+    }
+
+    /**
+     * Destroy the stored callable, leaving the job empty.
+     */
+    void reset()
+    {
+        if (vtable_ != nullptr)
+        {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+  private:
+    /**
+     * Type erased operations on stored callable.
+     */
+    struct VTable
+    {
+        /** Call the callable. */
+        void (*invoke)(void *);
+
+        /** Move construct callable from second argument into first and destroy second. */
+        void (*move)(void *, void *);
+
+        /** Destroy callable. */
+        void (*destroy)(void *);
+    };
+
+    /** Operations for a callable stored inline. */
+    template <class F>
+    static constexpr VTable inline_vtable = {
+        [](void *storage) { (*std::launder(static_cast<F *>(storage)))(); },
+        [](void *dst, void *src) {
+            auto *other = std::launder(static_cast<F *>(src));
+            ::new (dst) F(std::move(*other));
+            other->~F();
+        },
+        [](void *storage) { std::launder(static_cast<F *>(storage))->~F(); }};
+
+    /** Operations for a callable stored in an arena, storage holds a pointer. */
+    template <class F>
+    static constexpr VTable arena_vtable = {
+        [](void *storage) { (**std::launder(static_cast<F **>(storage)))(); },
+        [](void *dst, void *src) { ::new (dst) F *(*std::launder(static_cast<F **>(src))); },
+        [](void *storage) { (*std::launder(static_cast<F **>(storage)))->~F(); }};
+
+    /**
+     * Construct a callable in the inline buffer.
+     *
+     * @param function
+     *   Callable to store.
+     */
+    template <class F, class Arg>
+    void emplace_inline(Arg &&function)
+    {
+        ::new (static_cast<void *>(storage_)) F(std::forward<Arg>(function));
+        vtable_ = &inline_vtable<F>;
+    }
+
+    /**
+     * Move the callable out of another job, leaving it empty.
+     *
+     * @param other
+     *   Job to move from.
+     */
+    void take(InplaceJob &other) noexcept
+    {
+        if (other.vtable_ != nullptr)
+        {
+            other.vtable_->move(storage_, other.storage_);
+            vtable_ = std::exchange(other.vtable_, nullptr);
+        }
+    }
+
+    /** Operations for stored callable, nullptr if empty. */
+    const VTable *vtable_;
+
+    /** Inline storage for callable. */
+    alignas(std::max_align_t) std::byte storage_[capacity];
+};
+
+}
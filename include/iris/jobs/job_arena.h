@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+namespace iris
+{
+
+/**
+ * A bump allocator for job captures that are too big to store inline in an
+ * InplaceJob. Intended to be reset once per frame.
+ *
+ * Allocation is lock-free until the fixed size block is exhausted, after which
+ * it falls back to a locked monotonic allocator. Memory is only reclaimed on
+ * reset.
+ */
+class JobArena
+{
+  public:
+    /**
+     * Construct a new JobArena.
+     *
+     * @param capacity
+     *   Size of lock-free block in bytes.
+     *
+     * @param upstream
+     *   Resource to allocate memory from.
+     */
+    explicit JobArena(std::size_t capacity, std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+
+    ~JobArena();
+
+    // disable copy and move
+    JobArena(const JobArena &) = delete;
+    JobArena &operator=(const JobArena &) = delete;
+    JobArena(JobArena &&) = delete;
+    JobArena &operator=(JobArena &&) = delete;
+
+    /**
+     * Allocate memory. Safe to call from multiple threads.
+     *
+     * @param size
+     *   Number of bytes.
+     *
+     * @param alignment
+     *   Alignment of memory, must be a power of two.
+     *
+     * @returns
+     *   Pointer to allocated memory.
+     */
+    void *allocate(std::size_t size, std::size_t alignment);
+
+    /**
+     * Reclaim all memory. Must not be called whilst any jobs allocated from the
+     * arena are alive.
+     */
+    void reset();
+
+    /**
+     * Get number of bytes used from the lock-free block.
+     *
+     * @returns
+     *   Bytes used.
+     */
+    std::size_t used() const;
+
+  private:
+    /** Resource memory is allocated from. */
+    std::pmr::memory_resource *upstream_;
+
+    /** Size of lock-free block. */
+    std::size_t capacity_;
+
+    /** Lock-free block. */
+    std::byte *buffer_;
+
+    /** Offset of next free byte in block. */
+    std::atomic<std::size_t> offset_;
+
+    /** Lock for overflow_. */
+    std::mutex overflow_mutex_;
+
+    /** Allocator for when block is exhausted. */
+    std::pmr::monotonic_buffer_resource overflow_;
+};
+
+}
@@ -0,0 +1,64 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Enumeration of job priorities, in order of most to least urgent.
+ *
+ * Job systems always prefer more urgent jobs but will periodically run less
+ * urgent ones, so a steady stream of critical work cannot starve the rest.
+ */
+enum class JobPriority : std::uint8_t
+{
+    /** Latency sensitive work the current frame is blocked on. */
+    CRITICAL,
+
+    /** Default priority. */
+    NORMAL,
+
+    /** Work which can be delayed, e.g. streaming or decoding. */
+    BACKGROUND
+};
+
+/** Number of JobPriority values. */
+static constexpr std::size_t job_priority_count = 3u;
+
+/**
+ * Get the order in which to search priorities when picking the next job. This
+ * is usually most to least urgent, but every few picks a less urgent priority
+ * is moved to the front to guarantee it makes progress.
+ *
+ * @param pick
+ *   Number of jobs picked so far by the caller.
+ *
+ * @returns
+ *   Priorities in search order.
+ */
+constexpr std::array<JobPriority, job_priority_count> priority_order(std::uint64_t pick)
+{
+    // a background job is run at least once every 16 picks and a normal job
+    // at least once every 4 (when there are any)
+    if ((pick % 16u) == 15u)
+    {
+        return {JobPriority::BACKGROUND, JobPriority::CRITICAL, JobPriority::NORMAL};
+    }
+    else if ((pick % 4u) == 3u)
+    {
+        return {JobPriority::NORMAL, JobPriority::CRITICAL, JobPriority::BACKGROUND};
+    }
+
+    return {JobPriority::CRITICAL, JobPriority::NORMAL, JobPriority::BACKGROUND};
+}
+
+}
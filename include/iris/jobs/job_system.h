@@ -8,7 +8,9 @@
 
 #include <vector>
 
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 
 namespace iris
 {
@@ -34,8 +36,24 @@ class JobSystem
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    virtual void add_jobs(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) = 0;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added these are executed in a fire-and-forget
+     * manner.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    virtual void add_jobs(const std::vector<Job> &jobs) = 0;
+    virtual void add_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) = 0;
 
     /**
      * Add a collection of jobs. Once added this call blocks until all
@@ -43,8 +61,24 @@ class JobSystem
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    virtual void wait_for_jobs(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) = 0;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added this call blocks until all jobs have
+     * finished executing.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    virtual void wait_for_jobs(const std::vector<Job> &jobs) = 0;
+    virtual void wait_for_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) = 0;
 };
 
 }
@@ -6,9 +6,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 #include "jobs/job_system.h"
 
 namespace iris
@@ -38,8 +44,24 @@ class JobSystemManager
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    virtual void add(const std::vector<Job> &jobs) = 0;
+    virtual void add(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) = 0;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added these are executed in a fire-and-forget
+     * manner.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    virtual void add(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) = 0;
 
     /**
      * Add a collection of jobs. Once added this call blocks until all
@@ -47,8 +69,229 @@ class JobSystemManager
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    virtual void wait(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) = 0;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added this call blocks until all jobs have
+     * finished executing.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    virtual void wait(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) = 0;
+
+    /**
+     * Call a function for every index in a range, in parallel. Blocks until
+     * all calls have finished.
+     *
+     * The range is recursively split in half, with each half being a job, until
+     * it is no bigger than the grain size. This allows idle workers to steal
+     * large chunks of work. The function is called directly for each index in
+     * a chunk, so there is no per-element job.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past last index.
+     *
+     * @param grain
+     *   Maximum number of indices to process in a single job, zero will pick a
+     *   grain based on the number of hardware threads.
+     *
+     * @param function
+     *   Function to call, will be passed each index.
+     */
+    template <class Function>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, Function &&function)
+    {
+        if (begin < end)
+        {
+            for_range(begin, end, resolve_grain(begin, end, grain), function);
+        }
+    }
+
+    /**
+     * Map every index in a range to a value and reduce them to a single
+     * result, in parallel. Blocks until complete. Splitting is as per
+     * parallel_for.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past last index.
+     *
+     * @param grain
+     *   Maximum number of indices to process in a single job, zero will pick a
+     *   grain based on the number of hardware threads.
+     *
+     * @param identity
+     *   Identity value for reduction, returned for an empty range.
+     *
+     * @param map
+     *   Function to call for each index, should return a T.
+     *
+     * @param reduce
+     *   Function to combine two T values, must be associative.
+     *
+     * @returns
+     *   Reduced value.
+     */
+    template <class T, class Map, class Reduce>
+    T parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain, T identity, Map &&map, Reduce &&reduce)
+    {
+        return (begin < end) ? reduce_range(begin, end, resolve_grain(begin, end, grain), identity, map, reduce)
+                             : identity;
+    }
+
+  private:
+    /**
+     * Get the grain size to use for a range.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past last index.
+     *
+     * @param grain
+     *   Requested grain, zero for automatic.
+     *
+     * @returns
+     *   Grain size to use.
+     */
+    static std::size_t resolve_grain(std::size_t begin, std::size_t end, std::size_t grain)
+    {
+        // aim for a few chunks per thread, so there is something to steal if
+        // some chunks take longer than others
+        const auto chunks = std::max(1u, std::thread::hardware_concurrency()) * 8u;
+        return (grain == 0u) ? std::max<std::size_t>(1u, (end - begin) / chunks) : grain;
+    }
+
+    /**
+     * Recursive implementation of parallel_for.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past last index.
+     *
+     * @param grain
+     *   Grain size.
+     *
+     * @param function
+     *   Function to call for each index.
+     */
+    template <class Function>
+    void for_range(std::size_t begin, std::size_t end, std::size_t grain, Function &function)
+    {
+        if (end - begin <= grain)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                function(i);
+            }
+        }
+        else
+        {
+            const auto middle = begin + ((end - begin) / 2u);
+
+            // capture only a reference to a stack struct so the job fits in
+            // the small buffer and doesn't allocate
+            struct Split
+            {
+                JobSystemManager *manager;
+                std::size_t begin;
+                std::size_t end;
+                std::size_t grain;
+                Function *function;
+            };
+
+            const Split left{this, begin, middle, grain, &function};
+            const Split right{this, middle, end, grain, &function};
+
+            wait(
+                {[&left]() { left.manager->for_range(left.begin, left.end, left.grain, *left.function); },
+                 [&right]() { right.manager->for_range(right.begin, right.end, right.grain, *right.function); }});
+        }
+    }
+
+    /**
+     * Recursive implementation of parallel_reduce.
+     *
+     * @param begin
+     *   First index.
+     *
+     * @param end
+     *   One past last index.
+     *
+     * @param grain
+     *   Grain size.
+     *
+     * @param identity
+     *   Identity value for reduction.
+     *
+     * @param map
+     *   Function to call for each index.
+     *
+     * @param reduce
+     *   Function to combine two values.
+     *
+     * @returns
+     *   Reduced value for range.
      */
-    virtual void wait(const std::vector<Job> &jobs) = 0;
+    template <class T, class Map, class Reduce>
+    T reduce_range(std::size_t begin, std::size_t end, std::size_t grain, const T &identity, Map &map, Reduce &reduce)
+    {
+        if (end - begin <= grain)
+        {
+            auto value = identity;
+
+            for (auto i = begin; i < end; ++i)
+            {
+                value = reduce(std::move(value), map(i));
+            }
+
+            return value;
+        }
+
+        const auto middle = begin + ((end - begin) / 2u);
+
+        struct Split
+        {
+            JobSystemManager *manager;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t grain;
+            const T *identity;
+            Map *map;
+            Reduce *reduce;
+            T result;
+        };
+
+        Split left{this, begin, middle, grain, &identity, &map, &reduce, identity};
+        Split right{this, middle, end, grain, &identity, &map, &reduce, identity};
+
+        const auto run = [](Split &split)
+        {
+            split.result = split.manager->reduce_range(
+                split.begin, split.end, split.grain, *split.identity, *split.map, *split.reduce);
+        };
+
+        wait({[&left, &run]() { run(left); }, [&right, &run]() { run(right); }});
+
+        return reduce(std::move(left.result), std::move(right.result));
+    }
 };
 
 }
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// job systems record trace events with the following macros, which compile to
+// nothing unless IRIS_ENABLE_JOB_TRACING is defined (see the cmake option of
+// the same name)
+// note that arguments are not evaluated when tracing is disabled
+
+#if defined(IRIS_ENABLE_JOB_TRACING)
+#define IRIS_TRACE_JOB(TYPE, ID, ARG) ::iris::JobTracer::record(TYPE, ID, ARG)
+#define IRIS_TRACE_THREAD_NAME(NAME) ::iris::JobTracer::set_thread_name(NAME)
+#define IRIS_TRACE_FRAME() ::iris::JobTracer::mark_frame()
+#else
+#define IRIS_TRACE_JOB(TYPE, ID, ARG)
+#define IRIS_TRACE_THREAD_NAME(NAME)
+#define IRIS_TRACE_FRAME()
+#endif
+
+namespace iris
+{
+
+/**
+ * Types of events recorded by JobTracer.
+ */
+enum class JobTraceEventType : std::uint8_t
+{
+    /** Job added to a queue. */
+    ENQUEUE,
+
+    /** Job started on a worker. */
+    START,
+
+    /** Job finished. */
+    END,
+
+    /** Job suspended to wait on something. */
+    SUSPEND,
+
+    /** Suspended job resumed on a worker. */
+    RESUME,
+
+    /** Suspended job made runnable again. */
+    WAKE,
+
+    /** Job stolen from another worker, arg is the victim. */
+    STEAL,
+
+    /** Start of a new frame, id is the frame number. */
+    FRAME
+};
+
+/**
+ * A single recorded event.
+ */
+struct JobTraceEvent
+{
+    /**
+     * Time of event, this is only converted to nanoseconds since the tracer
+     * started when exported.
+     */
+    std::uint64_t timestamp;
+
+    /** Id of job (or frame) event refers to. */
+    std::uint64_t id;
+
+    /** Event specific argument. */
+    std::uint32_t arg;
+
+    /** Type of event. */
+    JobTraceEventType type;
+};
+
+/**
+ * Records job system events in to per-thread ring buffers, which can be
+ * exported in the Chrome trace event format (viewable in chrome://tracing or
+ * Perfetto).
+ *
+ * Recording never locks, each thread owns its buffer and only the oldest
+ * events are lost when it wraps. Exporting whilst jobs are running is best
+ * effort, events overwritten during the export are dropped.
+ *
+ * Where the cpu has an invariant timestamp counter events are stamped with it
+ * directly, as it is much cheaper to read than the system clock.
+ */
+class JobTracer
+{
+  public:
+    /** Number of events kept per thread. */
+    static constexpr std::size_t buffer_capacity = 16384u;
+
+    /**
+     * Record an event for the calling thread.
+     *
+     * @param type
+     *   Type of event.
+     *
+     * @param id
+     *   Id of job event refers to.
+     *
+     * @param arg
+     *   Event specific argument.
+     */
+    static void record(JobTraceEventType type, std::uint64_t id, std::uint32_t arg);
+
+    /**
+     * Set the name the calling thread is exported with.
+     *
+     * @param name
+     *   Thread name.
+     */
+    static void set_thread_name(const std::string &name);
+
+    /**
+     * Record the start of a new frame.
+     */
+    static void mark_frame();
+
+    /**
+     * Write recorded events as Chrome trace JSON.
+     *
+     * @param out
+     *   Stream to write to.
+     *
+     * @param frame_count
+     *   Number of most recent frames to write, zero for all recorded events.
+     */
+    static void write_chrome_trace(std::ostream &out, std::size_t frame_count);
+};
+
+}
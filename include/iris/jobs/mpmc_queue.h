@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A lock-free bounded multi-producer multi-consumer FIFO queue.
+ *
+ * Elements live in a fixed ring of slots, each with a sequence number that
+ * says whether it is ready to be written or read on the current lap. Producers
+ * and consumers claim positions with a single compare-exchange and never wait
+ * on each other unless the queue is full or empty. Slots are padded to a cache
+ * line so neighbouring producers and consumers do not false share.
+ *
+ * Based on Dmitry Vyukov's bounded MPMC queue.
+ */
+template <class T>
+class MpmcQueue
+{
+    static_assert(
+        std::is_default_constructible_v<T> && std::is_move_assignable_v<T>,
+        "queue elements must be default constructible and move assignable");
+
+  public:
+    // member types
+    using size_type = std::size_t;
+    using value_type = T;
+    using reference = T &;
+
+    /**
+     * Construct an empty queue.
+     *
+     * @param capacity
+     *   Maximum number of elements, must be a power of two and at least two.
+     */
+    explicit MpmcQueue(size_type capacity = 1024u)
+        : slots_(std::make_unique<Slot[]>(capacity))
+        , mask_(capacity - 1u)
+        , enqueue_pos_(0u)
+        , dequeue_pos_(0u)
+    {
+        expect((capacity >= 2u) && ((capacity & (capacity - 1u)) == 0u), "capacity must be a power of two");
+
+        for (auto i = size_type{0u}; i < capacity; ++i)
+        {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // disable copy and move
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue &operator=(const MpmcQueue &) = delete;
+    MpmcQueue(MpmcQueue &&) = delete;
+    MpmcQueue &operator=(MpmcQueue &&) = delete;
+
+    /**
+     * Check if the queue is empty. This is only a snapshot and may be stale by
+     * the time it is acted upon.
+     *
+     * @returns
+     *   True if queue is empty, else false.
+     */
+    bool empty() const
+    {
+        return enqueue_pos_.load(std::memory_order_relaxed) == dequeue_pos_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the maximum number of elements the queue can hold.
+     *
+     * @returns
+     *   Queue capacity.
+     */
+    size_type capacity() const
+    {
+        return mask_ + 1u;
+    }
+
+    /**
+     * Try to add an item to the end of the queue.
+     *
+     * @param args
+     *   Arguments for object being placed in queue, will be perfectly
+     *   forwarded. They are left untouched if the queue is full.
+     *
+     * @returns
+     *   True if item was enqueued, false if the queue was full.
+     */
+    template <class... Args>
+    bool try_enqueue(Args &&...args)
+    {
+        auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto &slot = slots_[pos & mask_];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0)
+            {
+                // slot is free on this lap, try and claim it
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed))
+                {
+                    slot.value = T(std::forward<Args>(args)...);
+                    slot.sequence.store(pos + 1u, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // slot still holds an element from the previous lap
+                return false;
+            }
+            else
+            {
+                // another producer beat us to it
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Add an item to the end of the queue, yielding whilst the queue is full.
+     *
+     * @param args
+     *   Arguments for object being placed in queue, will be perfectly
+     *   forwarded.
+     */
+    template <class... Args>
+    void enqueue(Args &&...args)
+    {
+        T value(std::forward<Args>(args)...);
+
+        while (!try_enqueue(std::move(value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Tries to pop the next element off the queue.
+     *
+     * @param element
+     *   Reference to store popped element.
+     *
+     * @returns
+     *   True if an element could be dequeued, false if the queue was empty.
+     */
+    bool try_dequeue(reference element)
+    {
+        auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto &slot = slots_[pos & mask_];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1u);
+
+            if (diff == 0)
+            {
+                // slot has been written on this lap, try and claim it
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed))
+                {
+                    element = std::move(slot.value);
+
+                    // free the slot for the producer on the next lap
+                    slot.sequence.store(pos + mask_ + 1u, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+  private:
+    /**
+     * Storage for a single element.
+     */
+    struct alignas(64) Slot
+    {
+        /** Position slot is next ready to be written (pos) or read (pos + 1) at. */
+        std::atomic<size_type> sequence;
+
+        /** Stored element. */
+        T value;
+    };
+
+    /** Ring of slots. */
+    std::unique_ptr<Slot[]> slots_;
+
+    /** Mask to map a position to a slot. */
+    size_type mask_;
+
+    /** Next position to write. */
+    alignas(64) std::atomic<size_type> enqueue_pos_;
+
+    /** Next position to read. */
+    alignas(64) std::atomic<size_type> dequeue_pos_;
+};
+
+}
@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "core/thread.h"
+
+namespace iris
+{
+
+/**
+ * Allows a service to check whether it has been asked to stop. A service
+ * should check this regularly, blocking calls should use a timeout so this
+ * can be polled.
+ */
+class StopToken
+{
+  public:
+    /**
+     * Check if a stop has been requested.
+     *
+     * @returns
+     *   True if service should stop, otherwise false.
+     */
+    bool stop_requested() const;
+
+    /**
+     * Sleep for a duration, waking early if a stop is requested.
+     *
+     * @param timeout
+     *   Time to sleep for.
+     *
+     * @returns
+     *   True if a stop was requested, otherwise false.
+     */
+    bool wait_for(std::chrono::milliseconds timeout) const;
+
+    /**
+     * Sleep until a point in time, waking early if a stop is requested.
+     *
+     * @param time_point
+     *   Time to sleep until.
+     *
+     * @returns
+     *   True if a stop was requested, otherwise false.
+     */
+    bool wait_until(std::chrono::steady_clock::time_point time_point) const;
+
+  private:
+    // only a ServiceThread can create tokens
+    friend class ServiceThread;
+
+    /**
+     * Shared stop state.
+     */
+    struct State
+    {
+        /** Lock for stop_requested. */
+        std::mutex mutex;
+
+        /** Signalled when a stop is requested. */
+        std::condition_variable condition;
+
+        /** Flag indicating a stop has been requested. */
+        bool stop_requested = false;
+    };
+
+    /**
+     * Construct a new StopToken.
+     *
+     * @param state
+     *   State to observe.
+     */
+    explicit StopToken(State *state);
+
+    /** State to observe. */
+    State *state_;
+};
+
+/**
+ * A dedicated thread for running a single long-lived or blocking service, such
+ * as a socket read loop. This keeps such work off the job system workers,
+ * where it would otherwise permanently occupy one of them.
+ *
+ * The service is passed a StopToken and should return promptly once a stop is
+ * requested. The thread is stopped and joined on destruction. Anything the
+ * service throws is logged and ends the service, owners that expect it to run
+ * until stopped should check is_running.
+ */
+class ServiceThread
+{
+  public:
+    /** Function run by the thread. */
+    using Service = std::function<void(const StopToken &)>;
+
+    /**
+     * Construct a new ServiceThread and start the service.
+     *
+     * @param name
+     *   Name of service, for logging.
+     *
+     * @param service
+     *   Function to run.
+     */
+    ServiceThread(const std::string &name, Service service);
+
+    /**
+     * Stops and joins the thread.
+     */
+    ~ServiceThread();
+
+    // disable copy and move
+    ServiceThread(const ServiceThread &) = delete;
+    ServiceThread &operator=(const ServiceThread &) = delete;
+    ServiceThread(ServiceThread &&) = delete;
+    ServiceThread &operator=(ServiceThread &&) = delete;
+
+    /**
+     * Ask the service to stop, does not wait for it to do so.
+     */
+    void request_stop();
+
+    /**
+     * Ask the service to stop and wait for it to return. Safe to call more
+     * than once.
+     */
+    void stop();
+
+    /**
+     * Check if the service is still running.
+     *
+     * @returns
+     *   True if service has not yet returned, otherwise false.
+     */
+    bool is_running() const;
+
+  private:
+    /** Name of service. */
+    std::string name_;
+
+    /** Stop state shared with token. */
+    StopToken::State state_;
+
+    /** Flag indicating service is running. */
+    std::atomic<bool> running_;
+
+    /** Thread running service. */
+    Thread thread_;
+};
+
+}
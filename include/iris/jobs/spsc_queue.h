@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A lock-free bounded single-producer single-consumer FIFO queue.
+ *
+ * This is a cheaper alternative to MpmcQueue for when exactly one thread
+ * enqueues and exactly one thread dequeues: there are no compare-exchanges and
+ * each side caches the other's position, so it only touches the other side's
+ * cache line when the queue looks full (or empty).
+ */
+template <class T>
+class SpscQueue
+{
+    static_assert(
+        std::is_default_constructible_v<T> && std::is_move_assignable_v<T>,
+        "queue elements must be default constructible and move assignable");
+
+  public:
+    // member types
+    using size_type = std::size_t;
+    using value_type = T;
+    using reference = T &;
+
+    /**
+     * Construct an empty queue.
+     *
+     * @param capacity
+     *   Maximum number of elements, must be a power of two.
+     */
+    explicit SpscQueue(size_type capacity = 1024u)
+        : slots_(std::make_unique<T[]>(capacity))
+        , mask_(capacity - 1u)
+        , tail_(0u)
+        , cached_head_(0u)
+        , head_(0u)
+        , cached_tail_(0u)
+    {
+        expect((capacity != 0u) && ((capacity & (capacity - 1u)) == 0u), "capacity must be a power of two");
+    }
+
+    // disable copy and move
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+    SpscQueue(SpscQueue &&) = delete;
+    SpscQueue &operator=(SpscQueue &&) = delete;
+
+    /**
+     * Check if the queue is empty. This is only a snapshot and may be stale by
+     * the time it is acted upon.
+     *
+     * @returns
+     *   True if queue is empty, else false.
+     */
+    bool empty() const
+    {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the maximum number of elements the queue can hold.
+     *
+     * @returns
+     *   Queue capacity.
+     */
+    size_type capacity() const
+    {
+        return mask_ + 1u;
+    }
+
+    /**
+     * Try to add an item to the end of the queue. Must only be called by the
+     * producing thread.
+     *
+     * @param args
+     *   Arguments for object being placed in queue, will be perfectly
+     *   forwarded. They are left untouched if the queue is full.
+     *
+     * @returns
+     *   True if item was enqueued, false if the queue was full.
+     */
+    template <class... Args>
+    bool try_enqueue(Args &&...args)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+
+        if (tail - cached_head_ == capacity())
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity())
+            {
+                return false;
+            }
+        }
+
+        slots_[tail & mask_] = T(std::forward<Args>(args)...);
+        tail_.store(tail + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Add an item to the end of the queue, yielding whilst the queue is full.
+     * Must only be called by the producing thread.
+     *
+     * @param args
+     *   Arguments for object being placed in queue, will be perfectly
+     *   forwarded.
+     */
+    template <class... Args>
+    void enqueue(Args &&...args)
+    {
+        T value(std::forward<Args>(args)...);
+
+        while (!try_enqueue(std::move(value)))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Tries to pop the next element off the queue. Must only be called by the
+     * consuming thread.
+     *
+     * @param element
+     *   Reference to store popped element.
+     *
+     * @returns
+     *   True if an element could be dequeued, false if the queue was empty.
+     */
+    bool try_dequeue(reference element)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+
+        if (head == cached_tail_)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_)
+            {
+                return false;
+            }
+        }
+
+        element = std::move(slots_[head & mask_]);
+        head_.store(head + 1u, std::memory_order_release);
+
+        return true;
+    }
+
+  private:
+    /** Ring of elements. */
+    std::unique_ptr<T[]> slots_;
+
+    /** Mask to map a position to a slot. */
+    size_type mask_;
+
+    /** Next position to write, owned by producer. */
+    alignas(64) std::atomic<size_type> tail_;
+
+    /** Producers last view of head. */
+    size_type cached_head_;
+
+    /** Next position to read, owned by consumer. */
+    alignas(64) std::atomic<size_type> head_;
+
+    /** Consumers last view of tail. */
+    size_type cached_tail_;
+};
+
+}
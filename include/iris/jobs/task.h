@@ -0,0 +1,508 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+template <class T>
+class Task;
+
+namespace detail
+{
+
+/**
+ * Common state for all task promises. Handles exceptions and handing control
+ * back to whatever is waiting on the task when it finishes.
+ */
+class TaskPromiseBase
+{
+  public:
+    /**
+     * Awaiter for the end of a task, symmetrically transfers to the
+     * continuation (if there is one).
+     */
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <class Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            auto &promise = static_cast<TaskPromiseBase &>(handle.promise());
+
+            // if we are part of a group then only the last to finish continues
+            if ((promise.remaining_ != nullptr) && (promise.remaining_->fetch_sub(1u, std::memory_order_acq_rel) != 1u))
+            {
+                return std::noop_coroutine();
+            }
+
+            return promise.continuation_ ? promise.continuation_ : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+    };
+
+    TaskPromiseBase()
+        : continuation_(nullptr)
+        , remaining_(nullptr)
+    {
+    }
+
+    /**
+     * Tasks are lazy, they do not start until awaited.
+     */
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    /**
+     * Hand control back to continuation on completion.
+     */
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    /**
+     * Set what should run when the task finishes.
+     *
+     * @param continuation
+     *   Coroutine to resume.
+     *
+     * @param remaining
+     *   Optional count of tasks in a group, continuation is only resumed by the
+     *   task that decrements it to zero.
+     */
+    void set_continuation(std::coroutine_handle<> continuation, std::atomic<std::size_t> *remaining = nullptr)
+    {
+        continuation_ = continuation;
+        remaining_ = remaining;
+    }
+
+  private:
+    /** Coroutine to resume on completion. */
+    std::coroutine_handle<> continuation_;
+
+    /** Count of unfinished tasks in group, nullptr if not in a group. */
+    std::atomic<std::size_t> *remaining_;
+};
+
+/**
+ * Promise for a task producing a value.
+ */
+template <class T>
+class TaskPromise : public TaskPromiseBase
+{
+  public:
+    Task<T> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        result_.template emplace<2u>(std::current_exception());
+    }
+
+    template <class U>
+    void return_value(U &&value)
+    {
+        result_.template emplace<1u>(std::forward<U>(value));
+    }
+
+    /**
+     * Get the result of the task, rethrowing any exception it threw. Can only
+     * be called once.
+     *
+     * @returns
+     *   Task result.
+     */
+    T result()
+    {
+        if (result_.index() == 2u)
+        {
+            std::rethrow_exception(std::get<2u>(result_));
+        }
+
+        expect(result_.index() == 1u, "task has no result");
+
+        return std::move(std::get<1u>(result_));
+    }
+
+  private:
+    /** Result of task, either a value or exception. */
+    std::variant<std::monostate, T, std::exception_ptr> result_;
+};
+
+/**
+ * Promise for a task producing nothing.
+ */
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+  public:
+    Task<void> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        exception_ = std::current_exception();
+    }
+
+    void return_void() const noexcept
+    {
+    }
+
+    /**
+     * Rethrow any exception the task threw.
+     */
+    void result()
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+  private:
+    /** Exception thrown by task, if any. */
+    std::exception_ptr exception_;
+};
+
+}
+
+/**
+ * A lazily started coroutine producing a T. Awaiting a task starts it and
+ * suspends the awaiter until it has finished, exceptions are propagated to the
+ * awaiter.
+ *
+ * Tasks run on whichever thread resumes them, use schedule (see
+ * task_awaitables.h) to move on to a JobSystem. Control is symmetrically
+ * transferred between tasks and there is no platform specific context
+ * switching, so unlike fibers they work everywhere.
+ */
+template <class T = void>
+class Task
+{
+  public:
+    using promise_type = detail::TaskPromise<T>;
+
+    /**
+     * Awaiter for a task, starts the task and resumes the awaiter with its
+     * result.
+     */
+    struct Awaiter
+    {
+        bool await_ready() const noexcept
+        {
+            return !handle || handle.done();
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+        {
+            handle.promise().set_continuation(awaiting);
+            return handle;
+        }
+
+        T await_resume()
+        {
+            expect(static_cast<bool>(handle), "awaiting empty task");
+            return handle.promise().result();
+        }
+
+        /** Task being awaited. */
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    /**
+     * Construct an empty task.
+     */
+    Task()
+        : handle_(nullptr)
+    {
+    }
+
+    /**
+     * Construct a task taking ownership of a coroutine.
+     *
+     * @param handle
+     *   Coroutine to own.
+     */
+    explicit Task(std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+    {
+    }
+
+    ~Task()
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+        }
+    }
+
+    Task(Task &&other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    Task &operator=(Task &&other) noexcept
+    {
+        Task new_task{std::move(other)};
+        std::swap(handle_, new_task.handle_);
+
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    /**
+     * Check if task has finished (or is empty).
+     *
+     * @returns
+     *   True if task is finished, otherwise false.
+     */
+    bool is_ready() const
+    {
+        return !handle_ || handle_.done();
+    }
+
+    /**
+     * Get the underlying coroutine.
+     *
+     * @returns
+     *   Coroutine handle.
+     */
+    std::coroutine_handle<promise_type> handle() const
+    {
+        return handle_;
+    }
+
+    Awaiter operator co_await() const noexcept
+    {
+        return {handle_};
+    }
+
+  private:
+    /** Owned coroutine. */
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail
+{
+
+template <class T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+/**
+ * State shared between sync_wait and the coroutine driving the task.
+ */
+struct SyncWaitState
+{
+    /** Guards done. */
+    std::mutex mutex;
+
+    /** Signalled when done. */
+    std::condition_variable condition;
+
+    /** Flag indicating task has finished. */
+    bool done = false;
+};
+
+/**
+ * Coroutine used to drive a task to completion from a non-coroutine thread.
+ * When it finishes it signals the waiting thread.
+ */
+class SyncWaitDriver
+{
+  public:
+    struct promise_type
+    {
+        template <class... Args>
+        explicit promise_type(SyncWaitState &state, Args &&...)
+            : state(&state)
+        {
+        }
+
+        SyncWaitDriver get_return_object() noexcept
+        {
+            return SyncWaitDriver{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        auto final_suspend() const noexcept
+        {
+            struct Awaiter
+            {
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept
+                {
+                    // notify under the lock so the waiting thread cannot
+                    // return and destroy the state before we are done with it
+                    auto *state = handle.promise().state;
+                    std::unique_lock lock(state->mutex);
+                    state->done = true;
+                    state->condition.notify_one();
+                }
+
+                void await_resume() const noexcept
+                {
+                }
+            };
+
+            return Awaiter{};
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        /** State to signal on completion. */
+        SyncWaitState *state;
+    };
+
+    explicit SyncWaitDriver(std::coroutine_handle<promise_type> handle)
+        : handle_(handle)
+    {
+    }
+
+    ~SyncWaitDriver()
+    {
+        handle_.destroy();
+    }
+
+    SyncWaitDriver(const SyncWaitDriver &) = delete;
+    SyncWaitDriver &operator=(const SyncWaitDriver &) = delete;
+
+    /**
+     * Start the driver and block until it has finished.
+     */
+    void run()
+    {
+        auto *state = handle_.promise().state;
+
+        handle_.resume();
+
+        std::unique_lock lock(state->mutex);
+        state->condition.wait(lock, [state] { return state->done; });
+    }
+
+  private:
+    /** Driver coroutine. */
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Coroutine to await a task and capture its outcome.
+ *
+ * @param state
+ *   State to signal on completion.
+ *
+ * @param task
+ *   Task to await.
+ *
+ * @param result
+ *   Out parameter for the task result (if not void).
+ *
+ * @param exception
+ *   Out parameter for any exception thrown by the task.
+ */
+template <class T, class Result>
+SyncWaitDriver sync_wait_driver(SyncWaitState &state, Task<T> &task, Result &result, std::exception_ptr &exception)
+{
+    try
+    {
+        if constexpr (std::is_void_v<T>)
+        {
+            co_await task;
+        }
+        else
+        {
+            result.emplace(co_await task);
+        }
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+}
+
+}
+
+/**
+ * Run a task to completion, blocking the calling thread until it has finished.
+ * This is how non-coroutine code enters the task world, it must not be called
+ * from a task.
+ *
+ * @param task
+ *   Task to run.
+ *
+ * @returns
+ *   Task result.
+ */
+template <class T>
+T sync_wait(Task<T> task)
+{
+    detail::SyncWaitState state{};
+    std::conditional_t<std::is_void_v<T>, std::monostate, std::optional<T>> result{};
+    std::exception_ptr exception{};
+
+    {
+        auto driver = detail::sync_wait_driver(state, task, result, exception);
+        driver.run();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+
+    if constexpr (!std::is_void_v<T>)
+    {
+        return std::move(*result);
+    }
+}
+
+}
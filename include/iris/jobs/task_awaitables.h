@@ -0,0 +1,366 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "jobs/inplace_job.h"
+#include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_system.h"
+#include "jobs/task.h"
+
+namespace iris
+{
+
+/**
+ * Awaitable that resumes the awaiting coroutine as a job, see schedule.
+ */
+class ScheduleAwaitable
+{
+  public:
+    /**
+     * Construct a new ScheduleAwaitable.
+     *
+     * @param job_system
+     *   Job system to resume on.
+     *
+     * @param priority
+     *   Priority to resume at.
+     */
+    ScheduleAwaitable(JobSystem &job_system, JobPriority priority)
+        : job_system_(job_system)
+        , priority_(priority)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        std::vector<InplaceJob> jobs{};
+        jobs.emplace_back([handle] { handle.resume(); });
+
+        job_system_.add_jobs(std::move(jobs), priority_);
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+  private:
+    /** Job system to resume on. */
+    JobSystem &job_system_;
+
+    /** Priority to resume at. */
+    JobPriority priority_;
+};
+
+/**
+ * Awaitable that runs a collection of jobs and resumes the awaiting coroutine
+ * once they have all finished, see run_jobs.
+ */
+class JobsAwaitable
+{
+  public:
+    /**
+     * Construct a new JobsAwaitable.
+     *
+     * @param job_system
+     *   Job system to run jobs on.
+     *
+     * @param jobs
+     *   Jobs to run.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    JobsAwaitable(JobSystem &job_system, std::vector<InplaceJob> &&jobs, JobPriority priority)
+        : job_system_(job_system)
+        , jobs_(std::move(jobs))
+        , priority_(priority)
+        , remaining_(jobs_.size())
+        , failed_(false)
+        , exception_()
+        , handle_(nullptr)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return jobs_.empty();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        handle_ = handle;
+
+        // wrap each job so the last one to finish resumes us, jobs stay owned
+        // by us so the wrappers are small enough to be stored inline
+        std::vector<InplaceJob> wrappers{};
+        wrappers.reserve(jobs_.size());
+
+        for (auto i = 0u; i < jobs_.size(); ++i)
+        {
+            wrappers.emplace_back(
+                [this, i]
+                {
+                    try
+                    {
+                        jobs_[i]();
+                    }
+                    catch (...)
+                    {
+                        // first come first served
+                        if (!failed_.exchange(true, std::memory_order_relaxed))
+                        {
+                            exception_ = std::current_exception();
+                        }
+                    }
+
+                    if (remaining_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+                    {
+                        handle_.resume();
+                    }
+                });
+        }
+
+        job_system_.add_jobs(std::move(wrappers), priority_);
+    }
+
+    void await_resume()
+    {
+        if (exception_)
+        {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+  private:
+    /** Job system to run jobs on. */
+    JobSystem &job_system_;
+
+    /** Jobs to run. */
+    std::vector<InplaceJob> jobs_;
+
+    /** Priority of jobs. */
+    JobPriority priority_;
+
+    /** Number of unfinished jobs. */
+    std::atomic<std::size_t> remaining_;
+
+    /** Flag indicating a job has thrown. */
+    std::atomic<bool> failed_;
+
+    /** First exception thrown by a job. */
+    std::exception_ptr exception_;
+
+    /** Awaiting coroutine. */
+    std::coroutine_handle<> handle_;
+};
+
+/**
+ * Awaitable that starts a collection of tasks as jobs, so they run in
+ * parallel, and resumes the awaiting coroutine once they have all finished,
+ * see when_all.
+ */
+template <class T>
+class WhenAllAwaitable
+{
+  public:
+    /**
+     * Construct a new WhenAllAwaitable.
+     *
+     * @param job_system
+     *   Job system to start tasks on.
+     *
+     * @param tasks
+     *   Tasks to run, must not have been started.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    WhenAllAwaitable(JobSystem &job_system, std::vector<Task<T>> &tasks, JobPriority priority)
+        : job_system_(job_system)
+        , tasks_(tasks)
+        , priority_(priority)
+        , remaining_(tasks.size() + 1u)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return tasks_.empty();
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        std::vector<InplaceJob> jobs{};
+        jobs.reserve(tasks_.size());
+
+        for (auto &task : tasks_)
+        {
+            task.handle().promise().set_continuation(handle, &remaining_);
+            jobs.emplace_back([child = task.handle()] { child.resume(); });
+        }
+
+        job_system_.add_jobs(std::move(jobs), priority_);
+
+        // we hold an extra count so no task can resume us whilst we are still
+        // in here, if they have all finished already then don't suspend
+        return remaining_.fetch_sub(1u, std::memory_order_acq_rel) != 1u;
+    }
+
+    void await_resume() const noexcept
+    {
+    }
+
+  private:
+    /** Job system to start tasks on. */
+    JobSystem &job_system_;
+
+    /** Tasks to run. */
+    std::vector<Task<T>> &tasks_;
+
+    /** Priority of jobs. */
+    JobPriority priority_;
+
+    /** Number of unfinished tasks, plus one for ourself. */
+    std::atomic<std::size_t> remaining_;
+};
+
+/**
+ * Move the calling coroutine on to a job system, it is suspended and resumed
+ * as a job on one of the workers.
+ *
+ * @param job_system
+ *   Job system to resume on.
+ *
+ * @param priority
+ *   Priority to resume at.
+ *
+ * @returns
+ *   Awaitable.
+ */
+inline ScheduleAwaitable schedule(JobSystem &job_system, JobPriority priority = JobPriority::NORMAL)
+{
+    return {job_system, priority};
+}
+
+/**
+ * Run a collection of jobs, the calling coroutine is suspended (without
+ * blocking its thread) until they have all finished. The first exception
+ * thrown by a job is rethrown.
+ *
+ * @param job_system
+ *   Job system to run jobs on.
+ *
+ * @param jobs
+ *   Jobs to run.
+ *
+ * @param priority
+ *   Priority of jobs.
+ *
+ * @returns
+ *   Awaitable.
+ */
+inline JobsAwaitable run_jobs(
+    JobSystem &job_system,
+    std::vector<InplaceJob> &&jobs,
+    JobPriority priority = JobPriority::NORMAL)
+{
+    return {job_system, std::move(jobs), priority};
+}
+
+/**
+ * Run a collection of jobs, the calling coroutine is suspended (without
+ * blocking its thread) until they have all finished. The first exception
+ * thrown by a job is rethrown.
+ *
+ * @param job_system
+ *   Job system to run jobs on.
+ *
+ * @param jobs
+ *   Jobs to run.
+ *
+ * @param priority
+ *   Priority of jobs.
+ *
+ * @returns
+ *   Awaitable.
+ */
+inline JobsAwaitable run_jobs(
+    JobSystem &job_system,
+    const std::vector<Job> &jobs,
+    JobPriority priority = JobPriority::NORMAL)
+{
+    std::vector<InplaceJob> inplace_jobs{};
+    inplace_jobs.reserve(jobs.size());
+
+    for (const auto &job : jobs)
+    {
+        inplace_jobs.emplace_back(job);
+    }
+
+    return {job_system, std::move(inplace_jobs), priority};
+}
+
+/**
+ * Run a collection of tasks in parallel on a job system.
+ *
+ * @param job_system
+ *   Job system to run tasks on.
+ *
+ * @param tasks
+ *   Tasks to run, must not have been started.
+ *
+ * @param priority
+ *   Priority of jobs.
+ *
+ * @returns
+ *   Task producing the results of all tasks (in the same order), or nothing
+ *   for void tasks. The first (by index) exception thrown is rethrown.
+ */
+template <class T>
+Task<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> when_all(
+    JobSystem &job_system,
+    std::vector<Task<T>> tasks,
+    JobPriority priority = JobPriority::NORMAL)
+{
+    co_await WhenAllAwaitable<T>{job_system, tasks, priority};
+
+    if constexpr (std::is_void_v<T>)
+    {
+        for (auto &task : tasks)
+        {
+            task.handle().promise().result();
+        }
+    }
+    else
+    {
+        std::vector<T> results{};
+        results.reserve(tasks.size());
+
+        for (auto &task : tasks)
+        {
+            results.emplace_back(task.handle().promise().result());
+        }
+
+        co_return results;
+    }
+}
+
+}
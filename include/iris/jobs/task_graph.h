@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "jobs/job.h"
+#include "jobs/job_system_manager.h"
+
+namespace iris
+{
+
+/**
+ * A graph of jobs with dependencies between them. When submitted each job is
+ * scheduled as soon as all the jobs it depends on have finished, nothing
+ * blocks waiting for dependencies.
+ *
+ * A graph can be built once and submitted many times (e.g. once per frame).
+ * Everything needed to run it is allocated whilst building, so resubmitting
+ * does not allocate in the graph itself.
+ */
+class TaskGraph
+{
+  public:
+    /** Handle to a node in the graph. */
+    using Node = std::size_t;
+
+    /**
+     * Construct an empty graph.
+     */
+    TaskGraph();
+
+    ~TaskGraph();
+
+    // disable copy and move, running jobs refer back to the graph
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+    TaskGraph(TaskGraph &&) = delete;
+    TaskGraph &operator=(TaskGraph &&) = delete;
+
+    /**
+     * Add a job to the graph.
+     *
+     * @param job
+     *   Job to add.
+     *
+     * @returns
+     *   Handle to new node.
+     */
+    Node add(Job job);
+
+    /**
+     * Add a dependency, such that one node will not start until another has
+     * finished.
+     *
+     * @param before
+     *   Node which must finish first.
+     *
+     * @param after
+     *   Node which depends on before.
+     */
+    void precede(Node before, Node after);
+
+    /**
+     * Schedule the graph to run. This does not block, use wait or is_complete
+     * to know when the graph has finished. The graph must not be modified or
+     * submitted again until then.
+     *
+     * @param jobs_manager
+     *   Manager to schedule jobs with.
+     */
+    void submit(JobSystemManager &jobs_manager);
+
+    /**
+     * Check if the last submission has finished.
+     *
+     * @returns
+     *   True if all nodes have finished (or graph was never submitted),
+     *   otherwise false.
+     */
+    bool is_complete() const;
+
+    /**
+     * Block the calling thread until the last submission has finished. This
+     * blocks the thread (not just a fiber) so should not be called from
+     * within a job.
+     *
+     * If any job threw an exception the first one is rethrown. Note that jobs
+     * depending on one that threw are still run.
+     */
+    void wait();
+
+  private:
+    /**
+     * Internal node data.
+     */
+    struct NodeData
+    {
+        /** Job to run. */
+        Job job;
+
+        /** Nodes which depend on this. */
+        std::vector<Node> successors;
+
+        /** Number of nodes this depends on. */
+        std::size_t predecessor_count;
+
+        /** Number of dependencies yet to finish in current submission. */
+        std::atomic<std::size_t> pending;
+
+        /** Prebuilt job to submit this node, avoids allocating each run. */
+        std::vector<Job> launch;
+    };
+
+    /**
+     * Run a node and then any successors it makes ready.
+     *
+     * @param node
+     *   Node to run.
+     */
+    void execute(Node node);
+
+    /**
+     * Check graph is acyclic and cache its roots.
+     */
+    void validate();
+
+    /** All nodes, stored as pointers as they contain atomics. */
+    std::vector<std::unique_ptr<NodeData>> nodes_;
+
+    /** Nodes with no dependencies. */
+    std::vector<Node> roots_;
+
+    /** Flag indicating roots_ is out of date. */
+    bool dirty_;
+
+    /** Manager for current submission. */
+    JobSystemManager *jobs_manager_;
+
+    /** Number of nodes yet to finish in current submission. */
+    std::atomic<std::size_t> remaining_;
+
+    /** Lock for completion and exception_. */
+    std::mutex mutex_;
+
+    /** Signalled when a submission completes. */
+    std::condition_variable condition_;
+
+    /** Flag indicating current submission has finished, only set whilst holding mutex_. */
+    std::atomic<bool> complete_;
+
+    /** First exception thrown in current submission. */
+    std::exception_ptr exception_;
+};
+
+}
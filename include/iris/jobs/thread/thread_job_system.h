@@ -6,24 +6,54 @@
 
 #pragma once
 
-#include <atomic>
-#include <memory>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
 #include <vector>
 
+#include "core/thread.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 #include "jobs/job_system.h"
 
 namespace iris
 {
 
 /**
- * Implementation of JobSystem that schedules its jobs using threads.
+ * Implementation of JobSystem that schedules its jobs using a fixed pool of
+ * threads.
+ *
+ * Jobs are placed on a queue and executed by the worker threads. A thread
+ * waiting for jobs to finish does not sleep whilst there is queued work,
+ * instead it helps by executing jobs itself. This means nested waits cannot
+ * starve the pool.
+ *
+ * There is a queue for each JobPriority, tasks are picked as per
+ * priority_order.
  */
 class ThreadJobSystem : public JobSystem
 {
   public:
+    /**
+     * Construct a new ThreadJobSystem with one worker per hardware thread
+     * (less one for the calling thread).
+     */
     ThreadJobSystem();
-    ~ThreadJobSystem() override = default;
+
+    /**
+     * Construct a new ThreadJobSystem.
+     *
+     * @param worker_count
+     *   Number of worker threads to create, zero means one per hardware
+     *   thread (less one for the calling thread).
+     */
+    explicit ThreadJobSystem(std::size_t worker_count);
+
+    ~ThreadJobSystem() override;
 
     /**
      * Add a collection of jobs. Once added these are executed in a
@@ -32,8 +62,24 @@ class ThreadJobSystem : public JobSystem
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    void add_jobs(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added these are executed in a fire-and-forget
+     * manner.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    void add_jobs(const std::vector<Job> &jobs) override;
+    void add_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) override;
 
     /**
      * Add a collection of jobs. Once added this call blocks until all
@@ -41,12 +87,136 @@ class ThreadJobSystem : public JobSystem
      *
      * @param jobs
      *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
+     */
+    void wait_for_jobs(const std::vector<Job> &jobs, JobPriority priority = JobPriority::NORMAL) override;
+
+    /**
+     * Add a collection of move-only jobs, which are moved into the job system
+     * without copying. Once added this call blocks until all jobs have
+     * finished executing.
+     *
+     * @param jobs
+     *   Jobs to execute.
+     *
+     * @param priority
+     *   Priority of jobs.
      */
-    void wait_for_jobs(const std::vector<Job> &jobs) override;
+    void wait_for_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority = JobPriority::NORMAL) override;
 
   private:
+    /**
+     * Tracks a collection of jobs being waited on.
+     */
+    struct WaitGroup
+    {
+        /** Number of jobs yet to finish. */
+        std::size_t remaining;
+
+        /** First exception thrown by a job. */
+        std::exception_ptr exception;
+    };
+
+    /**
+     * A queued job.
+     */
+    struct Task
+    {
+        /** Job to run. */
+        InplaceJob job;
+
+        /** Group job belongs to, nullptr if fire-and-forget. */
+        WaitGroup *group;
+
+        /** Id of task, used for tracing. */
+        std::uint64_t id;
+    };
+
+    /**
+     * Tasks queued at one priority, these are taken from either end. Unlike
+     * std::deque the storage is kept as tasks come and go, so once it has
+     * grown queuing does not allocate.
+     */
+    struct TaskQueue
+    {
+        /** Queued tasks, those before head have already been taken. */
+        std::vector<Task> tasks;
+
+        /** Index of oldest queued task. */
+        std::size_t head = 0u;
+    };
+
+    /**
+     * Add a task to a queue. Must be called whilst holding mutex_.
+     *
+     * @param priority
+     *   Priority of task.
+     *
+     * @param job
+     *   Job to run.
+     *
+     * @param group
+     *   Group task belongs to, nullptr if fire-and-forget.
+     */
+    void push_task(JobPriority priority, InplaceJob &&job, WaitGroup *group);
+
+    /**
+     * Pop and run a task off the queue, updating its group when done.
+     *
+     * @param lock
+     *   Lock on mutex_, must be locked and the queue non-empty. Will be
+     *   unlocked whilst the job runs and locked again on return.
+     *
+     * @param newest
+     *   True to take the most recently queued task rather than the oldest.
+     */
+    void run_task(std::unique_lock<std::mutex> &lock, bool newest = false);
+
+    /**
+     * Wake workers for newly queued tasks then help run tasks until a group
+     * has finished, rethrowing the first exception from the group.
+     *
+     * @param lock
+     *   Lock on mutex_, must be locked. Will be unlocked on return.
+     *
+     * @param group
+     *   Group to wait on.
+     */
+    void wait_for_group(std::unique_lock<std::mutex> &lock, WaitGroup &group);
+
+    /**
+     * Main function for worker threads.
+     *
+     * @param index
+     *   Index of worker.
+     */
+    void job_thread(std::size_t index);
+
+    /** Lock for all below state. */
+    std::mutex mutex_;
+
+    /** Signalled when jobs are queued or a group finishes. */
+    std::condition_variable condition_;
+
+    /** Queued jobs, indexed by priority. */
+    std::array<TaskQueue, job_priority_count> tasks_;
+
+    /** Total number of queued jobs. */
+    std::size_t task_count_;
+
+    /** Number of tasks picked, used to decide which priority to look at first. */
+    std::uint64_t picks_;
+
+    /** Id to give the next task. */
+    std::uint64_t next_task_id_;
+
     /** Flag indicating of system is running. */
-    std::atomic<bool> running_;
+    bool running_;
+
+    /** Worker threads which execute jobs. */
+    std::vector<Thread> workers_;
 };
 
 }
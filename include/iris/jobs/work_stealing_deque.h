@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+/**
+ * A lock-free Chase-Lev work stealing deque.
+ *
+ * A single owning thread pushes and pops from the bottom of the deque (LIFO)
+ * whilst any number of other threads can steal from the top (FIFO). The deque
+ * grows when full, old storage is kept alive until the deque is destroyed as a
+ * stealing thread may still be reading from it.
+ *
+ * Based on "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê et al, 2013).
+ */
+template <class T>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "deque elements must be trivially copyable");
+
+  public:
+    /**
+     * Construct an empty deque.
+     *
+     * @param capacity
+     *   Initial capacity, must be a power of two.
+     */
+    explicit WorkStealingDeque(std::size_t capacity = 1024u)
+        : top_(0)
+        , bottom_(0)
+        , buffer_(nullptr)
+        , buffers_()
+    {
+        expect((capacity != 0u) && ((capacity & (capacity - 1u)) == 0u), "capacity must be a power of two");
+
+        buffers_.emplace_back(std::make_unique<Buffer>(capacity));
+        buffer_ = buffers_.back().get();
+    }
+
+    // disable copy and move
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+    WorkStealingDeque(WorkStealingDeque &&) = delete;
+    WorkStealingDeque &operator=(WorkStealingDeque &&) = delete;
+
+    /**
+     * Check if the deque is empty. This is only a snapshot and may be stale by
+     * the time it is acted upon.
+     *
+     * @returns
+     *   True if deque is empty, else false.
+     */
+    bool empty() const
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_relaxed);
+
+        return bottom <= top;
+    }
+
+    /**
+     * Push an element on to the bottom of the deque. Must only be called by the
+     * owning thread.
+     *
+     * @param element
+     *   Element to push.
+     */
+    void push(T element)
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed);
+        const auto top = top_.load(std::memory_order_acquire);
+        auto *buffer = buffer_.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<std::int64_t>(buffer->capacity) - 1)
+        {
+            buffer = grow(buffer, bottom, top);
+        }
+
+        buffer->put(bottom, element);
+
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Tries to pop the most recently pushed element off the bottom of the
+     * deque. Must only be called by the owning thread.
+     *
+     * @param element
+     *   Reference to store popped element.
+     *
+     * @returns
+     *   True if an element could be popped, false otherwise.
+     */
+    bool try_pop(T &element)
+    {
+        const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        auto *buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto top = top_.load(std::memory_order_relaxed);
+        auto popped = false;
+
+        if (top <= bottom)
+        {
+            element = buffer->get(bottom);
+            popped = true;
+
+            if (top == bottom)
+            {
+                // last element, we have to race any stealing threads for it
+                popped = top_.compare_exchange_strong(
+                    top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return popped;
+    }
+
+    /**
+     * Tries to steal the oldest element off the top of the deque. Can be
+     * called by any thread.
+     *
+     * @param element
+     *   Reference to store stolen element.
+     *
+     * @returns
+     *   True if an element could be stolen, false if the deque was empty or
+     *   another thread won the race for the element.
+     */
+    bool try_steal(T &element)
+    {
+        auto top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = bottom_.load(std::memory_order_acquire);
+
+        auto stolen = false;
+
+        if (top < bottom)
+        {
+            auto *buffer = buffer_.load(std::memory_order_acquire);
+            const auto value = buffer->get(top);
+
+            if (top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                element = value;
+                stolen = true;
+            }
+        }
+
+        return stolen;
+    }
+
+  private:
+    /**
+     * Circular storage for deque elements.
+     */
+    struct Buffer
+    {
+        /**
+         * Construct a new Buffer.
+         *
+         * @param capacity
+         *   Number of elements, must be a power of two.
+         */
+        explicit Buffer(std::size_t capacity)
+            : capacity(capacity)
+            , mask(capacity - 1u)
+            , elements(std::make_unique<std::atomic<T>[]>(capacity))
+        {
+        }
+
+        /**
+         * Get element at index.
+         *
+         * @param index
+         *   Index of element, will be wrapped to capacity.
+         *
+         * @returns
+         *   Element at index.
+         */
+        T get(std::int64_t index) const
+        {
+            return elements[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Set element at index.
+         *
+         * @param index
+         *   Index of element, will be wrapped to capacity.
+         *
+         * @param element
+         *   Element to set.
+         */
+        void put(std::int64_t index, T element)
+        {
+            elements[static_cast<std::size_t>(index) & mask].store(element, std::memory_order_relaxed);
+        }
+
+        /** Number of elements in buffer. */
+        std::size_t capacity;
+
+        /** Mask to wrap indices. */
+        std::size_t mask;
+
+        /** Element storage. */
+        std::unique_ptr<std::atomic<T>[]> elements;
+    };
+
+    /**
+     * Replace the current buffer with one twice the size.
+     *
+     * @param buffer
+     *   Current buffer.
+     *
+     * @param bottom
+     *   Current bottom index.
+     *
+     * @param top
+     *   Current top index.
+     *
+     * @returns
+     *   New buffer.
+     */
+    Buffer *grow(Buffer *buffer, std::int64_t bottom, std::int64_t top)
+    {
+        auto new_buffer = std::make_unique<Buffer>(buffer->capacity * 2u);
+
+        for (auto i = top; i < bottom; ++i)
+        {
+            new_buffer->put(i, buffer->get(i));
+        }
+
+        buffers_.emplace_back(std::move(new_buffer));
+        buffer_.store(buffers_.back().get(), std::memory_order_release);
+
+        return buffers_.back().get();
+    }
+
+    /** Index of next element to steal. */
+    alignas(64) std::atomic<std::int64_t> top_;
+
+    /** Index one past the most recently pushed element. */
+    alignas(64) std::atomic<std::int64_t> bottom_;
+
+    /** Current buffer. */
+    std::atomic<Buffer *> buffer_;
+
+    /** All buffers ever allocated, only accessed by owning thread. */
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+}
@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/cpu_topology.h"
+
+namespace iris
+{
+
+/**
+ * Policy for placing job system workers on cpus.
+ */
+struct WorkerPlacement
+{
+    /** Pin each worker to a logical cpu, if false workers are left to the scheduler. */
+    bool pin_workers = false;
+
+    /** Also use the secondary hardware threads of each core, by default there is one worker per physical core. */
+    bool use_smt_siblings = false;
+
+    /** Logical cpus to keep free e.g. for the main or network threads, the whole core they are on is kept free. */
+    std::vector<std::size_t> reserved_cpus = {};
+};
+
+/**
+ * Where a single worker should run.
+ */
+struct WorkerSlot
+{
+    /** Logical cpu to pin to. */
+    std::size_t cpu;
+
+    /** NUMA node of cpu. */
+    std::size_t node;
+};
+
+/**
+ * Pick the cpus workers should run on. Slots are grouped by node, so workers
+ * with adjacent indices share a node, and primary hardware threads come before
+ * their siblings.
+ *
+ * @param topology
+ *   Topology to place workers on.
+ *
+ * @param placement
+ *   Placement policy.
+ *
+ * @returns
+ *   One slot per usable cpu, never empty.
+ */
+std::vector<WorkerSlot> place_workers(const CpuTopology &topology, const WorkerPlacement &placement);
+
+}
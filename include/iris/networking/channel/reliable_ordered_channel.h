@@ -6,11 +6,14 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <vector>
 
 #include "networking/channel/channel.h"
+#include "networking/packet.h"
 #include "networking/socket.h"
 
 namespace iris
@@ -29,10 +32,32 @@ namespace iris
  * e.g.
  *  received packets : 1, 1, 3, 2, 1, 5, 4
  *  yielded packets  : 1, 2, 3, 4, 5
+ *
+ * It is also the only channel which accepts packets larger than
+ * Packet::max_size. These are split in to fragments, each sent as its own
+ * packet, and reassembled once all fragments have been received.
+ *
+ * Sent packets go through a sliding window of at most window_size packets.
+ * A packet is only yielded again if it has not been acked within the
+ * retransmission timeout, which is derived from the smoothed round trip time
+ * and its variance (as TCP does) and backs off each time the packet is resent.
+ *
+ * Received packets are buffered in a fixed size ring, indexed by sequence
+ * number, until they can be yielded in order. Sequence numbers are compared
+ * with serial number arithmetic so the channel keeps working after they wrap.
+ *
+ * They are acked with a single ACK packet per yield, its sequence
+ * is the most recently received packet and its body a 32 bit field where bit n
+ * is set if the packet n + 1 before it has been received. As the window is no
+ * larger than the field every packet in flight is covered by each ack, so a
+ * lost ack is repaired by the next one.
  */
 class ReliableOrderedChannel : public Channel
 {
   public:
+    /** Maximum number of unacked packets in flight. */
+    static constexpr std::size_t window_size = 32u;
+
     /**
      * Construct a new ReliableOrderedChannel.
      */
@@ -57,6 +82,17 @@ class ReliableOrderedChannel : public Channel
      */
     void enqueue_receive(Packet packet) override;
 
+    /**
+     * Enqueue a received packet.
+     *
+     * @param packet
+     *   Packet received.
+     *
+     * @param now
+     *   Current time, used to measure round trip time.
+     */
+    void enqueue_receive(Packet packet, std::chrono::steady_clock::time_point now);
+
     /**
      * Yield all packets to be sent, according to the channel guarantees.
      *
@@ -65,6 +101,17 @@ class ReliableOrderedChannel : public Channel
      */
     std::vector<Packet> yield_send_queue() override;
 
+    /**
+     * Yield all packets to be sent, according to the channel guarantees.
+     *
+     * @param now
+     *   Current time, used to decide which packets need resending.
+     *
+     * @returns
+     *   Packets to be send.
+     */
+    std::vector<Packet> yield_send_queue(std::chrono::steady_clock::time_point now);
+
     /**
      * Yield all packets that have been received, according to the channel
      * guarantees.
@@ -74,12 +121,112 @@ class ReliableOrderedChannel : public Channel
      */
     std::vector<Packet> yield_receive_queue() override;
 
+    /**
+     * Get the smoothed round trip time.
+     *
+     * @returns
+     *   Smoothed round trip time, zero if no packets have been acked.
+     */
+    std::chrono::microseconds rtt() const;
+
+    /**
+     * Get the current retransmission timeout, the time a packet waits for an
+     * ack before its first resend.
+     *
+     * @returns
+     *   Retransmission timeout.
+     */
+    std::chrono::microseconds rto() const;
+
   private:
+    /**
+     * A sent packet waiting for an ack.
+     */
+    struct InFlight
+    {
+        /** Packet to send. */
+        Packet packet;
+
+        /** When the packet was last sent. */
+        std::chrono::steady_clock::time_point sent;
+
+        /** Number of times the packet has been sent. */
+        std::uint32_t sends;
+
+        /** Whether the packet has been acked. */
+        bool acked;
+    };
+
+    /**
+     * Handle an ack for a single packet.
+     *
+     * @param sequence
+     *   Sequence number of acked packet.
+     *
+     * @param now
+     *   Current time.
+     */
+    void ack(std::uint16_t sequence, std::chrono::steady_clock::time_point now);
+
+    /**
+     * Check if a packet has been received.
+     *
+     * @param sequence
+     *   Sequence number of packet.
+     *
+     * @returns
+     *   True if packet has been received, otherwise false.
+     */
+    bool received(std::uint16_t sequence) const;
+
+    /**
+     * Get the slot in the receive ring for a sequence number.
+     *
+     * @param sequence
+     *   Sequence number of packet.
+     *
+     * @returns
+     *   Slot for packet, invalid if it has not been received.
+     */
+    Packet &slot(std::size_t sequence);
+
+    /**
+     * Get the slot in the receive ring for a sequence number.
+     *
+     * @param sequence
+     *   Sequence number of packet.
+     *
+     * @returns
+     *   Slot for packet, invalid if it has not been received.
+     */
+    const Packet &slot(std::size_t sequence) const;
+
+    /** Packets waiting for an ack, the front is the oldest. */
+    std::deque<InFlight> send_window_;
+
     /** The expected sequence number of the next packet. */
     std::uint16_t next_receive_seq_;
 
+    /** Number of received packets that have been yielded. */
+    std::size_t yielded_count_;
+
     /** The sequence number for the next sent packet. */
     std::uint16_t out_sequence_;
+
+    /** The most recently received sequence number. */
+    std::uint16_t latest_receive_seq_;
+
+    /** Whether packets have been received since the last ack was sent. */
+    bool ack_pending_;
+
+    /** Smoothed round trip time. */
+    std::chrono::microseconds srtt_;
+
+    /** Round trip time variance. */
+    std::chrono::microseconds rttvar_;
+
+    /** Retransmission timeout. */
+    std::chrono::microseconds rto_;
 };
 
 }
@@ -40,7 +40,7 @@ class UnreliableSequencedChannel : public Channel
      * Enqueue a packet to be sent.
      *
      * @param packet
-     *   Packet to be sent.
+     *   Packet to be sent, must be no larger than Packet::max_size.
      */
     void enqueue_send(Packet packet) override;
 
@@ -7,14 +7,19 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "core/data_buffer.h"
-#include "jobs/concurrent_queue.h"
+#include "jobs/service_thread.h"
+#include "jobs/spsc_queue.h"
 #include "networking/channel/channel.h"
+#include "networking/packet.h"
+#include "networking/packet_coalescer.h"
 #include "networking/socket.h"
 
 namespace iris
@@ -43,8 +48,17 @@ class ClientConnectionHandler
      */
     explicit ClientConnectionHandler(std::unique_ptr<Socket> socket);
 
+    // defined in implementation
+    ~ClientConnectionHandler();
+
+    // deleted
+    ClientConnectionHandler(const ClientConnectionHandler &) = delete;
+    ClientConnectionHandler &operator=(const ClientConnectionHandler &) = delete;
+
     /**
-     * Try and read data from the supplied channel.
+     * Try and read data from the supplied channel. Each channel must only be
+     * read from one thread at a time. Throws if the thread reading from the
+     * socket has stopped.
      *
      * @param channel_type
      *   Channel to read from.
@@ -55,7 +69,9 @@ class ClientConnectionHandler
     std::optional<DataBuffer> try_read(ChannelType channel_type);
 
     /**
-     * Send data to the server on the supplied channel.
+     * Queue data to send to the server on the supplied channel, it will be
+     * written on the next call to flush() or once more than a datagram's
+     * worth is queued.
      *
      * @param data
      *   Data to send.
@@ -65,6 +81,13 @@ class ClientConnectionHandler
      */
     void send(const DataBuffer &data, ChannelType channel_type);
 
+    /**
+     * Send everything queued on all channels, along with any acks, coalesced
+     * in to as few datagrams as possible. This should be called regularly
+     * (e.g. once a frame).
+     *
+     * Throws if the thread reading from the socket has stopped.
+     */
     void flush();
 
     /**
@@ -86,6 +109,23 @@ class ClientConnectionHandler
     std::chrono::milliseconds lag() const;
 
   private:
+    /**
+     * Handle a packet read from the socket, called from the reader thread.
+     *
+     * @param packet
+     *   Packet read from the socket.
+     *
+     * @param token
+     *   Stop token of the reader thread.
+     */
+    void handle_packet(Packet packet, const StopToken &token);
+
+    /**
+     * Write everything queued on all channels. Must be called whilst holding
+     * mutex_.
+     */
+    void write_pending();
+
     /** Underlying socket. */
     std::unique_ptr<Socket> socket_;
 
@@ -98,8 +138,20 @@ class ClientConnectionHandler
     /** Map of channel types to channel objects. */
     std::map<ChannelType, std::unique_ptr<Channel>> channels_;
 
-    /** Map of channel types to message queues. */
-    std::map<ChannelType, std::unique_ptr<ConcurrentQueue<DataBuffer>>> queues_;
+    /** Map of channel types to message queues, filled by the reader thread. */
+    std::map<ChannelType, std::unique_ptr<SpscQueue<DataBuffer>>> queues_;
+
+    /** Coalescer for flushing, kept to reuse its storage. */
+    PacketCoalescer coalescer_;
+
+    /** Size of data queued with send since the last flush. */
+    std::size_t pending_bytes_;
+
+    /** Guards channels, which are used by both the caller and reader thread. */
+    std::mutex mutex_;
+
+    /** Thread reading from socket, must be last so it stops first. */
+    std::unique_ptr<ServiceThread> reader_;
 };
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
@@ -49,7 +50,7 @@ class DataBufferDeserialiser
     T pop()
     {
         const auto size = sizeof(T);
-        if (size > std::distance(cursor_, std::cend(buffer_)))
+        if (static_cast<std::ptrdiff_t>(size) > std::distance(cursor_, std::cend(buffer_)))
         {
             throw Exception("not enough data left");
         }
@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+#include "networking/socket.h"
+
+namespace iris
+{
+
+/**
+ * Struct for a single datagram in a batched ServerSocket write. This does not
+ * own the data, it must stay alive until the write returns.
+ */
+struct Datagram
+{
+    /** Client to send to, must have come from the ServerSocket being written to. */
+    Socket *client;
+
+    /** Pointer to bytes to write. */
+    const std::byte *data;
+
+    /** Amount of bytes to write. */
+    std::size_t size;
+};
+
+}
@@ -10,6 +10,7 @@
 // several utility functions
 // it should suffice to just include this file to use BSD socket functions
 
+#include <chrono>
 #include <functional>
 
 #if defined(IRIS_PLATFORM_WIN32)
@@ -25,6 +26,7 @@ static iris::Winsock ws_init;
 #include <netdb.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <sys/types.h>
 #include <unistd.h>
 #endif
@@ -71,6 +73,38 @@ inline bool last_call_blocked()
     return ::WSAGetLastError() == WSAEWOULDBLOCK;
 }
 
+/**
+ * Set how long a blocking read on a socket should wait for data.
+ *
+ * @param socket
+ *   Handle to socket to change.
+ *
+ * @param timeout
+ *   Time to wait, zero means wait forever.
+ */
+inline void set_receive_timeout(SocketHandle socket, std::chrono::milliseconds timeout)
+{
+    const auto value = static_cast<DWORD>(timeout.count());
+    if (::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&value), sizeof(value)) != 0)
+    {
+        throw Exception("could not set receive timeout");
+    }
+}
+
+/**
+ * Check if the last read call timed out.
+ *
+ * Note this is function is only valid following a read on a blocking socket
+ * with a receive timeout.
+ *
+ * @returns
+ *   True if read timed out, false otherwise.
+ */
+inline bool last_call_timed_out()
+{
+    return ::WSAGetLastError() == WSAETIMEDOUT;
+}
+
 #else
 
 using SocketHandle = int;
@@ -116,6 +150,41 @@ inline bool last_call_blocked()
 {
     return errno == EWOULDBLOCK;
 }
+
+/**
+ * Set how long a blocking read on a socket should wait for data.
+ *
+ * @param socket
+ *   Handle to socket to change.
+ *
+ * @param timeout
+ *   Time to wait, zero means wait forever.
+ */
+inline void set_receive_timeout(SocketHandle socket, std::chrono::milliseconds timeout)
+{
+    struct timeval value = {0};
+    value.tv_sec = static_cast<decltype(value.tv_sec)>(timeout.count() / 1000);
+    value.tv_usec = static_cast<decltype(value.tv_usec)>((timeout.count() % 1000) * 1000);
+
+    if (::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &value, sizeof(value)) != 0)
+    {
+        throw Exception("could not set receive timeout");
+    }
+}
+
+/**
+ * Check if the last read call timed out.
+ *
+ * Note this is function is only valid following a read on a blocking socket
+ * with a receive timeout.
+ *
+ * @returns
+ *   True if read timed out, false otherwise.
+ */
+inline bool last_call_timed_out()
+{
+    return (errno == EAGAIN) || (errno == EWOULDBLOCK);
+}
 #endif
 
 }
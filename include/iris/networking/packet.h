@@ -9,12 +9,19 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <ostream>
 
 #include "core/data_buffer.h"
 #include "networking/channel/channel_type.h"
 #include "networking/packet_type.h"
 
+// largest packet, in bytes, that will be sent (see the cmake option of the
+// same name)
+#if !defined(IRIS_NETWORKING_MTU)
+#define IRIS_NETWORKING_MTU 1200
+#endif
+
 namespace iris
 {
 
@@ -25,32 +32,51 @@ namespace iris
  * packets directly, but rather use other constructs in the engine to send their
  * own game-specific protocol.
  *
- * The Packet consists of a header then a fixed body buffer, which can contain
- * arbitrary data (may be smaller than the buffer size).
+ * The Packet consists of a header then a variable sized body, which can
+ * contain arbitrary data. The header records the size of the body, so a packet
+ * can be parsed out of a buffer with trailing data.
  *
  *                               +----------+ -.
  *                               |   type   |  |
  *                               +----------+  |
- *                               | channel  |  |- header
+ *                               | channel  |  |
  *                               +----------+  |
  *                               | sequence |  |
- *                            .- +----------+ -'
- *                            |  |          |
- *                            |  |          |
- *                            |  |          |
- *                            |  |   body   |
- *                            |  |          |
- *               body buffer -|  |          |
- *                            |  |          |
- *                            |  |~~~~~~~~~~|- body size
- *                            |  |          |
- *                            |  |          |
- *                            |  |          |
- *                            '- +----------+
+ *                               +----------+  |- header
+ *                               |   size   |  |
+ *                               +----------+  |
+ *                               | fragment |  |
+ *                               +----------+  |
+ *                               |  count   |  |
+ *                               +----------+ -'
+ *                               |          |
+ *                               |   body   |
+ *                               |          |
+ *                               +----------+
+ *
+ * Only packets of at most max_size bytes can be sent, this is kept below the
+ * path MTU so IP never has to fragment a datagram. Larger messages can be
+ * constructed but must be split in to fragments (see ReliableOrderedChannel),
+ * each fragment records its index and the number of fragments in the message.
  */
 class Packet
 {
   public:
+    /** Size of the packet header. */
+    static constexpr std::size_t header_size = 8u;
+
+    /** Largest packet (header and body) that can be sent. */
+    static constexpr std::size_t max_size = IRIS_NETWORKING_MTU;
+
+    /** Largest body that can be sent in a single packet. */
+    static constexpr std::size_t max_body_size = max_size - header_size;
+
+    /** Largest body a packet can be constructed with, before fragmenting. */
+    static constexpr std::size_t max_message_size = std::numeric_limits<std::uint16_t>::max();
+
+    /** Most fragments a single message can be split in to. */
+    static constexpr std::size_t max_fragments = (max_message_size + max_body_size - 1u) / max_body_size;
+
     /**
      * Construct an invalid Packet. All methods on an invalid packet should
      * be considered undefined except:
@@ -69,18 +95,38 @@ class Packet
      *   The channel the packet should be sent on.
      *
      * @param body
-     *   The data of the packet, may be empty.
+     *   The data of the packet, may be empty and may be larger than
+     *   max_body_size if the packet will be fragmented.
      */
     Packet(PacketType type, ChannelType channel, const DataBuffer &body);
 
     /**
-     * Construct a new Packet from raw data.
+     * Construct a new Packet from raw data. Any data after the body is
+     * ignored, if the data is too small for the header, or the body size in
+     * the header, the Packet is invalid. As is a body larger than
+     * max_body_size, an unknown type or channel, or a fragment index outside
+     * of a fragment count in [1, max_fragments].
      *
      * @param raw_data
      *   Raw Packet data
      */
     explicit Packet(const DataBuffer &raw_packet);
 
+    /**
+     * Construct a new Packet from raw data. Any data after the body is
+     * ignored, if the data is too small for the header, or the body size in
+     * the header, the Packet is invalid. As is a body larger than
+     * max_body_size, an unknown type or channel, or a fragment index outside
+     * of a fragment count in [1, max_fragments].
+     *
+     * @param raw_packet
+     *   Pointer to raw Packet data.
+     *
+     * @param size
+     *   Size of raw data.
+     */
+    Packet(const std::byte *raw_packet, std::size_t size);
+
     /**
      * Get a pointer to the start of the packet.
      *
@@ -124,16 +170,13 @@ class Packet
     /**
      * Get the size of the packet i.e. sizeof(header) + sizeof(body).
      *
-     * Note this may be less than sizeof(Packet) if the body buffer is not
-     * full.
-     *
      * @returns
-     *   Size of Packet that is filled.
+     *   Size of Packet.
      */
     std::size_t packet_size() const;
 
     /**
-     * Get the size of the body i.e. how much of the body buffer is filled.
+     * Get the size of the body.
      *
      * @returns
      *   Size of body.
@@ -180,6 +223,34 @@ class Packet
      */
     void set_sequence(std::uint16_t sequence);
 
+    /**
+     * Get the index of this packet in a fragmented message.
+     *
+     * @returns
+     *   Fragment index, 0 if the packet is not a fragment.
+     */
+    std::uint8_t fragment() const;
+
+    /**
+     * Get the number of fragments the message this packet is part of was
+     * split in to.
+     *
+     * @returns
+     *   Number of fragments, 1 if the packet is not a fragment.
+     */
+    std::uint8_t fragment_count() const;
+
+    /**
+     * Mark the packet as a fragment of a larger message.
+     *
+     * @param fragment
+     *   Index of this packet in the message.
+     *
+     * @param count
+     *   Number of fragments in the message.
+     */
+    void set_fragment(std::uint8_t fragment, std::uint8_t count);
+
     /**
      * Equality operator.
      *
@@ -230,14 +301,18 @@ class Packet
          *
          * @param channel
          *   Channel type.
+         *
+         * @param size
+         *   Size of body.
          */
-        Header(PacketType type, ChannelType channel)
+        Header(PacketType type, ChannelType channel, std::uint16_t size)
             : type(type)
             , channel(channel)
             , sequence(0u)
+            , size(size)
+            , fragment(0u)
+            , fragment_count(1u)
         {
-            // check the header has no padding
-            static_assert(sizeof(Header) == sizeof(type) + sizeof(channel) + sizeof(sequence), "header has padding");
         }
 
         /** Type of packet. */
@@ -248,19 +323,35 @@ class Packet
 
         /** Sequence number. */
         std::uint16_t sequence;
-    };
 
-    /** Packet header. */
-    Header header_;
+        /** Size of body. */
+        std::uint16_t size;
 
-    /** Packet body buffer. */
-    std::byte body_[128 - sizeof(Header)];
+        /** Index of fragment. */
+        std::uint8_t fragment;
 
-    // anything after here should be considered local bookkeeping and will
-    // not be transmitted when a Packet is sent.
+        /** Number of fragments in message. */
+        std::uint8_t fragment_count;
+    };
+
+    /**
+     * Get the packet header.
+     *
+     * @returns
+     *   Reference to header at the start of the buffer.
+     */
+    const Header &header() const;
+
+    /**
+     * Get the packet header.
+     *
+     * @returns
+     *   Reference to header at the start of the buffer.
+     */
+    Header &header();
 
-    /** Size of body buffer used. */
-    std::size_t size_;
+    /** Raw packet, header followed by body. */
+    DataBuffer buffer_;
 };
 
 }
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "core/data_buffer.h"
+#include "networking/packet.h"
+
+namespace iris
+{
+
+/**
+ * Class which packs packets in to as few datagrams as possible, each no larger
+ * than Packet::max_size. Packets are written back to back and as each header
+ * records its body size a datagram can be split back in to packets on
+ * receipt.
+ *
+ *     +--------+------+--------+------+--------+------+
+ *     | header | body | header | body | header | body |
+ *     +--------+------+--------+------+--------+------+
+ *
+ * Packets are never reordered or split across datagrams. Clearing the
+ * coalescer keeps the datagram buffers, so once warmed up it doesn't allocate.
+ */
+class PacketCoalescer
+{
+  public:
+    /**
+     * Construct an empty PacketCoalescer.
+     */
+    PacketCoalescer();
+
+    /**
+     * Add a packet, starting a new datagram if it does not fit in the current
+     * one.
+     *
+     * @param packet
+     *   Packet to add, must be no larger than Packet::max_size.
+     */
+    void add(const Packet &packet);
+
+    /**
+     * Add a collection of packets.
+     *
+     * @param packets
+     *   Packets to add.
+     */
+    void add(const std::vector<Packet> &packets);
+
+    /**
+     * Check if any packets have been added since the last clear.
+     *
+     * @returns
+     *   True if there are no datagrams, otherwise false.
+     */
+    bool empty() const;
+
+    /**
+     * Get the number of datagrams.
+     *
+     * @returns
+     *   Number of datagrams.
+     */
+    std::size_t size() const;
+
+    /**
+     * Get a datagram.
+     *
+     * @param index
+     *   Index of datagram, must be less than size().
+     *
+     * @returns
+     *   Datagram at index.
+     */
+    const DataBuffer &operator[](std::size_t index) const;
+
+    /**
+     * Remove all datagrams.
+     */
+    void clear();
+
+    /**
+     * Split a received datagram back in to packets. Parsing stops at the first
+     * invalid packet.
+     *
+     * @param datagram
+     *   Datagram to split.
+     *
+     * @returns
+     *   Packets in datagram.
+     */
+    static std::vector<Packet> split(const DataBuffer &datagram);
+
+  private:
+    /** Datagram buffers, only the first count are in use. */
+    std::vector<DataBuffer> datagrams_;
+
+    /** Number of datagrams in use. */
+    std::size_t count_;
+};
+
+}
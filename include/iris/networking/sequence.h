@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace iris
+{
+
+/**
+ * Compare two packet sequence numbers, allowing for wraparound (RFC 1982
+ * serial number arithmetic). A sequence number is considered to be after
+ * another if it is ahead by less than half the sequence space, so 0 comes
+ * after 65535. Numbers exactly half the space apart are unordered.
+ *
+ * @param a
+ *   First sequence number.
+ *
+ * @param b
+ *   Second sequence number.
+ *
+ * @returns
+ *   True if a comes after b, otherwise false.
+ */
+constexpr bool sequence_greater_than(std::uint16_t a, std::uint16_t b)
+{
+    const auto distance = static_cast<std::uint16_t>(a - b);
+    return (distance != 0u) && (distance < 32768u);
+}
+
+/**
+ * Compare two packet sequence numbers, allowing for wraparound.
+ *
+ * @param a
+ *   First sequence number.
+ *
+ * @param b
+ *   Second sequence number.
+ *
+ * @returns
+ *   True if a comes before b, otherwise false.
+ */
+constexpr bool sequence_less_than(std::uint16_t a, std::uint16_t b)
+{
+    return sequence_greater_than(b, a);
+}
+
+}
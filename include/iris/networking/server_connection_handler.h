@@ -12,11 +12,14 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "core/data_buffer.h"
+#include "jobs/service_thread.h"
 #include "networking/channel/channel.h"
 #include "networking/channel/channel_type.h"
 #include "networking/server_socket.h"
+#include "networking/server_socket_data.h"
 
 namespace iris
 {
@@ -116,11 +119,19 @@ class ServerConnectionHandler
     /**
      * Updates the connection handler, processes all messages and fires all
      * callbacks. This should be called regularly (e.g. from a game loop)
+     *
+     * Everything queued with send() since the last update, along with any
+     * acks, is coalesced in to as few datagrams as possible per connection
+     * and written here as a single batch.
+     *
+     * Throws if the thread reading from the socket has stopped.
      */
     void update();
 
     /**
-     * Send data to a connection.
+     * Queue data to send to a connection, it will be written on the next call
+     * to update() or once more than a datagram's worth is queued for the
+     * connection. This must be called from the same thread as update().
      *
      * @param id
      *   Id of connection to send data to.
@@ -134,8 +145,29 @@ class ServerConnectionHandler
     void send(std::size_t id, const DataBuffer &message, ChannelType channel_type);
 
   private:
-    // forward declare internal struct
+    // forward declare internal structs
     struct Connection;
+    struct SendBatch;
+
+    /**
+     * Handle a datagram read from the socket, called from the reader thread.
+     *
+     * @param data
+     *   Data read from the socket.
+     *
+     * @param responses
+     *   Batch to add any packets that need to be sent in response to.
+     */
+    void handle_data(const ServerSocketData &data, SendBatch &responses);
+
+    /**
+     * Add all packets queued for a connection to the send batch. Must be
+     * called whilst holding the mutex.
+     *
+     * @param connection
+     *   Connection to collect packets from.
+     */
+    void collect_pending(Connection &connection);
 
     /** Underlying socket. */
     std::unique_ptr<ServerSocket> socket_;
@@ -157,6 +189,12 @@ class ServerConnectionHandler
 
     /** Collection of messages. */
     std::vector<DataBuffer> messages_;
+
+    /** Packets to write on update, kept to reuse its storage. */
+    std::unique_ptr<SendBatch> send_batch_;
+
+    /** Thread reading from socket, must be last so it stops first. */
+    ServiceThread reader_;
 };
 
 }
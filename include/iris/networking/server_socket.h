@@ -6,6 +6,12 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "networking/datagram.h"
 #include "networking/server_socket_data.h"
 
 namespace iris
@@ -30,6 +36,49 @@ class ServerSocket
      *    A ServerSocketData for the read client and data.
      */
     virtual ServerSocketData read() = 0;
+
+    /**
+     * Wait for data, blocking for at most timeout.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @returns
+     *    A ServerSocketData for the read client and data if any was read,
+     *    otherwise empty optional.
+     */
+    virtual std::optional<ServerSocketData> read(std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * Wait for data, blocking for at most timeout, then read as many
+     * datagrams as are immediately available.
+     *
+     * The batch is only ever grown, so reusing the same collection across
+     * calls lets an implementation avoid allocating. Only the first returned
+     * count elements are valid.
+     *
+     * The default implementation reads a single datagram.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @param batch
+     *   Collection to write read data to.
+     *
+     * @returns
+     *   Number of datagrams read, zero if the read timed out.
+     */
+    virtual std::size_t read_batch(std::chrono::milliseconds timeout, std::vector<ServerSocketData> &batch);
+
+    /**
+     * Write a collection of datagrams, possibly to different clients.
+     *
+     * The default implementation writes each datagram to its client socket.
+     *
+     * @param datagrams
+     *   Datagrams to write.
+     */
+    virtual void write_batch(const std::vector<Datagram> &datagrams);
 };
 
 }
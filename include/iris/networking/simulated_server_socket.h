@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <optional>
 #include <string>
 
 #include "networking/server_socket.h"
@@ -61,6 +62,18 @@ class SimulatedServerSocket : public ServerSocket
      */
     ServerSocketData read() override;
 
+    /**
+     * Wait for data, blocking for at most timeout.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @returns
+     *    A ServerSocketData for the read client and data if any was read,
+     *    otherwise empty optional.
+     */
+    std::optional<ServerSocketData> read(std::chrono::milliseconds timeout) override;
+
   private:
     /** Underlying socket. */
     ServerSocket *socket_;
@@ -10,7 +10,8 @@
 #include <cstddef>
 #include <optional>
 
-#include "jobs/concurrent_queue.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/service_thread.h"
 #include "networking/socket.h"
 
 namespace iris
@@ -74,6 +75,21 @@ class SimulatedSocket : public Socket
      */
     DataBuffer read(std::size_t count) override;
 
+    /**
+     * Block and read up to count bytes, waiting at most timeout. May return
+     * less.
+     *
+     * @param count
+     *   Maximum number of bytes to read.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @returns
+     *   DataBuffer of bytes if read succeeded, otherwise empty optional.
+     */
+    std::optional<DataBuffer> read(std::size_t count, std::chrono::milliseconds timeout) override;
+
     /**
      * Write DataBuffer to socket.
      *
@@ -107,7 +123,10 @@ class SimulatedSocket : public Socket
     Socket *socket_;
 
     /** Queue of data to send and when. */
-    ConcurrentQueue<std::tuple<DataBuffer, std::chrono::steady_clock::time_point>> write_queue_;
+    MpmcQueue<std::tuple<DataBuffer, std::chrono::steady_clock::time_point>> write_queue_;
+
+    /** Thread which sends queued data once its delay has passed, must be last so it stops first. */
+    ServiceThread writer_;
 };
 
 }
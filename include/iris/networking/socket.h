@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <optional>
 
@@ -55,6 +56,21 @@ class Socket
      */
     virtual DataBuffer read(std::size_t count) = 0;
 
+    /**
+     * Read count bytes, blocking for at most timeout. This allows a reader to
+     * periodically check if it should stop.
+     *
+     * @param count
+     *   Amount of bytes to read.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @returns
+     *   DataBuffer of bytes if read succeeded, otherwise empty optional.
+     */
+    virtual std::optional<DataBuffer> read(std::size_t count, std::chrono::milliseconds timeout) = 0;
+
     /**
      * Write DataBuffer to socket.
      *
@@ -6,15 +6,23 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "core/auto_release.h"
+#include "networking/datagram.h"
 #include "networking/networking.h"
 #include "networking/server_socket.h"
 #include "networking/server_socket_data.h"
+#include "networking/udp_socket.h"
 
 namespace iris
 {
@@ -32,6 +40,10 @@ namespace iris
  * from one could potentially interfere with the other. Best practice is to
  * only every read from the UdpServerSocket and write back with the returned
  * client Socket.
+ *
+ * On Linux batched reads and writes use recvmmsg/sendmmsg, so a whole batch
+ * costs a single syscall. Buffers for the batches are allocated up front and
+ * reused. Other platforms fall back to a syscall per datagram.
  */
 class UdpServerSocket : public ServerSocket
 {
@@ -50,7 +62,8 @@ class UdpServerSocket : public ServerSocket
     UdpServerSocket(const UdpServerSocket &) = delete;
     UdpServerSocket &operator=(const UdpServerSocket &) = delete;
 
-    ~UdpServerSocket() override = default;
+    // defined in implementation
+    ~UdpServerSocket() override;
 
     /**
      * Block and wait for data.
@@ -60,12 +73,84 @@ class UdpServerSocket : public ServerSocket
      */
     ServerSocketData read() override;
 
+    /**
+     * Wait for data, blocking for at most timeout.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @returns
+     *    A ServerSocketData for the read client and data if any was read,
+     *    otherwise empty optional.
+     */
+    std::optional<ServerSocketData> read(std::chrono::milliseconds timeout) override;
+
+    /**
+     * Wait for data, blocking for at most timeout, then read as many
+     * datagrams as are immediately available (up to an internal batch size).
+     *
+     * Note that this must only be called from one thread at a time.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @param batch
+     *   Collection to write read data to, only ever grown.
+     *
+     * @returns
+     *   Number of datagrams read, zero if the read timed out.
+     */
+    std::size_t read_batch(std::chrono::milliseconds timeout, std::vector<ServerSocketData> &batch) override;
+
+    /**
+     * Write a collection of datagrams, possibly to different clients.
+     *
+     * @param datagrams
+     *   Datagrams to write, clients must have been returned from this socket.
+     */
+    void write_batch(const std::vector<Datagram> &datagrams) override;
+
   private:
-    /** Map of address to Socket for clients. */
-    std::map<std::uint32_t, std::unique_ptr<Socket>> connections_;
+    // forward declare internal struct
+    struct Batch;
+
+    /**
+     * Read a datagram using the current receive timeout.
+     *
+     * @returns
+     *    A ServerSocketData for the read client and data if any was read,
+     *    otherwise empty optional if the read timed out.
+     */
+    std::optional<ServerSocketData> receive();
+
+    /**
+     * Get the Socket for a client, creating it if this is a new connection.
+     *
+     * @param address
+     *   Address data was read from.
+     *
+     * @param length
+     *   Length (in bytes) of address.
+     *
+     * @returns
+     *   Tuple of <client socket, whether it is a new connection>.
+     */
+    std::tuple<Socket *, bool> client(const struct sockaddr_in &address, socklen_t length);
+
+    /** Map of address and port to Socket for clients. */
+    std::map<std::uint64_t, std::unique_ptr<UdpSocket>> connections_;
 
     /** Underlying server socket. */
     AutoRelease<SocketHandle, INVALID_SOCKET> socket_;
+
+    /** Preallocated state for batched reads. */
+    std::unique_ptr<Batch> read_batch_;
+
+    /** Preallocated state for batched writes. */
+    std::unique_ptr<Batch> write_batch_;
+
+    /** Guards write_batch_, as writes can come from multiple threads. */
+    std::mutex write_mutex_;
 };
 
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -86,6 +87,21 @@ class UdpSocket : public Socket
      */
     DataBuffer read(std::size_t count) override;
 
+    /**
+     * Block and read up to count bytes, waiting at most timeout. May return
+     * less.
+     *
+     * @param count
+     *   Maximum number of bytes to read.
+     *
+     * @param timeout
+     *   Maximum time to wait for data, must be greater than zero.
+     *
+     * @returns
+     *   DataBuffer of bytes if read succeeded, otherwise empty optional.
+     */
+    std::optional<DataBuffer> read(std::size_t count, std::chrono::milliseconds timeout) override;
+
     /**
      * Write DataBuffer to socket.
      *
@@ -105,6 +121,14 @@ class UdpSocket : public Socket
      */
     void write(const std::byte *data, std::size_t size) override;
 
+    /**
+     * Get the address this socket writes to.
+     *
+     * @returns
+     *   BSD socket address.
+     */
+    const struct sockaddr_in &address() const;
+
   private:
     /** Socket wrapper. */
     AutoRelease<SocketHandle, INVALID_SOCKET> socket_;
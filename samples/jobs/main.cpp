@@ -210,64 +210,52 @@ void go(int, char **)
     static const auto width = 600;
     static const auto height = 400;
     std::vector<std::uint8_t> pixels(width * height * 3);
-    std::size_t counter = 0u;
 
     const float fov = M_PI / 3.;
     std::uniform_real_distribution<float> dist1(-0.5f, 0.5f);
 
-    std::vector<iris::Job> jobs;
-
     LOG_INFO("job_system", "starting");
     auto start = std::chrono::high_resolution_clock::now();
 
-    for (std::size_t j = 0; j < height; j++)
-    {
-        for (std::size_t i = 0; i < width; i++)
-        {
-            jobs.emplace_back([i, j, fov, counter, &pixels, &dist1]() {
-                const auto dir_x = (i + 0.5f) - width / 2.0f;
-                const auto dir_y = -(j + 0.5f) + height / 2.0f;
-                const auto dir_z = -height / (2.0f * tan(fov / 2.0f));
-
-                iris::Colour pixel;
-
-                auto samples = 100;
-
-                for (int i = 0; i < samples; i++)
-                {
-                    pixel += trace(
-                        {{0, 0, 0},
-                         iris::Vector3::normalise(
-                             {dir_x + dist1(generator),
-                              dir_y + dist1(generator),
-                              dir_z})},
-                        1);
-                }
-
-                pixel *= (1.0 / (float)samples);
-
-                // clamp colours
-                pixels[counter + 0u] = static_cast<std::uint8_t>(
-                    (255.0f * std::max(0.0f, std::min(1.0f, (float)pixel.r))));
-                pixels[counter + 1u] = static_cast<std::uint8_t>(
-                    (255.0f * std::max(0.0f, std::min(1.0f, (float)pixel.g))));
-                pixels[counter + 2u] = static_cast<std::uint8_t>(
-                    (255.0f * std::max(0.0f, std::min(1.0f, (float)pixel.b))));
-            });
-
-            counter += 3u;
-        }
-    }
-
-    do
-    {
-        const auto count = std::min((std::size_t)900ul, jobs.size());
-        std::vector<iris::Job> batch(std::cend(jobs) - count, std::cend(jobs));
-        jobs.erase(std::cend(jobs) - count, std::cend(jobs));
-
-        iris::Root::jobs_manager().wait(batch);
-
-    } while (!jobs.empty());
+    // one index per pixel, parallel_for splits these into chunks for us
+    iris::Root::jobs_manager().parallel_for(
+        0u,
+        width * height,
+        0u,
+        [fov, &pixels, &dist1](std::size_t index) {
+            const auto i = index % width;
+            const auto j = index / width;
+            const auto counter = index * 3u;
+
+            const auto dir_x = (i + 0.5f) - width / 2.0f;
+            const auto dir_y = -(j + 0.5f) + height / 2.0f;
+            const auto dir_z = -height / (2.0f * tan(fov / 2.0f));
+
+            iris::Colour pixel;
+
+            auto samples = 100;
+
+            for (int i = 0; i < samples; i++)
+            {
+                pixel += trace(
+                    {{0, 0, 0},
+                     iris::Vector3::normalise(
+                         {dir_x + dist1(generator),
+                          dir_y + dist1(generator),
+                          dir_z})},
+                    1);
+            }
+
+            pixel *= (1.0 / (float)samples);
+
+            // clamp colours
+            pixels[counter + 0u] = static_cast<std::uint8_t>(
+                (255.0f * std::max(0.0f, std::min(1.0f, (float)pixel.r))));
+            pixels[counter + 1u] = static_cast<std::uint8_t>(
+                (255.0f * std::max(0.0f, std::min(1.0f, (float)pixel.g))));
+            pixels[counter + 2u] = static_cast<std::uint8_t>(
+                (255.0f * std::max(0.0f, std::min(1.0f, (float)pixel.b))));
+        });
 
     auto end = std::chrono::high_resolution_clock::now();
 
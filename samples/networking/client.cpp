@@ -554,6 +554,9 @@ void go(int, char **)
                 }
             }
 
+            // send any queued input (and acks) to the server
+            client.flush();
+
             // put the camera where the player is
             camera.set_position(character_controller->position());
 
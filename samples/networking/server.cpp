@@ -19,6 +19,7 @@
 #include "core/data_buffer.h"
 #include "core/exception.h"
 #include "core/looper.h"
+#include "core/start.h"
 #include "core/vector3.h"
 #include "log/log.h"
 #include "networking/data_buffer_deserialiser.h"
@@ -173,7 +174,8 @@ void go(int, char **)
 
 int main(int argc, char **argv)
 {
-    go(argc, argv);
+    // the server never renders, so skip all the graphics setup
+    iris::start_headless(argc, argv, go);
 
     return 0;
 }
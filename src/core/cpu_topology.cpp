@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/cpu_topology.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if defined(IRIS_PLATFORM_LINUX)
+#include <sched.h>
+#endif
+
+namespace
+{
+
+/**
+ * Parse the numeric suffix of a sysfs entry e.g. "cpu12" -> 12.
+ *
+ * @param name
+ *   Entry name.
+ *
+ * @param prefix
+ *   Expected prefix.
+ *
+ * @returns
+ *   Suffix if name is prefix followed by only digits, otherwise empty.
+ */
+std::optional<std::size_t> parse_index(const std::string &name, const std::string &prefix)
+{
+    if ((name.size() <= prefix.size()) || (name.compare(0u, prefix.size(), prefix) != 0) ||
+        !std::all_of(name.begin() + prefix.size(), name.end(), [](char c) { return (c >= '0') && (c <= '9'); }))
+    {
+        return std::nullopt;
+    }
+
+    return static_cast<std::size_t>(std::stoul(name.substr(prefix.size())));
+}
+
+/**
+ * Read a single number from a file.
+ *
+ * @param path
+ *   File to read.
+ *
+ * @returns
+ *   Number in file, or empty if it could not be read.
+ */
+std::optional<std::size_t> read_number(const std::filesystem::path &path)
+{
+    std::ifstream strm{path};
+    std::size_t value = 0u;
+
+    if (!(strm >> value))
+    {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+/**
+ * Parse a sysfs cpu list e.g. "0-3,8,10-11".
+ *
+ * @param list
+ *   List to parse.
+ *
+ * @returns
+ *   Ids in list.
+ */
+std::vector<std::size_t> parse_cpu_list(const std::string &list)
+{
+    std::vector<std::size_t> cpus{};
+    std::stringstream strm{list};
+    std::string range{};
+
+    while (std::getline(strm, range, ','))
+    {
+        if (range.empty() || (range.front() < '0') || (range.front() > '9'))
+        {
+            continue;
+        }
+
+        const auto dash = range.find('-');
+        const auto first = static_cast<std::size_t>(std::stoul(range.substr(0u, dash)));
+        const auto last =
+            (dash == std::string::npos) ? first : static_cast<std::size_t>(std::stoul(range.substr(dash + 1u)));
+
+        for (auto cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.emplace_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+#if defined(IRIS_PLATFORM_LINUX)
+/**
+ * Get the cpus the process is allowed to run on, this can be a subset of the
+ * online cpus e.g. in a container or under taskset.
+ *
+ * @returns
+ *   Allowed cpu ids, or empty if they could not be read.
+ */
+std::vector<std::size_t> allowed_cpus()
+{
+    ::cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    std::vector<std::size_t> cpus{};
+    if (::sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+    {
+        for (auto cpu = std::size_t{0u}; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &cpu_set))
+            {
+                cpus.emplace_back(cpu);
+            }
+        }
+    }
+
+    return cpus;
+}
+#endif
+
+}
+
+namespace iris
+{
+
+CpuTopology::CpuTopology(std::vector<LogicalCpu> cpus)
+    : cpus_(std::move(cpus))
+{
+    std::sort(cpus_.begin(), cpus_.end(), [](const auto &a, const auto &b) { return a.id < b.id; });
+
+    // the lowest numbered thread on a core is its primary
+    std::set<std::size_t> seen_cores{};
+    for (auto &cpu : cpus_)
+    {
+        cpu.primary = seen_cores.emplace(cpu.core).second;
+    }
+}
+
+CpuTopology CpuTopology::detect()
+{
+    static const std::filesystem::path sysfs_root{"/sys/devices/system"};
+
+    auto topology = flat(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::error_code error{};
+    if (std::filesystem::exists(sysfs_root / "cpu", error))
+    {
+        if (auto sysfs = from_sysfs(sysfs_root); !sysfs.cpus().empty())
+        {
+            topology = std::move(sysfs);
+        }
+    }
+
+#if defined(IRIS_PLATFORM_LINUX)
+    // sysfs describes the whole machine, only keep what we can be pinned to
+    if (const auto allowed = allowed_cpus(); !allowed.empty())
+    {
+        if (auto restricted = topology.restrict_to(allowed); !restricted.cpus().empty())
+        {
+            topology = std::move(restricted);
+        }
+    }
+#endif
+
+    return topology;
+}
+
+CpuTopology CpuTopology::from_sysfs(const std::filesystem::path &root)
+{
+    std::map<std::size_t, std::size_t> cpu_nodes{};
+
+    std::error_code error{};
+    for (const auto &entry : std::filesystem::directory_iterator(root / "node", error))
+    {
+        if (const auto node = parse_index(entry.path().filename().string(), "node"); node)
+        {
+            std::ifstream strm{entry.path() / "cpulist"};
+            std::string list{};
+            std::getline(strm, list);
+
+            for (const auto cpu : parse_cpu_list(list))
+            {
+                cpu_nodes[cpu] = *node;
+            }
+        }
+    }
+
+    // core ids are only unique within a package, so we renumber them
+    std::map<std::tuple<std::size_t, std::size_t>, std::size_t> core_ids{};
+    std::vector<LogicalCpu> cpus{};
+
+    for (const auto &entry : std::filesystem::directory_iterator(root / "cpu", error))
+    {
+        const auto id = parse_index(entry.path().filename().string(), "cpu");
+        if (!id)
+        {
+            continue;
+        }
+
+        // offline cpus have no topology
+        const auto core = read_number(entry.path() / "topology" / "core_id");
+        const auto package = read_number(entry.path() / "topology" / "physical_package_id");
+        if (!core || !package)
+        {
+            continue;
+        }
+
+        const auto node = cpu_nodes.find(*id);
+        const auto core_id = core_ids.emplace(std::make_tuple(*package, *core), core_ids.size()).first->second;
+
+        cpus.push_back({*id, core_id, *package, (node == std::end(cpu_nodes)) ? 0u : node->second, false});
+    }
+
+    return CpuTopology{std::move(cpus)};
+}
+
+CpuTopology CpuTopology::flat(std::size_t count)
+{
+    std::vector<LogicalCpu> cpus{};
+
+    for (auto i = std::size_t{0u}; i < count; ++i)
+    {
+        cpus.push_back({i, i, 0u, 0u, true});
+    }
+
+    return CpuTopology{std::move(cpus)};
+}
+
+CpuTopology CpuTopology::restrict_to(const std::vector<std::size_t> &ids) const
+{
+    std::vector<LogicalCpu> cpus{};
+
+    for (auto cpu : cpus_)
+    {
+        if (std::find(ids.begin(), ids.end(), cpu.id) != ids.end())
+        {
+            cpus.emplace_back(cpu);
+        }
+    }
+
+    return CpuTopology{std::move(cpus)};
+}
+
+const std::vector<LogicalCpu> &CpuTopology::cpus() const
+{
+    return cpus_;
+}
+
+std::size_t CpuTopology::physical_core_count() const
+{
+    return static_cast<std::size_t>(
+        std::count_if(cpus_.begin(), cpus_.end(), [](const auto &cpu) { return cpu.primary; }));
+}
+
+std::size_t CpuTopology::node_count() const
+{
+    std::set<std::size_t> nodes{};
+    for (const auto &cpu : cpus_)
+    {
+        nodes.emplace(cpu.node);
+    }
+
+    return nodes.size();
+}
+
+}
@@ -16,6 +16,9 @@
 #include "graphics/ios/ios_window_manager.h"
 #include "graphics/metal/metal_mesh_manager.h"
 #include "graphics/metal/metal_texture_manager.h"
+#include "graphics/null/null_mesh_manager.h"
+#include "graphics/null/null_texture_manager.h"
+#include "graphics/null/null_window_manager.h"
 #include "iris_version.h"
 #include "jobs/thread/thread_job_system_manager.h"
 #include "log/emoji_formatter.h"
@@ -27,9 +30,9 @@ namespace
 {
 
 /**
- * Register apis and set default.s
+ * Register graphics apis and set default.
  */
-void register_apis()
+void register_graphics_apis()
 {
     iris::Root::register_graphics_api(
         "metal",
@@ -37,7 +40,27 @@ void register_apis()
         std::make_unique<iris::MetalMeshManager>(),
         std::make_unique<iris::MetalTextureManager>());
     iris::Root::set_graphics_api("metal");
+}
 
+/**
+ * Register the null graphics api, which never creates a window or talks to a
+ * gpu.
+ */
+void register_null_graphics_api()
+{
+    iris::Root::register_graphics_api(
+        "null",
+        std::make_unique<iris::NullWindowManager>(),
+        std::make_unique<iris::NullMeshManager>(),
+        std::make_unique<iris::NullTextureManager>());
+    iris::Root::set_graphics_api("null");
+}
+
+/**
+ * Register non graphics apis and set defaults.
+ */
+void register_apis()
+{
     iris::Root::register_physics_api("bullet", std::make_unique<iris::BulletPhysicsManager>());
     iris::Root::set_physics_api("bullet");
 
@@ -62,6 +85,7 @@ void start(int argc, char **argv, std::function<void(int, char **)> entry)
     // formatter
     Logger::instance().set_Formatter<EmojiFormatter>();
 
+    register_graphics_apis();
     register_apis();
 
     LOG_ENGINE_INFO("start", "engine start");
@@ -90,9 +114,25 @@ void start_debug(int argc, char **argv, std::function<void(int, char **)> entry)
 
     LOG_ENGINE_INFO("start", "engine start (with debugging)");
 
+    register_graphics_apis();
     register_apis();
 
     start(argc, argv, entry);
 }
 
+void start_headless(int argc, char **argv, std::function<void(int, char **)> entry)
+{
+    Logger::instance().set_Formatter<EmojiFormatter>();
+
+    LOG_ENGINE_INFO("start", "engine start (headless)");
+
+    register_null_graphics_api();
+    register_apis();
+
+    // no ui so there's no need to go through UIApplicationMain
+    entry(argc, argv);
+
+    Root::reset();
+}
+
 }
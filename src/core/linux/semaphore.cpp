@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/semaphore.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "core/error_handling.h"
+
+namespace
+{
+
+/**
+ * Wait on a futex whilst it holds an expected value.
+ *
+ * @param address
+ *   Futex word.
+ *
+ * @param expected
+ *   Value to sleep on, returns immediately if the futex no longer holds it.
+ */
+void futex_wait(std::atomic<std::uint32_t> *address, std::uint32_t expected)
+{
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(address), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+/**
+ * Wake a thread waiting on a futex.
+ *
+ * @param address
+ *   Futex word.
+ */
+void futex_wake_one(std::atomic<std::uint32_t> *address)
+{
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(address), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+}
+
+namespace iris
+{
+
+struct Semaphore::implementation
+{
+    /** Number of available permits, this is the futex word. */
+    std::atomic<std::uint32_t> count;
+
+    /** Number of threads sleeping (or about to sleep) on the futex. */
+    std::atomic<std::uint32_t> waiters;
+};
+
+Semaphore::Semaphore(std::ptrdiff_t initial)
+    : impl_(std::make_unique<implementation>())
+{
+    expect(initial >= 0, "initial count cannot be negative");
+
+    impl_->count = static_cast<std::uint32_t>(initial);
+    impl_->waiters = 0u;
+}
+
+Semaphore::~Semaphore() = default;
+Semaphore::Semaphore(Semaphore &&) = default;
+Semaphore &Semaphore::operator=(Semaphore &&) = default;
+
+void Semaphore::release()
+{
+    impl_->count.fetch_add(1u);
+
+    // only make a syscall if someone could be sleeping, both this and the
+    // waiters increment in acquire are sequentially consistent so either we
+    // see the waiter or it sees our new count when the futex checks its value
+    if (impl_->waiters.load() != 0u)
+    {
+        futex_wake_one(&impl_->count);
+    }
+}
+
+void Semaphore::acquire()
+{
+    auto count = impl_->count.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        if (count != 0u)
+        {
+            if (impl_->count.compare_exchange_weak(count, count - 1u, std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+        else
+        {
+            ++impl_->waiters;
+            futex_wait(&impl_->count, 0u);
+            --impl_->waiters;
+
+            count = impl_->count.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/thread.h"
+
+#include <cstddef>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+Thread::Thread()
+    : thread_()
+{
+}
+
+bool Thread::joinable() const
+{
+    return thread_.joinable();
+}
+
+void Thread::join()
+{
+    thread_.join();
+}
+
+std::thread::id Thread::get_id() const
+{
+    return thread_.get_id();
+}
+
+void Thread::bind_to_core(std::size_t core)
+{
+    // cpu ids can be sparse (e.g. offline cpus or a restricted cpuset) so we
+    // cannot compare against the number of cpus, instead the kernel rejects
+    // any cpu we are not allowed to run on
+    ensure(core < CPU_SETSIZE, "invalid core id");
+
+    ::cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+
+    // unlike macos this is a hard binding, the thread will only run on the
+    // supplied core
+    const auto set_affinity = ::pthread_setaffinity_np(thread_.native_handle(), sizeof(cpu_set), &cpu_set);
+    ensure(set_affinity == 0, "failed to bind thread to core");
+}
+
+}
@@ -8,6 +8,8 @@
 
 #include <chrono>
 
+#include "jobs/job_trace.h"
+
 namespace iris
 {
 
@@ -31,6 +33,8 @@ void Looper::run()
 
     do
     {
+        IRIS_TRACE_FRAME();
+
         // calculate duration of last frame
         const auto end = std::chrono::steady_clock::now();
         const auto frame_time = end - start;
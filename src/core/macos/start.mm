@@ -12,6 +12,9 @@
 #include "graphics/macos/macos_window_manager.h"
 #include "graphics/metal/metal_mesh_manager.h"
 #include "graphics/metal/metal_texture_manager.h"
+#include "graphics/null/null_mesh_manager.h"
+#include "graphics/null/null_texture_manager.h"
+#include "graphics/null/null_window_manager.h"
 #include "graphics/opengl/opengl_mesh_manager.h"
 #include "graphics/opengl/opengl_texture_manager.h"
 #include "iris_version.h"
@@ -24,7 +27,7 @@
 namespace
 {
 
-void register_apis()
+void register_graphics_apis()
 {
     iris::Root::register_graphics_api(
         "metal",
@@ -39,7 +42,25 @@ void register_apis()
         std::make_unique<iris::OpenGLTextureManager>());
 
     iris::Root::set_graphics_api("metal");
+}
+
+/**
+ * Register the null graphics api, which never creates a window or talks to a
+ * gpu.
+ */
+void register_null_graphics_api()
+{
+    iris::Root::register_graphics_api(
+        "null",
+        std::make_unique<iris::NullWindowManager>(),
+        std::make_unique<iris::NullMeshManager>(),
+        std::make_unique<iris::NullTextureManager>());
 
+    iris::Root::set_graphics_api("null");
+}
+
+void register_apis()
+{
     iris::Root::register_physics_api("bullet", std::make_unique<iris::BulletPhysicsManager>());
 
     iris::Root::set_physics_api("bullet");
@@ -60,6 +81,7 @@ void start(int argc, char **argv, std::function<void(int, char **)> entry)
 {
     LOG_ERROR("start", "engine start {}", IRIS_VERSION_STR);
 
+    register_graphics_apis();
     register_apis();
 
     entry(argc, argv);
@@ -74,6 +96,19 @@ void start_debug(int argc, char **argv, std::function<void(int, char **)> entry)
 
     LOG_ENGINE_INFO("start", "engine start (with debugging) {}", IRIS_VERSION_STR);
 
+    register_graphics_apis();
+    register_apis();
+
+    entry(argc, argv);
+
+    Root::reset();
+}
+
+void start_headless(int argc, char **argv, std::function<void(int, char **)> entry)
+{
+    LOG_ENGINE_INFO("start", "engine start (headless) {}", IRIS_VERSION_STR);
+
+    register_null_graphics_api();
     register_apis();
 
     entry(argc, argv);
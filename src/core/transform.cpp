@@ -7,6 +7,7 @@
 #include "core/transform.h"
 
 #include <cmath>
+#include <tuple>
 
 #include "core/matrix4.h"
 #include "core/quaternion.h"
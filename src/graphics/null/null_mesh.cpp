@@ -0,0 +1,25 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_mesh.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "graphics/vertex_data.h"
+
+namespace iris
+{
+
+void NullMesh::update_vertex_data(const std::vector<VertexData> &)
+{
+}
+
+void NullMesh::update_index_data(const std::vector<std::uint32_t> &)
+{
+}
+
+}
@@ -0,0 +1,27 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_mesh_manager.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graphics/mesh.h"
+#include "graphics/null/null_mesh.h"
+#include "graphics/vertex_data.h"
+
+namespace iris
+{
+
+std::unique_ptr<Mesh> NullMeshManager::create_mesh(
+    const std::vector<iris::VertexData> &,
+    const std::vector<std::uint32_t> &) const
+{
+    return std::make_unique<NullMesh>();
+}
+
+}
@@ -0,0 +1,25 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_render_target.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "graphics/null/null_texture.h"
+#include "graphics/texture_usage.h"
+
+namespace iris
+{
+
+NullRenderTarget::NullRenderTarget(std::uint32_t width, std::uint32_t height)
+    : RenderTarget(
+          std::make_unique<NullTexture>(width, height, TextureUsage::RENDER_TARGET),
+          std::make_unique<NullTexture>(width, height, TextureUsage::DEPTH))
+{
+}
+
+}
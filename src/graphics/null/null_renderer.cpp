@@ -0,0 +1,31 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_renderer.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "graphics/null/null_render_target.h"
+#include "graphics/render_pass.h"
+#include "graphics/render_target.h"
+
+namespace iris
+{
+
+void NullRenderer::set_render_passes(const std::vector<RenderPass> &)
+{
+    // nothing is ever drawn, so don't bother building a render queue
+}
+
+RenderTarget *NullRenderer::create_render_target(std::uint32_t width, std::uint32_t height)
+{
+    render_targets_.emplace_back(std::make_unique<NullRenderTarget>(width, height));
+    return render_targets_.back().get();
+}
+
+}
@@ -0,0 +1,22 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_texture.h"
+
+#include <cstdint>
+
+#include "graphics/texture.h"
+#include "graphics/texture_usage.h"
+
+namespace iris
+{
+
+NullTexture::NullTexture(std::uint32_t width, std::uint32_t height, TextureUsage usage)
+    : Texture({}, width, height, usage)
+{
+}
+
+}
@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_texture_manager.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "core/data_buffer.h"
+#include "graphics/null/null_texture.h"
+#include "graphics/texture.h"
+#include "graphics/texture_usage.h"
+
+namespace iris
+{
+
+std::unique_ptr<Texture> NullTextureManager::do_create(
+    const DataBuffer &,
+    std::uint32_t width,
+    std::uint32_t height,
+    TextureUsage usage)
+{
+    return std::make_unique<NullTexture>(width, height, usage);
+}
+
+}
@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_window.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "events/event.h"
+#include "graphics/null/null_renderer.h"
+
+namespace iris
+{
+
+NullWindow::NullWindow(std::uint32_t width, std::uint32_t height)
+    : Window(width, height)
+{
+    renderer_ = std::make_unique<NullRenderer>();
+}
+
+std::uint32_t NullWindow::screen_scale() const
+{
+    return 1u;
+}
+
+std::optional<Event> NullWindow::pump_event()
+{
+    return std::nullopt;
+}
+
+void NullWindow::render() const
+{
+}
+
+}
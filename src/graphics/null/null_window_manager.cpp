@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "graphics/null/null_window_manager.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "core/error_handling.h"
+#include "graphics/null/null_window.h"
+#include "graphics/window.h"
+
+namespace iris
+{
+
+Window *NullWindowManager::create_window(std::uint32_t width, std::uint32_t height)
+{
+    // only support one window, same as the real platforms
+    ensure(!current_window_, "window already created");
+
+    current_window_ = std::make_unique<NullWindow>(width, height);
+
+    return current_window_.get();
+}
+
+Window *NullWindowManager::current_window() const
+{
+    return current_window_.get();
+}
+
+}
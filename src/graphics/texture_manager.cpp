@@ -6,11 +6,14 @@
 
 #include "graphics/texture_manager.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -7,36 +7,90 @@
 #include "jobs/fiber/counter.h"
 
 #include <atomic>
-#include <mutex>
+#include <cstdint>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/fiber.h"
+
+namespace
+{
+
+/**
+ * Sentinel value for the waiter list, indicates the counter has reached zero
+ * and the list has been handed off. It is never dereferenced.
+ *
+ * @returns
+ *   Sentinel fiber pointer.
+ */
+iris::Fiber *released()
+{
+    return reinterpret_cast<iris::Fiber *>(std::uintptr_t{1u});
+}
+
+}
 
 namespace iris
 {
 
 Counter::Counter(int value)
     : value_(value)
-    , mutex_()
+    , waiters_(nullptr)
 {
 }
 
-Counter::operator int()
+Counter::operator int() const
 {
-    std::unique_lock lock(mutex_);
-
-    return value_;
+    return value_.load(std::memory_order_acquire);
 }
 
 void Counter::operator--()
 {
-    std::unique_lock lock(mutex_);
-
-    --value_;
+    [[maybe_unused]] const auto *waiters = decrement();
+    expect(waiters == nullptr, "fibers waiting on counter");
 }
 
 void Counter::operator--(int)
 {
-    std::unique_lock lock(mutex_);
+    --(*this);
+}
 
-    --value_;
+Fiber *Counter::decrement()
+{
+    Fiber *waiters = nullptr;
+
+    if (value_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        // only one caller can ever take us to zero, so waiters are handed off
+        // exactly once, any fiber trying to park after this will see the
+        // sentinel and not suspend
+        waiters = waiters_.exchange(released(), std::memory_order_acq_rel);
+    }
+
+    return waiters;
+}
+
+bool Counter::add_waiter(Fiber *fiber)
+{
+    // note we check for the sentinel rather than the value, the value reaching
+    // zero does not mean the decrementing thread is done with us
+    auto *head = waiters_.load(std::memory_order_acquire);
+
+    do
+    {
+        if (head == released())
+        {
+            return false;
+        }
+
+        fiber->next_waiter_ = head;
+    } while (!waiters_.compare_exchange_weak(head, fiber, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return true;
+}
+
+bool Counter::is_released() const
+{
+    return waiters_.load(std::memory_order_acquire) == released();
 }
 
 }
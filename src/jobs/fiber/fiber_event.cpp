@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_event.h"
+
+#include <mutex>
+
+namespace iris
+{
+
+FiberEvent::FiberEvent()
+    : guard_()
+    , set_(false)
+    , waiters_()
+{
+}
+
+void FiberEvent::set()
+{
+    std::unique_lock lock(guard_);
+
+    set_ = true;
+    waiters_.notify_all();
+}
+
+void FiberEvent::reset()
+{
+    std::unique_lock lock(guard_);
+    set_ = false;
+}
+
+void FiberEvent::wait()
+{
+    std::unique_lock lock(guard_);
+
+    // a reset between us being woken and reacquiring the lock means we wait
+    // again
+    while (!set_)
+    {
+        waiters_.wait(lock);
+    }
+}
+
+bool FiberEvent::is_set()
+{
+    std::unique_lock lock(guard_);
+    return set_;
+}
+
+}
@@ -6,165 +6,337 @@
 
 #include "jobs/fiber/fiber_job_system.h"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
-#include <condition_variable>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
-#include <mutex>
 #include <sstream>
 #include <string>
-#include <tuple>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "core/auto_release.h"
-#include "core/semaphore.h"
+#include "core/cpu_topology.h"
+#include "core/error_handling.h"
 #include "core/thread.h"
 #include "jobs/concurrent_queue.h"
 #include "jobs/fiber/counter.h"
 #include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_event.h"
+#include "jobs/idle_strategy.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_trace.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/work_stealing_deque.h"
+#include "jobs/worker_placement.h"
 #include "log/log.h"
 
 namespace
 {
 
 /**
- * This is the main function for the worker threads. It's responsible for
- * taking fibers off the queue, executing them and performing all necessary
- * bookkeeping.
+ * Per thread state for a worker.
+ */
+struct WorkerState
+{
+    /** Job system the worker belongs to, nullptr if not a worker. */
+    iris::FiberJobSystem *job_system;
+
+    /** Index of workers own deque. */
+    std::size_t index;
+
+    /** State for picking random steal victims. */
+    std::uint32_t random_state;
+
+    /** Number of fibers picked, used to decide which priority to look at first. */
+    std::uint64_t picks;
+};
+
+/**
+ * Get the worker state for the calling thread.
  *
- * @param id
- *   Unique id for thread.
+ * @returns
+ *   Reference to thread local worker state.
+ */
+WorkerState &worker_state()
+{
+    thread_local WorkerState state{nullptr, 0u, 0u, 0u};
+    return state;
+}
+
+/**
+ * Get the slots to run workers in.
  *
- * @param jobs_semaphore
- *   Semaphore signaling how many fibers are available to run.
+ * If the worker count is left to us and nothing has been reserved then the
+ * core of the first cpu is reserved for the calling thread, as the unpinned
+ * default leaves it a cpu. The caller is not pinned, so the scheduler is free
+ * to move it to the spare core.
  *
- * @param running
- *   Flag to indicate if this thread should keep running.
+ * @param config
+ *   Job system config.
  *
- * @param fibers
- *   Queue of fibers to pop from.e
+ * @returns
+ *   Slots for workers, empty if workers are not pinned.
  */
-void job_thread(
-    [[maybe_unused]] int id,
-    iris::Semaphore &jobs_semaphore,
-    std::atomic<bool> &running,
-    iris::ConcurrentQueue<std::tuple<iris::Fiber *, iris::Counter *>> &fibers)
+std::vector<iris::WorkerSlot> resolve_slots(const iris::FiberJobSystemConfig &config)
 {
-    iris::Fiber::thread_to_fiber();
+    if (!config.placement.pin_workers)
+    {
+        return {};
+    }
 
-    LOG_DEBUG("job_system", "{} thread start [{}]", id, (void *)*iris::Fiber::this_fiber());
+    const auto topology = iris::CpuTopology::detect();
+    auto placement = config.placement;
 
-    while (running)
+    if ((config.worker_count == 0u) && placement.reserved_cpus.empty() && (topology.physical_core_count() > 1u))
     {
-        // wait for jobs to become available
-        jobs_semaphore.acquire();
+        placement.reserved_cpus.emplace_back(topology.cpus().front().id);
+    }
 
-        if (!running)
-        {
-            break;
-        }
+    return iris::place_workers(topology, placement);
+}
 
-        // block and wait for fiber from queue, this should be low contention
-        // as most of the waiting is handled by the semaphore
-        auto [fiber, wait_counter] = fibers.dequeue();
+/**
+ * Get the number of workers to create.
+ *
+ * @param config
+ *   Job system config.
+ *
+ * @param slots
+ *   Slots for workers, empty if workers are not pinned.
+ *
+ * @returns
+ *   Number of worker threads.
+ */
+std::size_t resolve_worker_count(const iris::FiberJobSystemConfig &config, const std::vector<iris::WorkerSlot> &slots)
+{
+    if (config.worker_count != 0u)
+    {
+        return config.worker_count;
+    }
 
-        // we cannot safely use a fiber whilst it is resuming
-        // as a fiber should never be in the resuming state for long (the time
-        // it takes to suspend and return to previous context) we use a
-        // primitive spin lock
-        while (!fiber->is_safe())
-        {
-        }
+    return slots.empty() ? std::max(1u, std::thread::hardware_concurrency() - 1u) : slots.size();
+}
 
-        if (wait_counter == nullptr)
-        {
-            // if we have no wait counter then this is the first time we are
-            // seeing this fibre - so start it
-            fiber->start();
-        }
-        else
-        {
-            // if we have a wait counter then this is a suspended fiber thats
-            // been put back on the queue
+/**
+ * Get the current time for measuring wake latency.
+ *
+ * @returns
+ *   Steady clock time in nanoseconds.
+ */
+std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
 
-            if (*wait_counter == 0)
-            {
-                // wait counter of zero means all its children jobs have
-                // finished so we can resume
-                fiber->resume();
+/**
+ * Get the stack size for jobs at each priority.
+ *
+ * @param config
+ *   Job system config.
+ *
+ * @returns
+ *   Stack pages, indexed by priority.
+ */
+std::array<std::size_t, iris::job_priority_count> resolve_stack_pages(const iris::FiberJobSystemConfig &config)
+{
+    auto pages = config.priority_stack_pages;
+    std::replace(pages.begin(), pages.end(), std::size_t{0u}, config.stack_pages);
 
-                // if nothing is waiting on us then we were a fire-and-forget
-                // job so need to cleanup
-                if (!fiber->is_being_waited_on())
-                {
-                    delete fiber;
-                }
-            }
-            else
+    return pages;
+}
+
+/**
+ * Get the next random number for picking steal victims. This is a simple
+ * xorshift as we only need it to be cheap and spread out thieves.
+ *
+ * @param state
+ *   Worker state to use.
+ *
+ * @returns
+ *   Random number.
+ */
+std::uint32_t next_random(WorkerState &state)
+{
+    auto x = state.random_state;
+    x ^= x << 13u;
+    x ^= x >> 17u;
+    x ^= x << 5u;
+    state.random_state = x;
+
+    return x;
+}
+
+/**
+ * Try and find a fiber of a given priority to run. Looks at the workers own
+ * deque first, then the shared queues and finally tries to steal from other
+ * workers, starting at a random victim. Workers on the same node are tried
+ * before remote ones.
+ *
+ * @param state
+ *   Worker state for calling thread.
+ *
+ * @param nodes
+ *   Node of each worker.
+ *
+ * @param queues
+ *   Per worker deques for priority.
+ *
+ * @param fibers
+ *   Shared queue of fibers for priority.
+ *
+ * @param overflow
+ *   Shared overflow queue of fibers for priority.
+ *
+ * @param fiber
+ *   Out parameter for found fiber.
+ *
+ * @returns
+ *   True if a fiber was found, otherwise false.
+ */
+bool find_fiber(
+    WorkerState &state,
+    const std::vector<std::size_t> &nodes,
+    const std::vector<std::unique_ptr<iris::WorkStealingDeque<iris::Fiber *>>> &queues,
+    iris::MpmcQueue<iris::Fiber *> &fibers,
+    iris::ConcurrentQueue<iris::Fiber *> &overflow,
+    iris::Fiber *&fiber)
+{
+    if (queues[state.index]->try_pop(fiber) || fibers.try_dequeue(fiber) ||
+        (!overflow.empty() && overflow.try_dequeue(fiber)))
+    {
+        return true;
+    }
+
+    const auto victim = next_random(state) % queues.size();
+    const auto node = nodes[state.index];
+
+    // when the nodes are all the same the second pass finds nothing to try
+    for (const auto local : {true, false})
+    {
+        for (auto i = 0u; i < queues.size(); ++i)
+        {
+            const auto index = (victim + i) % queues.size();
+
+            if ((index != state.index) && ((nodes[index] == node) == local) && queues[index]->try_steal(fiber))
             {
-                // we are still waiting on at least one child job to finish so
-                // put the fiber back on the queue
-                fibers.enqueue(fiber, wait_counter);
-                jobs_semaphore.release();
+                IRIS_TRACE_JOB(iris::JobTraceEventType::STEAL, fiber->id(), static_cast<std::uint32_t>(index));
+                return true;
             }
         }
     }
 
-    LOG_DEBUG("job_system", "{} thread end [{}]", id, (void *)*iris::Fiber::this_fiber());
+    return false;
+}
 
-    // safe to cleanup fiber we created for thread
-    delete *iris::Fiber::this_fiber();
-    *iris::Fiber::this_fiber() = nullptr;
+/**
+ * Try and find a fiber of any priority to run. Priorities are searched in the
+ * order given by priority_order, so less urgent fibers are not starved.
+ *
+ * @param state
+ *   Worker state for calling thread.
+ *
+ * @param nodes
+ *   Node of each worker.
+ *
+ * @param queues
+ *   Per priority, per worker deques.
+ *
+ * @param fibers
+ *   Per priority shared queues.
+ *
+ * @param overflow
+ *   Per priority shared overflow queues.
+ *
+ * @param fiber
+ *   Out parameter for found fiber.
+ *
+ * @returns
+ *   True if a fiber was found, otherwise false.
+ */
+bool find_fiber(
+    WorkerState &state,
+    const std::vector<std::size_t> &nodes,
+    const std::array<std::vector<std::unique_ptr<iris::WorkStealingDeque<iris::Fiber *>>>, iris::job_priority_count>
+        &queues,
+    std::array<iris::MpmcQueue<iris::Fiber *>, iris::job_priority_count> &fibers,
+    std::array<iris::ConcurrentQueue<iris::Fiber *>, iris::job_priority_count> &overflow,
+    iris::Fiber *&fiber)
+{
+    for (const auto priority : iris::priority_order(state.picks))
+    {
+        const auto index = static_cast<std::size_t>(priority);
+
+        if (find_fiber(state, nodes, queues[index], fibers[index], overflow[index], fiber))
+        {
+            ++state.picks;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 /**
  * If the main thread (which is not a fiber) wants to wait on a job then it
- * cannot. We bootstrap that by using traditional signaling primitives.
+ * cannot. We bootstrap that by waiting on an event, which falls back to
+ * blocking the calling thread.
  *
  * @param jobs
- *   Jobs to wait on
+ *   Jobs to wait on, forwarded to wait_for_jobs.
+ *
+ * @param priority
+ *   Priority of jobs.
  *
  * @param js
  *   Pointer to JoSystem.
  */
-void bootstrap_first_job(const std::vector<iris::Job> &jobs, iris::FiberJobSystem *js)
+template <class Jobs>
+void bootstrap_first_job(Jobs &&jobs, iris::JobPriority priority, iris::FiberJobSystem *js)
 {
-    std::mutex m;
-    std::condition_variable cv;
-    std::atomic<bool> done = false;
+    iris::FiberEvent done{};
     std::exception_ptr exception;
 
     // wrap everything up in a fire-and-forget job
-    js->add_jobs({{[&cv, &done, &jobs, &exception, js]()
-                   {
-                       LOG_ENGINE_INFO("job_system", "bootstrap started");
-
-                       try
-                       {
-                           // we can now call wait for jobs because we are
-                           // within another fiber
-                           js->wait_for_jobs(jobs);
-                       }
-                       catch (...)
-                       {
-                           // capture any exception
-                           exception = std::current_exception();
-                       }
-
-                       // signal calling thread we are finished
-                       done = true;
-                       cv.notify_one();
-                       LOG_ENGINE_INFO("job_system", "bootstrap lambda done");
-                   }}});
+    std::vector<iris::InplaceJob> bootstrap{};
+    bootstrap.emplace_back(
+        [&done, &jobs, &exception, priority, js]()
+        {
+            LOG_ENGINE_INFO("job_system", "bootstrap started");
+
+            try
+            {
+                // we can now call wait for jobs because we are within another
+                // fiber
+                js->wait_for_jobs(std::forward<Jobs>(jobs), priority);
+            }
+            catch (...)
+            {
+                // capture any exception
+                exception = std::current_exception();
+            }
+
+            LOG_ENGINE_INFO("job_system", "bootstrap lambda done");
+
+            // signal calling thread we are finished, it may return as soon as
+            // this is called so we must not touch anything captured after it
+            done.set();
+        });
+
+    js->add_jobs(std::move(bootstrap), priority);
 
     // block and wait for wrapping fiber to finish
-    if (!done)
-    {
-        std::unique_lock lock(m);
-        cv.wait(lock, [&done]() { return done.load(); });
-    }
+    done.wait();
 
     LOG_ENGINE_INFO("job_system", "non-fiber wait complete");
 
@@ -181,28 +353,93 @@ namespace iris
 {
 
 FiberJobSystem::FiberJobSystem()
-    : running_(true)
-    , jobs_semaphore_()
+    : FiberJobSystem(FiberJobSystemConfig{})
+{
+}
+
+FiberJobSystem::FiberJobSystem(std::size_t worker_count)
+    : FiberJobSystem(FiberJobSystemConfig{.worker_count = worker_count})
+{
+}
+
+FiberJobSystem::FiberJobSystem(const FiberJobSystemConfig &config)
+    : slots_(resolve_slots(config))
+    , pool_(
+          resolve_worker_count(config, slots_),
+          resolve_stack_pages(config),
+          config.max_pooled_fibers,
+          config.paint_stacks)
+    , running_(true)
+    , idle_(config.idle)
+    , work_epoch_(0u)
+    , sleepers_(0u)
+    , last_wake_(0)
     , workers_()
+    , worker_nodes_()
+    , queues_()
     , fibers_()
+    , overflow_()
+    , dequeues_(0u)
+    , starts_(0u)
+    , resumes_(0u)
+    , parks_(0u)
+    , wake_calls_(0u)
+    , wakeups_(0u)
+    , wake_latency_ns_(0u)
+    , next_job_id_(1u)
 {
-    auto thread_count = std::max(1u, std::thread::hardware_concurrency() - 1u);
+    const auto count = resolve_worker_count(config, slots_);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        worker_nodes_.emplace_back(slots_.empty() ? 0u : slots_[i % slots_.size()].node);
+    }
+
+    // create all deques up front, workers may steal from each other as soon as
+    // they start
+    for (auto &queues : queues_)
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            queues.emplace_back(std::make_unique<WorkStealingDeque<Fiber *>>());
+        }
+    }
+
+    LOG_ENGINE_INFO("job_system", "creating {} threads", count);
+    try
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            workers_.emplace_back(&FiberJobSystem::job_thread, this, i);
 
-    LOG_ENGINE_INFO("job_system", "creating {} threads", thread_count);
-    for (auto i = 0u; i < thread_count; ++i)
+            // if there are more workers than slots then they have to share
+            if (!slots_.empty())
+            {
+                workers_.back().bind_to_core(slots_[i % slots_.size()].cpu);
+            }
+        }
+    }
+    catch (...)
     {
-        workers_.emplace_back(job_thread, i + 1, std::ref(jobs_semaphore_), std::ref(running_), std::ref(fibers_));
+        // the destructor will not run, so the started workers must be joined
+        // here or destroying them terminates
+        stop_workers();
+        throw;
     }
 }
 
 FiberJobSystem::~FiberJobSystem()
+{
+    stop_workers();
+}
+
+void FiberJobSystem::stop_workers()
 {
     running_ = false;
 
-    for (auto i = 0u; i < workers_.size() + 1u; i++)
-    {
-        jobs_semaphore_.release();
-    }
+    // bump the epoch so no worker can park after this
+    work_epoch_.fetch_add(1u);
+    work_epoch_.notify_all();
 
     for (auto &worker : workers_)
     {
@@ -210,68 +447,374 @@ FiberJobSystem::~FiberJobSystem()
     }
 }
 
-void FiberJobSystem::add_jobs(const std::vector<Job> &jobs)
+void FiberJobSystem::add_jobs(const std::vector<Job> &jobs, JobPriority priority)
 {
     for (const auto &job : jobs)
     {
-        // we rely on the worker thread to clean up after us
-        auto *f = new Fiber{job};
+        // we rely on the worker thread to return the fiber to the pool
+        enqueue(pool_.acquire(pool_cache(), InplaceJob{job}, nullptr, priority));
+    }
+
+    wake_workers(jobs.size());
+}
 
-        fibers_.enqueue(f, nullptr);
-        jobs_semaphore_.release();
+void FiberJobSystem::add_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority)
+{
+    for (auto &job : jobs)
+    {
+        enqueue(pool_.acquire(pool_cache(), std::move(job), nullptr, priority));
     }
+
+    wake_workers(jobs.size());
 }
 
-void FiberJobSystem::wait_for_jobs(const std::vector<Job> &jobs)
+void FiberJobSystem::wait_for_jobs(const std::vector<Job> &jobs, JobPriority priority)
 {
+    // there would be nothing to decrement the counter and wake us
+    if (jobs.empty())
+    {
+        return;
+    }
+
     if (*Fiber::this_fiber() == nullptr)
     {
-        bootstrap_first_job(jobs, this);
+        bootstrap_first_job(jobs, priority, this);
     }
     else
     {
-        auto counter = std::make_unique<Counter>(static_cast<int>(jobs.size()));
-        std::vector<std::unique_ptr<Fiber>> fibers{};
+        Counter counter{static_cast<int>(jobs.size())};
+        std::vector<Fiber *> fibers{};
+        fibers.reserve(jobs.size());
 
         // create fibers and add to the queue
+        const auto cache = pool_cache();
         for (const auto &job : jobs)
         {
-            fibers.emplace_back(std::make_unique<Fiber>(job, counter.get()));
+            fibers.emplace_back(pool_.acquire(cache, InplaceJob{job}, &counter, priority));
+            enqueue(fibers.back());
+        }
+
+        wake_workers(fibers.size());
+        wait_for_fibers(counter, fibers);
+    }
+}
+
+void FiberJobSystem::wait_for_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority)
+{
+    // there would be nothing to decrement the counter and wake us
+    if (jobs.empty())
+    {
+        return;
+    }
+
+    if (*Fiber::this_fiber() == nullptr)
+    {
+        bootstrap_first_job(std::move(jobs), priority, this);
+    }
+    else
+    {
+        Counter counter{static_cast<int>(jobs.size())};
+        std::vector<Fiber *> fibers{};
+        fibers.reserve(jobs.size());
+
+        const auto cache = pool_cache();
+        for (auto &job : jobs)
+        {
+            fibers.emplace_back(pool_.acquire(cache, std::move(job), &counter, priority));
+            enqueue(fibers.back());
+        }
+
+        wake_workers(fibers.size());
+        wait_for_fibers(counter, fibers);
+    }
+}
+
+void FiberJobSystem::wait_for_fibers(Counter &counter, const std::vector<Fiber *> &fibers)
+{
+    auto *current_fiber = *Fiber::this_fiber();
+
+    // park ourself on the counter, the worker that finishes the last child
+    // will make us runnable again - there's nothing to do if they all
+    // finished already
+    if (!counter.is_released())
+    {
+        // mark current fiber as unsafe so another thread doesn't
+        // preemptively try to resume it before it has suspended
+        current_fiber->set_unsafe();
+
+        if (!counter.add_waiter(current_fiber))
+        {
+            // children finished whilst we were parking, nothing will wake
+            // us so reschedule ourself
+            schedule(current_fiber);
+        }
+
+        // suspend current thread - this will internally mark the fiber as
+        // safe
+        current_fiber->suspend();
+
+        // if we get here then all children jobs have finished and resume
+        // has been called
+    }
+
+    std::exception_ptr job_exception;
+
+    for (auto *fiber : fibers)
+    {
+        // find first exception that was throw, first come first served
+        if ((fiber->exception() != nullptr) && !job_exception)
+        {
+            job_exception = fiber->exception();
+        }
+
+        // we may have been resumed on a different thread, so return our
+        // children via the shared cache
+        pool_.release(pool_.shared_cache(), fiber);
+    }
+
+    if (job_exception)
+    {
+        std::rethrow_exception(job_exception);
+    }
+}
+
+void FiberJobSystem::schedule(Fiber *fiber)
+{
+    enqueue(fiber);
+    wake_workers(1u);
+}
+
+void FiberJobSystem::enqueue(Fiber *fiber)
+{
+    const auto &state = worker_state();
+    const auto priority = static_cast<std::size_t>(fiber->priority());
+
+    // fibers are pooled, so their address does not identify a job, instead
+    // each job is given an id the first time it is queued
+    if (!fiber->is_started())
+    {
+        fiber->set_id(next_job_id_.fetch_add(1u, std::memory_order_relaxed));
+    }
+
+    IRIS_TRACE_JOB(fiber->is_started() ? JobTraceEventType::WAKE : JobTraceEventType::ENQUEUE, fiber->id(), 0u);
+
+    if (state.job_system == this)
+    {
+        queues_[priority][state.index]->push(fiber);
+    }
+    else
+    {
+        // the shared queue is bounded, if it fills up (e.g. all workers are
+        // busy) then we spill rather than block the caller
+        if (!fibers_[priority].try_enqueue(fiber))
+        {
+            overflow_[priority].enqueue(fiber);
+        }
+    }
+}
+
+void FiberJobSystem::wake_workers(std::size_t count)
+{
+    // this pairs with park: either we see a worker that is about to sleep or
+    // it sees the new epoch and does not sleep
+    work_epoch_.fetch_add(1u);
+    const auto sleepers = sleepers_.load();
 
-            fibers_.enqueue(fibers.back().get(), nullptr);
-            jobs_semaphore_.release();
+    // busy and spinning workers will find the fibers themselves
+    if ((sleepers == 0u) || (count == 0u))
+    {
+        return;
+    }
+
+    last_wake_.store(now_ns(), std::memory_order_relaxed);
+
+    if (count >= sleepers)
+    {
+        work_epoch_.notify_all();
+        wake_calls_.fetch_add(1u, std::memory_order_relaxed);
+    }
+    else
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            work_epoch_.notify_one();
         }
+        wake_calls_.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void FiberJobSystem::park(std::uint32_t epoch)
+{
+    sleepers_.fetch_add(1u);
+    parks_.fetch_add(1u, std::memory_order_relaxed);
+
+    const auto parked_at = now_ns();
+
+    // returns immediately if anything was enqueued since the epoch was read
+    work_epoch_.wait(epoch);
+
+    sleepers_.fetch_sub(1u);
+
+    // we may have returned without ever sleeping, or been woken by a stop, in
+    // which case the last wake (if any) has nothing to do with us
+    if (const auto woken_at = last_wake_.load(std::memory_order_relaxed); woken_at >= parked_at)
+    {
+        wakeups_.fetch_add(1u, std::memory_order_relaxed);
+        wake_latency_ns_.fetch_add(static_cast<std::uint64_t>(now_ns() - woken_at), std::memory_order_relaxed);
+    }
+}
+
+std::size_t FiberJobSystem::pool_cache() const
+{
+    const auto &state = worker_state();
+    return (state.job_system == this) ? state.index : pool_.shared_cache();
+}
+
+FiberJobSystem *FiberJobSystem::current()
+{
+    return worker_state().job_system;
+}
+
+FiberJobSystemStats FiberJobSystem::stats() const
+{
+    return {
+        dequeues_.load(std::memory_order_relaxed),
+        starts_.load(std::memory_order_relaxed),
+        resumes_.load(std::memory_order_relaxed),
+        parks_.load(std::memory_order_relaxed),
+        wake_calls_.load(std::memory_order_relaxed),
+        wakeups_.load(std::memory_order_relaxed),
+        wake_latency_ns_.load(std::memory_order_relaxed),
+        pool_.stats()};
+}
+
+void FiberJobSystem::job_thread(std::size_t index)
+{
+    Fiber::thread_to_fiber();
+
+    auto &state = worker_state();
+    state = {this, index, static_cast<std::uint32_t>(index + 1u) * 2654435761u, 0u};
+
+    LOG_DEBUG("job_system", "{} thread start [{}]", index, (void *)*Fiber::this_fiber());
+    IRIS_TRACE_THREAD_NAME("fiber worker " + std::to_string(index));
 
-        // mark current fiber as unsafe (so another thread doesn't preemptively
-        // try to resume it), stick it on the queue
-        (*Fiber::this_fiber())->set_unsafe();
-        fibers_.enqueue(*Fiber::this_fiber(), counter.get());
-        jobs_semaphore_.release();
+    const auto find = [this, &state](Fiber *&fiber)
+    { return find_fiber(state, worker_nodes_, queues_, fibers_, overflow_, fiber); };
 
-        // suspend current thread - this will internally mark the fiber as safe
-        (*Fiber::this_fiber())->suspend();
+    while (running_)
+    {
+        // look for work, getting progressively more relaxed about it
+        Fiber *fiber = nullptr;
+        auto found = false;
 
-        // the above line will not return
-        // if we get there then all children jobs have finished and resume has
-        // been called
+        for (auto i = 0u; !found && (i < idle_.spin_count); ++i)
+        {
+            found = find(fiber);
+            if (!found)
+            {
+                cpu_relax();
+            }
+        }
 
-        std::exception_ptr job_exception;
+        for (auto i = 0u; !found && (i < idle_.yield_count); ++i)
+        {
+            found = find(fiber);
+            if (!found)
+            {
+                std::this_thread::yield();
+            }
+        }
 
-        for (const auto &fiber : fibers)
+        while (!found && running_)
         {
-            // find first exception that was throw, first come first served
-            if ((fiber->exception() != nullptr) && !job_exception)
+            // the epoch must be read before the final look, so anything
+            // enqueued after that look will stop us parking
+            const auto epoch = work_epoch_.load();
+            found = find(fiber);
+
+            if (!found && running_)
             {
-                job_exception = fiber->exception();
-                break;
+                park(epoch);
             }
         }
 
-        if (job_exception)
+        if (!found)
+        {
+            break;
+        }
+
+        dequeues_.fetch_add(1u, std::memory_order_relaxed);
+
+        // we cannot safely use a fiber whilst it is resuming
+        // as a fiber should never be in the resuming state for long (the time
+        // it takes to suspend and return to previous context) we use a
+        // primitive spin lock
+        while (!fiber->is_safe())
+        {
+        }
+
+        // only runnable fibers are ever queued, so either this is the first
+        // time we are seeing this fiber or its wait has completed
+        // if the fiber suspends it may already be running elsewhere when we
+        // get control back, so read its id whilst we still own it
+        [[maybe_unused]] const auto id = fiber->id();
+
+        auto finished = false;
+        if (!fiber->is_started())
+        {
+            starts_.fetch_add(1u, std::memory_order_relaxed);
+            IRIS_TRACE_JOB(JobTraceEventType::START, id, 0u);
+            finished = fiber->start();
+        }
+        else
+        {
+            resumes_.fetch_add(1u, std::memory_order_relaxed);
+            IRIS_TRACE_JOB(JobTraceEventType::RESUME, id, 0u);
+            finished = fiber->resume();
+        }
+
+        IRIS_TRACE_JOB(finished ? JobTraceEventType::END : JobTraceEventType::SUSPEND, id, 0u);
+
+        if (finished)
         {
-            std::rethrow_exception(job_exception);
+            if (auto *counter = fiber->counter(); counter != nullptr)
+            {
+                // fiber is owned by whoever is waiting on it and may be
+                // destroyed as soon as the counter reaches zero, so don't
+                // touch it after this point
+                // if we were the last child then make any waiting fibers
+                // runnable
+                auto *waiter = counter->decrement();
+                auto woken = 0u;
+                while (waiter != nullptr)
+                {
+                    auto *next = waiter->next_waiter();
+                    enqueue(waiter);
+                    waiter = next;
+                    ++woken;
+                }
+
+                if (woken != 0u)
+                {
+                    wake_workers(woken);
+                }
+            }
+            else
+            {
+                // nothing is waiting on us then we were a fire-and-forget job
+                // so need to cleanup
+                pool_.release(index, fiber);
+            }
         }
     }
+
+    LOG_DEBUG("job_system", "{} thread end [{}]", index, (void *)*Fiber::this_fiber());
+
+    state = {nullptr, 0u, 0u, 0u};
+
+    // safe to cleanup fiber we created for thread
+    delete *Fiber::this_fiber();
+    *Fiber::this_fiber() = nullptr;
 }
 
 }
@@ -7,11 +7,14 @@
 #include "jobs/fiber/fiber_job_system_manager.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "core/error_handling.h"
 #include "jobs/fiber/fiber_job_system.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 #include "jobs/job_system_manager.h"
 
 namespace iris
@@ -25,13 +28,23 @@ JobSystem *FiberJobSystemManager::create_job_system()
     return job_system_.get();
 }
 
-void FiberJobSystemManager::add(const std::vector<Job> &jobs)
+void FiberJobSystemManager::add(const std::vector<Job> &jobs, JobPriority priority)
 {
-    job_system_->add_jobs(jobs);
+    job_system_->add_jobs(jobs, priority);
 }
 
-void FiberJobSystemManager::wait(const std::vector<Job> &jobs)
+void FiberJobSystemManager::add(std::vector<InplaceJob> &&jobs, JobPriority priority)
 {
-    job_system_->wait_for_jobs(jobs);
+    job_system_->add_jobs(std::move(jobs), priority);
+}
+
+void FiberJobSystemManager::wait(const std::vector<Job> &jobs, JobPriority priority)
+{
+    job_system_->wait_for_jobs(jobs, priority);
+}
+
+void FiberJobSystemManager::wait(std::vector<InplaceJob> &&jobs, JobPriority priority)
+{
+    job_system_->wait_for_jobs(std::move(jobs), priority);
 }
 }
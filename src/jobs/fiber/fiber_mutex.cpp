@@ -0,0 +1,60 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_mutex.h"
+
+#include <mutex>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+FiberMutex::FiberMutex()
+    : guard_()
+    , locked_(false)
+    , waiters_()
+{
+}
+
+void FiberMutex::lock()
+{
+    std::unique_lock lock(guard_);
+
+    // the mutex is not handed off directly to a woken waiter, so someone else
+    // may get it first and we have to go round again
+    while (locked_)
+    {
+        waiters_.wait(lock);
+    }
+
+    locked_ = true;
+}
+
+bool FiberMutex::try_lock()
+{
+    std::unique_lock lock(guard_);
+
+    if (locked_)
+    {
+        return false;
+    }
+
+    locked_ = true;
+    return true;
+}
+
+void FiberMutex::unlock()
+{
+    std::unique_lock lock(guard_);
+
+    expect(locked_, "mutex not locked");
+
+    locked_ = false;
+    waiters_.notify_one();
+}
+
+}
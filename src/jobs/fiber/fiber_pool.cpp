@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/counter.h"
+#include "jobs/fiber/fiber.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
+
+namespace
+{
+
+/**
+ * Create per priority stack sizes that are all the same.
+ *
+ * @param stack_pages
+ *   Number of usable pages for each fibers stack.
+ *
+ * @returns
+ *   Stack pages for each priority.
+ */
+std::array<std::size_t, iris::job_priority_count> uniform_stack_pages(std::size_t stack_pages)
+{
+    std::array<std::size_t, iris::job_priority_count> pages{};
+    pages.fill(stack_pages);
+
+    return pages;
+}
+
+/**
+ * Atomically raise a value to at least a new value.
+ *
+ * @param value
+ *   Value to update.
+ *
+ * @param candidate
+ *   New value, stored if larger than the current one.
+ */
+template <class T>
+void update_max(std::atomic<T> &value, T candidate)
+{
+    auto current = value.load(std::memory_order_relaxed);
+    while ((candidate > current) && !value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+    {
+    }
+}
+
+}
+
+namespace iris
+{
+
+FiberPool::FiberPool(std::size_t cache_count, std::size_t stack_pages, std::size_t max_pooled)
+    : FiberPool(cache_count, uniform_stack_pages(stack_pages), max_pooled, false)
+{
+}
+
+FiberPool::FiberPool(
+    std::size_t cache_count,
+    const std::array<std::size_t, job_priority_count> &stack_pages,
+    std::size_t max_pooled,
+    bool paint_stacks)
+    : class_pages_()
+    , priority_classes_()
+    , paint_stacks_(paint_stacks)
+    , cache_capacity_(max_pooled / (cache_count + 1u))
+    , caches_()
+    , hits_(0u)
+    , misses_(0u)
+    , live_(0u)
+    , peak_live_(0u)
+    , stack_high_water_()
+{
+    // priorities with the same stack size share pooled fibers
+    for (auto i = 0u; i < stack_pages.size(); ++i)
+    {
+        auto size_class = std::find(class_pages_.begin(), class_pages_.end(), stack_pages[i]);
+        if (size_class == std::end(class_pages_))
+        {
+            size_class = class_pages_.insert(class_pages_.end(), stack_pages[i]);
+        }
+
+        priority_classes_[i] = static_cast<std::size_t>(std::distance(class_pages_.begin(), size_class));
+    }
+
+    for (auto i = 0u; i < cache_count + 1u; ++i)
+    {
+        caches_.emplace_back(std::make_unique<Cache>());
+        caches_.back()->fibers.resize(class_pages_.size());
+
+        for (auto &fibers : caches_.back()->fibers)
+        {
+            fibers.reserve(cache_capacity_);
+        }
+    }
+}
+
+FiberPool::~FiberPool()
+{
+    for (auto &cache : caches_)
+    {
+        for (auto &fibers : cache->fibers)
+        {
+            for (auto *fiber : fibers)
+            {
+                delete fiber;
+            }
+        }
+    }
+}
+
+Fiber *FiberPool::acquire(std::size_t cache, InplaceJob job, Counter *counter, JobPriority priority)
+{
+    expect(cache < caches_.size(), "invalid cache");
+
+    const auto size_class = priority_classes_[static_cast<std::size_t>(priority)];
+    auto *fiber = try_pop(*caches_[cache], size_class);
+
+    if ((fiber == nullptr) && (cache != shared_cache()))
+    {
+        fiber = try_pop(*caches_[shared_cache()], size_class);
+    }
+
+    if (fiber != nullptr)
+    {
+        hits_.fetch_add(1u, std::memory_order_relaxed);
+        fiber->reset(std::move(job), counter);
+    }
+    else
+    {
+        misses_.fetch_add(1u, std::memory_order_relaxed);
+        fiber = new Fiber{std::move(job), counter, class_pages_[size_class]};
+
+        if (paint_stacks_)
+        {
+            fiber->paint_stack();
+        }
+    }
+
+    fiber->set_priority(priority);
+    fiber->pool_cache_ = cache;
+
+    // update high water mark
+    update_max(peak_live_, live_.fetch_add(1u, std::memory_order_relaxed) + 1u);
+
+    return fiber;
+}
+
+void FiberPool::release(std::size_t cache, Fiber *fiber)
+{
+    expect(cache < caches_.size(), "invalid cache");
+
+    live_.fetch_sub(1u, std::memory_order_relaxed);
+
+    const auto priority = static_cast<std::size_t>(fiber->priority());
+    const auto high_water = fiber->stack_high_water();
+
+    // destroy captures now rather than when the fiber is next used, they may
+    // refer to memory (e.g. a JobArena) which is about to be reclaimed
+    fiber->reset(nullptr, nullptr);
+
+    if (paint_stacks_)
+    {
+        update_max(stack_high_water_[priority], high_water);
+        fiber->paint_stack();
+    }
+
+    // fibers acquired through the shared cache go back to it, otherwise jobs
+    // added from outside the job system would never find a pooled fiber as
+    // they are always released by workers
+    if (fiber->pool_cache_ == shared_cache())
+    {
+        cache = shared_cache();
+    }
+
+    {
+        auto &fibers = caches_[cache]->fibers[size_class(fiber)];
+        std::unique_lock lock(caches_[cache]->mutex);
+
+        if (fibers.size() < cache_capacity_)
+        {
+            fibers.emplace_back(fiber);
+            return;
+        }
+    }
+
+    // cache is full
+    delete fiber;
+}
+
+std::size_t FiberPool::shared_cache() const
+{
+    return caches_.size() - 1u;
+}
+
+FiberPoolStats FiberPool::stats() const
+{
+    FiberPoolStats stats{
+        hits_.load(std::memory_order_relaxed),
+        misses_.load(std::memory_order_relaxed),
+        live_.load(std::memory_order_relaxed),
+        peak_live_.load(std::memory_order_relaxed),
+        {}};
+
+    for (auto i = 0u; i < stack_high_water_.size(); ++i)
+    {
+        stats.stack_high_water[i] = stack_high_water_[i].load(std::memory_order_relaxed);
+    }
+
+    return stats;
+}
+
+Fiber *FiberPool::try_pop(Cache &cache, std::size_t size_class)
+{
+    Fiber *fiber = nullptr;
+
+    std::unique_lock lock(cache.mutex);
+    auto &fibers = cache.fibers[size_class];
+
+    if (!fibers.empty())
+    {
+        fiber = fibers.back();
+        fibers.pop_back();
+    }
+
+    return fiber;
+}
+
+std::size_t FiberPool::size_class(const Fiber *fiber) const
+{
+    const auto size_class = std::find(class_pages_.begin(), class_pages_.end(), fiber->stack_pages());
+    expect(size_class != std::end(class_pages_), "fiber not from this pool");
+
+    return static_cast<std::size_t>(std::distance(class_pages_.begin(), size_class));
+}
+
+}
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_semaphore.h"
+
+#include <cstddef>
+#include <mutex>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+FiberSemaphore::FiberSemaphore(std::ptrdiff_t initial)
+    : guard_()
+    , count_(initial)
+    , waiters_()
+{
+    expect(initial >= 0, "initial count must be non-negative");
+}
+
+void FiberSemaphore::acquire()
+{
+    std::unique_lock lock(guard_);
+
+    while (count_ == 0)
+    {
+        waiters_.wait(lock);
+    }
+
+    --count_;
+}
+
+bool FiberSemaphore::try_acquire()
+{
+    std::unique_lock lock(guard_);
+
+    if (count_ == 0)
+    {
+        return false;
+    }
+
+    --count_;
+    return true;
+}
+
+void FiberSemaphore::release(std::ptrdiff_t update)
+{
+    expect(update >= 0, "update must be non-negative");
+
+    std::unique_lock lock(guard_);
+
+    count_ += update;
+
+    for (auto i = std::ptrdiff_t{0}; i < update; ++i)
+    {
+        if (!waiters_.notify_one())
+        {
+            break;
+        }
+    }
+}
+
+}
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/fiber/fiber_wait_queue.h"
+
+#include <condition_variable>
+#include <mutex>
+
+#include "core/error_handling.h"
+#include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_job_system.h"
+
+namespace iris
+{
+
+FiberWaitQueue::FiberWaitQueue()
+    : head_(nullptr)
+    , tail_(nullptr)
+    , condition_()
+{
+}
+
+void FiberWaitQueue::wait(std::unique_lock<std::mutex> &lock)
+{
+    expect(lock.owns_lock(), "lock must be held");
+
+    auto *job_system = FiberJobSystem::current();
+    auto *fiber = (job_system == nullptr) ? nullptr : *Fiber::this_fiber();
+
+    Waiter waiter{fiber, job_system, false, nullptr};
+
+    if (tail_ == nullptr)
+    {
+        head_ = &waiter;
+    }
+    else
+    {
+        tail_->next = &waiter;
+    }
+    tail_ = &waiter;
+
+    if (fiber != nullptr)
+    {
+        // mark ourself as unsafe before anyone can see us, a notifier may
+        // reschedule us as soon as the lock is released and the worker that
+        // picks us up must not resume us until we have suspended
+        fiber->set_unsafe();
+        lock.unlock();
+
+        fiber->suspend();
+
+        // we may have been resumed on a different worker
+        lock.lock();
+    }
+    else
+    {
+        condition_.wait(lock, [&waiter] { return waiter.notified; });
+    }
+}
+
+bool FiberWaitQueue::notify_one()
+{
+    if (head_ == nullptr)
+    {
+        return false;
+    }
+
+    wake_front();
+    return true;
+}
+
+void FiberWaitQueue::notify_all()
+{
+    while (head_ != nullptr)
+    {
+        wake_front();
+    }
+}
+
+bool FiberWaitQueue::empty() const
+{
+    return head_ == nullptr;
+}
+
+void FiberWaitQueue::wake_front()
+{
+    auto *waiter = head_;
+
+    head_ = waiter->next;
+    if (head_ == nullptr)
+    {
+        tail_ = nullptr;
+    }
+
+    if (waiter->fiber != nullptr)
+    {
+        // copy out before scheduling, the waiter is invalid as soon as the
+        // fiber runs
+        auto *job_system = waiter->job_system;
+        auto *fiber = waiter->fiber;
+        waiter->notified = true;
+
+        job_system->schedule(fiber);
+    }
+    else
+    {
+        // we hold the lock so the waiter cannot observe the flag (and return)
+        // until we are done
+        waiter->notified = true;
+        condition_.notify_all();
+    }
+}
+
+}
@@ -6,18 +6,29 @@
 
 #include "jobs/fiber/fiber.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <exception>
 #include <memory>
+#include <utility>
 
 #include "core/error_handling.h"
 #include "core/static_buffer.h"
 #include "jobs/context.h"
-#include "jobs/job.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
 #include "log/log.h"
 
+// clang and gcc spell "do not optimise this function" differently, gcc warns
+// about (and ignores) optnone
+#if defined(__clang__)
+#define IRIS_NO_OPTIMISE __attribute__((noinline, optnone))
+#else
+#define IRIS_NO_OPTIMISE __attribute__((noinline, optimize("O0")))
+#endif
+
 extern "C"
 {
     // these will be defined with arch specific assembler
@@ -26,6 +37,14 @@ extern "C"
     extern void change_stack(void *stack);
 }
 
+namespace
+{
+
+// value unused stack is filled with when painting
+static constexpr auto stack_paint = std::byte{0xcd};
+
+}
+
 namespace iris
 {
 
@@ -33,6 +52,7 @@ struct Fiber::implementation
 {
     std::unique_ptr<StaticBuffer> stack_buffer;
     std::byte *stack;
+    bool painted = false;
     Context context;
     Context suspended_context;
 
@@ -46,7 +66,7 @@ struct Fiber::implementation
      * @param fiber
      *   Fiber to start.
      */
-    __attribute__((noinline, optnone)) static void do_start(Fiber *fiber)
+    IRIS_NO_OPTIMISE static void do_start(Fiber *fiber)
     {
         try
         {
@@ -74,7 +94,7 @@ struct Fiber::implementation
      * @param fiber
      *   Fiber to suspend.
      */
-    __attribute__((noinline, optnone)) static void do_suspend(Fiber *fiber)
+    IRIS_NO_OPTIMISE static void do_suspend(Fiber *fiber)
     {
         // no code between these lines
         // restoring this saved context will cause execution to continue from
@@ -96,7 +116,7 @@ struct Fiber::implementation
      *   Always returns 0 - this is to prevent tail-call optimisation which
      *   can mess up the assembly calls.
      */
-    __attribute__((noinline, optnone)) static int do_resume(Fiber *fiber)
+    IRIS_NO_OPTIMISE static int do_resume(Fiber *fiber)
     {
         // store context so we can resume from here once our job has finished
         save_context(&fiber->impl_->context);
@@ -106,35 +126,63 @@ struct Fiber::implementation
     }
 };
 
-Fiber::Fiber(Job job)
-    : Fiber(job, nullptr)
+Fiber::Fiber(InplaceJob job)
+    : Fiber(std::move(job), nullptr)
 {
 }
 
-Fiber::Fiber(Job job, Counter *counter)
-    : job_(nullptr)
+Fiber::Fiber(InplaceJob job, Counter *counter)
+    : Fiber(std::move(job), counter, 10u)
+{
+}
+
+Fiber::Fiber(InplaceJob job, Counter *counter, std::size_t stack_pages)
+    : job_(std::move(job))
     , counter_(counter)
     , parent_fiber_(nullptr)
     , exception_(nullptr)
     , safe_(true)
+    , started_(false)
+    , next_waiter_(nullptr)
+    , priority_(JobPriority::NORMAL)
+    , id_(0u)
+    , pool_cache_(0u)
+    , stack_pages_(stack_pages)
     , impl_(std::make_unique<implementation>())
 {
-    job_ = job;
+    expect(stack_pages >= 2u, "fiber stack too small");
 
-    impl_->stack_buffer = std::make_unique<StaticBuffer>(10u);
+    impl_->stack_buffer = std::make_unique<StaticBuffer>(stack_pages);
 
     // stack grows from high -> low memory so move our pointer down, not all the
     // way as we need some space to copy the previous stack frame
-    impl_->stack = *impl_->stack_buffer + (StaticBuffer::page_size() * 9);
+    impl_->stack = *impl_->stack_buffer + (StaticBuffer::page_size() * (stack_pages - 1u));
 }
 
 Fiber::~Fiber() = default;
 
-void Fiber::start()
+void Fiber::reset(InplaceJob job, Counter *counter)
+{
+    expect(safe_, "cannot reset suspended fiber");
+
+    // do_start always switches to the top of our stack, so there is nothing
+    // to do to reuse it
+    job_ = std::move(job);
+    counter_ = counter;
+    parent_fiber_ = nullptr;
+    exception_ = nullptr;
+    started_ = false;
+    next_waiter_ = nullptr;
+    priority_ = JobPriority::NORMAL;
+    id_ = 0u;
+}
+
+bool Fiber::start()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
     *this_fiber() = this;
+    started_ = true;
 
     // save our context and kick off the job, we will return from here when the
     // job is done (but possible on a different thread)
@@ -146,15 +194,10 @@ void Fiber::start()
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
         safe_ = true;
+        return false;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            (*counter_)--;
-        }
-    }
+
+    return true;
 }
 
 void Fiber::suspend()
@@ -171,7 +214,7 @@ void Fiber::suspend()
     }
 }
 
-void Fiber::resume()
+bool Fiber::resume()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
@@ -184,15 +227,10 @@ void Fiber::resume()
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
         safe_ = true;
+        return false;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            (*counter_)--;
-        }
-    }
+
+    return true;
 }
 
 bool Fiber::is_safe() const
@@ -205,11 +243,76 @@ void Fiber::set_unsafe()
     safe_ = false;
 }
 
+bool Fiber::is_started() const
+{
+    return started_;
+}
+
 bool Fiber::is_being_waited_on() const
 {
     return counter_ != nullptr;
 }
 
+Counter *Fiber::counter() const
+{
+    return counter_;
+}
+
+Fiber *Fiber::next_waiter() const
+{
+    return next_waiter_;
+}
+
+JobPriority Fiber::priority() const
+{
+    return priority_;
+}
+
+void Fiber::set_priority(JobPriority priority)
+{
+    priority_ = priority;
+}
+
+std::uint64_t Fiber::id() const
+{
+    return id_;
+}
+
+void Fiber::set_id(std::uint64_t id)
+{
+    id_ = id;
+}
+
+std::size_t Fiber::stack_pages() const
+{
+    return stack_pages_;
+}
+
+void Fiber::paint_stack()
+{
+    expect(safe_ && !started_, "cannot paint stack of running fiber");
+
+    // everything below where do_start switches to is free for the job
+    std::byte *bottom = *impl_->stack_buffer;
+    std::fill(bottom, impl_->stack, stack_paint);
+    impl_->painted = true;
+}
+
+std::size_t Fiber::stack_high_water() const
+{
+    if (!impl_->painted)
+    {
+        return 0u;
+    }
+
+    // the stack grows down, so the lowest overwritten byte is the deepest it
+    // got
+    std::byte *bottom = *impl_->stack_buffer;
+    const auto *deepest = std::find_if(bottom, impl_->stack, [](std::byte b) { return b != stack_paint; });
+
+    return static_cast<std::size_t>(impl_->stack - deepest);
+}
+
 std::exception_ptr Fiber::exception() const
 {
     return exception_;
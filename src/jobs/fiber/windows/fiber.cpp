@@ -7,13 +7,16 @@
 #include "jobs/fiber/fiber.h"
 
 #include <cassert>
+#include <cstddef>
 #include <exception>
+#include <utility>
 
 #include <Windows.h>
 
 #include "core/auto_release.h"
 #include "core/error_handling.h"
-#include "jobs/job.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
 
 namespace iris
 {
@@ -33,44 +36,68 @@ struct Fiber::implementation
      */
     static void job_runner(void *data)
     {
-
         auto *fiber = static_cast<Fiber *>(data);
-        *this_fiber() = fiber;
 
-        try
-        {
-            fiber->job_();
-        }
-        catch (...)
+        // a fiber may be reset and started again, each start will continue
+        // from the bottom of this loop
+        for (;;)
         {
-            // store any exceptions so it can possibly be rethrown later
-            if (fiber->exception_ == nullptr)
+            try
             {
-                fiber->exception_ = std::current_exception();
+                fiber->job_();
+            }
+            catch (...)
+            {
+                // store any exceptions so it can possibly be rethrown later
+                if (fiber->exception_ == nullptr)
+                {
+                    fiber->exception_ = std::current_exception();
+                }
             }
-        }
 
-        fiber->parent_fiber_->resume();
+            *this_fiber() = fiber->parent_fiber_;
+            ::SwitchToFiber(fiber->parent_fiber_->impl_->handle);
+        }
     }
 };
 #pragma optimize("", on)
 
-Fiber::Fiber(Job job)
-    : Fiber(job, nullptr)
+Fiber::Fiber(InplaceJob job)
+    : Fiber(std::move(job), nullptr)
 {
 }
 
-Fiber::Fiber(Job job, Counter *counter)
-    : job_()
+Fiber::Fiber(InplaceJob job, Counter *counter)
+    : Fiber(std::move(job), counter, 10u)
+{
+}
+
+Fiber::Fiber(InplaceJob job, Counter *counter, std::size_t stack_pages)
+    : job_(std::move(job))
     , counter_(counter)
     , parent_fiber_(nullptr)
     , exception_(nullptr)
     , safe_(true)
+    , started_(false)
+    , next_waiter_(nullptr)
+    , priority_(JobPriority::NORMAL)
+    , id_(0u)
+    , pool_cache_(0u)
+    , stack_pages_(stack_pages)
     , impl_(std::make_unique<Fiber::implementation>())
 {
-    job_ = job;
+    expect(stack_pages >= 2u, "fiber stack too small");
+
+    SYSTEM_INFO info{};
+    ::GetSystemInfo(&info);
+
     impl_->handle = {
-        ::CreateFiberEx(0, 0, FIBER_FLAG_FLOAT_SWITCH, implementation::job_runner, static_cast<void *>(this)),
+        ::CreateFiberEx(
+            0,
+            stack_pages * info.dwPageSize,
+            FIBER_FLAG_FLOAT_SWITCH,
+            implementation::job_runner,
+            static_cast<void *>(this)),
         ::DeleteFiber};
 
     expect(impl_->handle, "create fiber failed");
@@ -78,11 +105,27 @@ Fiber::Fiber(Job job, Counter *counter)
 
 Fiber::~Fiber() = default;
 
-void Fiber::start()
+void Fiber::reset(InplaceJob job, Counter *counter)
+{
+    expect(safe_, "cannot reset suspended fiber");
+
+    // job_runner loops, so the next start will pick up the new job
+    job_ = std::move(job);
+    counter_ = counter;
+    parent_fiber_ = nullptr;
+    exception_ = nullptr;
+    started_ = false;
+    next_waiter_ = nullptr;
+    priority_ = JobPriority::NORMAL;
+    id_ = 0u;
+}
+
+bool Fiber::start()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
     *this_fiber() = this;
+    started_ = true;
 
     // switch to fiber (this will kick-off the job)
     ::SwitchToFiber(impl_->handle);
@@ -92,15 +135,10 @@ void Fiber::start()
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
         safe_ = true;
+        return false;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            --(*counter_);
-        }
-    }
+
+    return true;
 }
 
 void Fiber::suspend()
@@ -117,7 +155,7 @@ void Fiber::suspend()
     }
 }
 
-void Fiber::resume()
+bool Fiber::resume()
 {
     // bookkeeping
     parent_fiber_ = *this_fiber();
@@ -130,15 +168,10 @@ void Fiber::resume()
         // we are no longer suspending if we are here i.e. it is now safe for
         // another thread to pick us up
         safe_ = true;
+        return false;
     }
-    else
-    {
-        // update counter if another fiber was waiting on us
-        if (counter_ != nullptr)
-        {
-            --(*counter_);
-        }
-    }
+
+    return true;
 }
 
 bool Fiber::is_safe() const
@@ -151,11 +184,61 @@ void Fiber::set_unsafe()
     safe_ = false;
 }
 
+bool Fiber::is_started() const
+{
+    return started_;
+}
+
 bool Fiber::is_being_waited_on() const
 {
     return counter_ != nullptr;
 }
 
+Counter *Fiber::counter() const
+{
+    return counter_;
+}
+
+Fiber *Fiber::next_waiter() const
+{
+    return next_waiter_;
+}
+
+JobPriority Fiber::priority() const
+{
+    return priority_;
+}
+
+void Fiber::set_priority(JobPriority priority)
+{
+    priority_ = priority;
+}
+
+std::uint64_t Fiber::id() const
+{
+    return id_;
+}
+
+void Fiber::set_id(std::uint64_t id)
+{
+    id_ = id;
+}
+
+std::size_t Fiber::stack_pages() const
+{
+    return stack_pages_;
+}
+
+void Fiber::paint_stack()
+{
+    // the stack is owned by CreateFiberEx, so there is nothing to paint
+}
+
+std::size_t Fiber::stack_high_water() const
+{
+    return 0u;
+}
+
 std::exception_ptr Fiber::exception() const
 {
     return exception_;
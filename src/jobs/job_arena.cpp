@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/job_arena.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+JobArena::JobArena(std::size_t capacity, std::pmr::memory_resource *upstream)
+    : upstream_(upstream)
+    , capacity_(capacity)
+    , buffer_(static_cast<std::byte *>(upstream->allocate(capacity, alignof(std::max_align_t))))
+    , offset_(0u)
+    , overflow_mutex_()
+    , overflow_(upstream)
+{
+}
+
+JobArena::~JobArena()
+{
+    upstream_->deallocate(buffer_, capacity_, alignof(std::max_align_t));
+}
+
+void *JobArena::allocate(std::size_t size, std::size_t alignment)
+{
+    expect((alignment != 0u) && ((alignment & (alignment - 1u)) == 0u), "alignment must be a power of two");
+
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer_);
+    auto offset = offset_.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        const auto aligned = ((base + offset + alignment - 1u) & ~(alignment - 1u)) - base;
+
+        if (aligned + size > capacity_)
+        {
+            break;
+        }
+
+        if (offset_.compare_exchange_weak(offset, aligned + size, std::memory_order_relaxed))
+        {
+            return buffer_ + aligned;
+        }
+    }
+
+    std::unique_lock lock(overflow_mutex_);
+    return overflow_.allocate(size, alignment);
+}
+
+void JobArena::reset()
+{
+    offset_ = 0u;
+
+    std::unique_lock lock(overflow_mutex_);
+    overflow_.release();
+}
+
+std::size_t JobArena::used() const
+{
+    return offset_.load(std::memory_order_relaxed);
+}
+
+}
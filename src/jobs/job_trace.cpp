@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/job_trace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(IRIS_ARCH_X86_64)
+#if defined(IRIS_PLATFORM_WIN32)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace
+{
+
+/**
+ * Check if the cpu has an invariant timestamp counter, i.e. one that ticks at
+ * a constant rate across all cores regardless of power state.
+ *
+ * @returns
+ *   True if the timestamp counter can be used as a clock, otherwise false.
+ */
+bool has_invariant_tsc()
+{
+#if defined(IRIS_ARCH_X86_64)
+#if defined(IRIS_PLATFORM_WIN32)
+    int registers[4]{};
+    ::__cpuid(registers, 0x80000000);
+    if (static_cast<unsigned int>(registers[0]) < 0x80000007u)
+    {
+        return false;
+    }
+
+    ::__cpuid(registers, 0x80000007);
+    const auto edx = static_cast<unsigned int>(registers[3]);
+#else
+    unsigned int eax = 0u;
+    unsigned int ebx = 0u;
+    unsigned int ecx = 0u;
+    unsigned int edx = 0u;
+
+    // this checks the leaf is supported
+    if (::__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return false;
+    }
+#endif
+
+    return (edx & (1u << 8u)) != 0u;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Check if events are timestamped with the timestamp counter.
+ *
+ * @returns
+ *   True if timestamp counter is used, otherwise false.
+ */
+bool use_tsc()
+{
+    static const auto use = has_invariant_tsc();
+    return use;
+}
+
+/**
+ * Read the time for an event. Clock calls are a large part of the cost of
+ * recording, so where possible this reads the raw timestamp counter and
+ * leaves converting to nanoseconds until export.
+ *
+ * @returns
+ *   Timestamp counter ticks if use_tsc(), otherwise steady clock nanoseconds.
+ */
+std::uint64_t read_timestamp()
+{
+#if defined(IRIS_ARCH_X86_64)
+    if (use_tsc())
+    {
+        return ::__rdtsc();
+    }
+#endif
+
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/**
+ * Write a string as a JSON string, escaping as required.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param str
+ *   String to write.
+ */
+void write_json_string(std::ostream &out, const std::string &str)
+{
+    out << '"';
+
+    for (const auto c : str)
+    {
+        switch (c)
+        {
+            case '"': out << R"(\")"; break;
+            case '\\': out << R"(\\)"; break;
+            case '\n': out << R"(\n)"; break;
+            case '\r': out << R"(\r)"; break;
+            case '\t': out << R"(\t)"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20u)
+                {
+                    // other control characters have no short form
+                    const auto flags = out.flags();
+                    const auto fill = out.fill();
+                    out << R"(\u)" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(static_cast<unsigned char>(c));
+                    out.flags(flags);
+                    out.fill(fill);
+                }
+                else
+                {
+                    out << c;
+                }
+        }
+    }
+
+    out << '"';
+}
+
+/**
+ * Ring buffer of events for a single thread. Only the owning thread writes.
+ */
+struct TraceBuffer
+{
+    /**
+     * Construct a new TraceBuffer.
+     *
+     * @param thread_id
+     *   Id to export thread with.
+     */
+    explicit TraceBuffer(std::uint32_t thread_id)
+        : events()
+        , head(0u)
+        , thread_id(thread_id)
+        , name("thread " + std::to_string(thread_id))
+    {
+    }
+
+    /**
+     * Copy out all events still in the buffer, oldest first.
+     *
+     * @param out
+     *   Vector to append events to.
+     */
+    void snapshot(std::vector<iris::JobTraceEvent> &out) const
+    {
+        const auto end = head.load(std::memory_order_acquire);
+        auto begin = (end > events.size()) ? end - events.size() : 0u;
+
+        std::vector<iris::JobTraceEvent> copied{};
+        copied.reserve(end - begin);
+
+        for (auto i = begin; i < end; ++i)
+        {
+            copied.emplace_back(events[i % events.size()]);
+        }
+
+        // anything the owner wrote over whilst we were copying is garbage
+        const auto new_end = head.load(std::memory_order_acquire);
+        const auto overwritten = (new_end > events.size()) ? new_end - events.size() : 0u;
+        const auto skip = (overwritten > begin) ? std::min<std::size_t>(overwritten - begin, copied.size()) : 0u;
+
+        out.insert(out.end(), copied.begin() + skip, copied.end());
+    }
+
+    /** Event storage. */
+    std::array<iris::JobTraceEvent, iris::JobTracer::buffer_capacity> events;
+
+    /** Total number of events ever written. */
+    std::atomic<std::size_t> head;
+
+    /** Id to export thread with. */
+    std::uint32_t thread_id;
+
+    /** Name to export thread with, guarded by registry mutex. */
+    std::string name;
+};
+
+/**
+ * All buffers ever created. Buffers are never freed so events from exited
+ * threads can still be exported.
+ */
+struct Registry
+{
+    /** Guards buffers and thread names. */
+    std::mutex mutex;
+
+    /** Per thread buffers. */
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+    /** Time events are exported relative to. */
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    /** Timestamp read at epoch, used to convert event timestamps on export. */
+    std::uint64_t epoch_timestamp = read_timestamp();
+
+    /** Number of frames marked. */
+    std::atomic<std::uint64_t> frames = 0u;
+};
+
+/**
+ * Get the registry.
+ *
+ * @returns
+ *   Reference to registry.
+ */
+Registry &registry()
+{
+    static Registry registry{};
+    return registry;
+}
+
+/**
+ * Get the buffer for the calling thread, creating it on first use.
+ *
+ * @returns
+ *   Reference to threads buffer.
+ */
+TraceBuffer &thread_buffer()
+{
+    thread_local TraceBuffer *buffer = []
+    {
+        auto &reg = registry();
+        std::unique_lock lock(reg.mutex);
+
+        reg.buffers.emplace_back(std::make_unique<TraceBuffer>(static_cast<std::uint32_t>(reg.buffers.size())));
+        return reg.buffers.back().get();
+    }();
+
+    return *buffer;
+}
+
+/**
+ * Write a single event as a Chrome trace event.
+ *
+ * @param out
+ *   Stream to write to.
+ *
+ * @param event
+ *   Event to write.
+ *
+ * @param thread_id
+ *   Id of thread event was recorded on.
+ */
+void write_event(std::ostream &out, const iris::JobTraceEvent &event, std::uint32_t thread_id)
+{
+    const char *name = "job";
+    const char *phase = "i";
+    const char *arg_name = nullptr;
+
+    switch (event.type)
+    {
+        case iris::JobTraceEventType::ENQUEUE: name = "enqueue"; break;
+        case iris::JobTraceEventType::START: phase = "B"; break;
+        case iris::JobTraceEventType::END: phase = "E"; break;
+        case iris::JobTraceEventType::SUSPEND: phase = "E"; break;
+        case iris::JobTraceEventType::RESUME:
+            name = "job (resumed)";
+            phase = "B";
+            break;
+        case iris::JobTraceEventType::WAKE: name = "wake"; break;
+        case iris::JobTraceEventType::STEAL:
+            name = "steal";
+            arg_name = "victim";
+            break;
+        case iris::JobTraceEventType::FRAME: name = "frame"; break;
+    }
+
+    out << R"({"name":")" << name << R"(","cat":"jobs","ph":")" << phase << R"(","ts":)"
+        << static_cast<double>(event.timestamp) / 1000.0 << R"(,"pid":0,"tid":)" << thread_id;
+
+    if (event.type == iris::JobTraceEventType::FRAME)
+    {
+        // frames are global, so draw them across all threads
+        out << R"(,"s":"g")";
+    }
+    else if (phase[0] == 'i')
+    {
+        out << R"(,"s":"t")";
+    }
+
+    out << R"(,"args":{"id":)" << event.id;
+    if (arg_name != nullptr)
+    {
+        out << R"(,")" << arg_name << R"(":)" << event.arg;
+    }
+    out << "}}";
+}
+
+}
+
+namespace iris
+{
+
+void JobTracer::record(JobTraceEventType type, std::uint64_t id, std::uint32_t arg)
+{
+    auto &buffer = thread_buffer();
+    const auto index = buffer.head.load(std::memory_order_relaxed);
+
+    buffer.events[index % buffer.events.size()] = {read_timestamp(), id, arg, type};
+    buffer.head.store(index + 1u, std::memory_order_release);
+}
+
+void JobTracer::set_thread_name(const std::string &name)
+{
+    auto &buffer = thread_buffer();
+    auto &reg = registry();
+
+    std::unique_lock lock(reg.mutex);
+    buffer.name = name;
+}
+
+void JobTracer::mark_frame()
+{
+    record(JobTraceEventType::FRAME, registry().frames.fetch_add(1u, std::memory_order_relaxed), 0u);
+}
+
+void JobTracer::write_chrome_trace(std::ostream &out, std::size_t frame_count)
+{
+    auto &reg = registry();
+    std::unique_lock lock(reg.mutex);
+
+    // work out how many nanoseconds each timestamp is from how far both have
+    // moved since the epoch
+    const auto now = std::chrono::steady_clock::now();
+    const auto now_timestamp = read_timestamp();
+    const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - reg.epoch).count();
+    const auto elapsed_timestamp = now_timestamp - reg.epoch_timestamp;
+    const auto ns_per_timestamp = (use_tsc() && (elapsed_timestamp != 0u))
+                                      ? static_cast<double>(elapsed_ns) / static_cast<double>(elapsed_timestamp)
+                                      : 1.0;
+
+    std::vector<std::vector<JobTraceEvent>> events(reg.buffers.size());
+    std::vector<std::uint64_t> frame_starts{};
+
+    for (auto i = 0u; i < reg.buffers.size(); ++i)
+    {
+        reg.buffers[i]->snapshot(events[i]);
+
+        for (auto &event : events[i])
+        {
+            // convert to nanoseconds since the epoch
+            const auto since_epoch =
+                (event.timestamp > reg.epoch_timestamp) ? event.timestamp - reg.epoch_timestamp : 0u;
+            event.timestamp = static_cast<std::uint64_t>(static_cast<double>(since_epoch) * ns_per_timestamp);
+
+            if (event.type == JobTraceEventType::FRAME)
+            {
+                frame_starts.emplace_back(event.timestamp);
+            }
+        }
+    }
+
+    // find the start of the oldest frame we want, if we don't have enough
+    // frames then write everything
+    std::uint64_t window_start = 0u;
+    if ((frame_count != 0u) && (frame_starts.size() >= frame_count))
+    {
+        std::sort(frame_starts.begin(), frame_starts.end());
+        window_start = frame_starts[frame_starts.size() - frame_count];
+    }
+
+    // timestamps are written in microseconds, keep nanosecond precision
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    auto first = true;
+    const auto separator = [&out, &first]
+    {
+        if (!first)
+        {
+            out << ",\n";
+        }
+        first = false;
+    };
+
+    for (auto i = 0u; i < reg.buffers.size(); ++i)
+    {
+        const auto &buffer = *reg.buffers[i];
+
+        separator();
+        out << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << buffer.thread_id << R"(,"args":{"name":)";
+        write_json_string(out, buffer.name);
+        out << "}}";
+
+        for (const auto &event : events[i])
+        {
+            if (event.timestamp >= window_start)
+            {
+                separator();
+                write_event(out, event, buffer.thread_id);
+            }
+        }
+    }
+
+    out << "]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}
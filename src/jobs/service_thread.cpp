@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/service_thread.h"
+
+#include <chrono>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "core/thread.h"
+#include "log/log.h"
+
+namespace iris
+{
+
+StopToken::StopToken(State *state)
+    : state_(state)
+{
+}
+
+bool StopToken::stop_requested() const
+{
+    std::unique_lock lock(state_->mutex);
+    return state_->stop_requested;
+}
+
+bool StopToken::wait_for(std::chrono::milliseconds timeout) const
+{
+    return wait_until(std::chrono::steady_clock::now() + timeout);
+}
+
+bool StopToken::wait_until(std::chrono::steady_clock::time_point time_point) const
+{
+    std::unique_lock lock(state_->mutex);
+    return state_->condition.wait_until(lock, time_point, [this]() { return state_->stop_requested; });
+}
+
+ServiceThread::ServiceThread(const std::string &name, Service service)
+    : name_(name)
+    , state_()
+    , running_(true)
+    , thread_(
+          [this, service = std::move(service)]()
+          {
+              LOG_ENGINE_INFO("service_thread", "{} started", name_);
+
+              try
+              {
+                  service(StopToken{&state_});
+              }
+              catch (const std::exception &e)
+              {
+                  // there's no one to rethrow to, so the best we can do is log
+                  LOG_ENGINE_ERROR("service_thread", "{} threw: {}", name_, e.what());
+              }
+              catch (...)
+              {
+                  LOG_ENGINE_ERROR("service_thread", "{} threw an unknown exception", name_);
+              }
+
+              running_ = false;
+
+              LOG_ENGINE_INFO("service_thread", "{} stopped", name_);
+          })
+{
+}
+
+ServiceThread::~ServiceThread()
+{
+    stop();
+}
+
+void ServiceThread::request_stop()
+{
+    {
+        std::unique_lock lock(state_.mutex);
+        state_.stop_requested = true;
+    }
+
+    state_.condition.notify_all();
+}
+
+void ServiceThread::stop()
+{
+    request_stop();
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+}
+
+bool ServiceThread::is_running() const
+{
+    return running_;
+}
+
+}
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/task_graph.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/error_handling.h"
+#include "jobs/job.h"
+#include "jobs/job_system_manager.h"
+
+namespace iris
+{
+
+TaskGraph::TaskGraph()
+    : nodes_()
+    , roots_()
+    , dirty_(false)
+    , jobs_manager_(nullptr)
+    , remaining_(0u)
+    , mutex_()
+    , condition_()
+    , complete_(true)
+    , exception_(nullptr)
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    // jobs refer to us, so don't go away whilst they are running, taking the
+    // lock also means the last job has finished signalling us
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this]() { return complete_.load(); });
+}
+
+TaskGraph::Node TaskGraph::add(Job job)
+{
+    expect(is_complete(), "cannot modify running graph");
+
+    const auto node = nodes_.size();
+
+    auto data = std::make_unique<NodeData>();
+    data->job = std::move(job);
+    data->predecessor_count = 0u;
+    data->pending = 0u;
+    data->launch = {[this, node]() { execute(node); }};
+
+    nodes_.emplace_back(std::move(data));
+    dirty_ = true;
+
+    return node;
+}
+
+void TaskGraph::precede(Node before, Node after)
+{
+    expect(is_complete(), "cannot modify running graph");
+    expect((before < nodes_.size()) && (after < nodes_.size()), "invalid node");
+    expect(before != after, "node cannot depend on itself");
+
+    nodes_[before]->successors.emplace_back(after);
+    ++nodes_[after]->predecessor_count;
+    dirty_ = true;
+}
+
+void TaskGraph::submit(JobSystemManager &jobs_manager)
+{
+    expect(is_complete(), "graph already running");
+
+    if (dirty_)
+    {
+        validate();
+    }
+
+    if (nodes_.empty())
+    {
+        return;
+    }
+
+    jobs_manager_ = &jobs_manager;
+
+    {
+        std::unique_lock lock(mutex_);
+        exception_ = nullptr;
+        complete_ = false;
+    }
+
+    for (auto &node : nodes_)
+    {
+        node->pending.store(node->predecessor_count, std::memory_order_relaxed);
+    }
+
+    remaining_.store(nodes_.size(), std::memory_order_release);
+
+    for (const auto root : roots_)
+    {
+        jobs_manager_->add(nodes_[root]->launch);
+    }
+}
+
+bool TaskGraph::is_complete() const
+{
+    return complete_;
+}
+
+void TaskGraph::wait()
+{
+    std::unique_lock lock(mutex_);
+    condition_.wait(lock, [this]() { return complete_.load(); });
+
+    if (exception_)
+    {
+        std::rethrow_exception(exception_);
+    }
+}
+
+void TaskGraph::execute(Node node)
+{
+    // rather than scheduling every ready successor we run one of them directly
+    // on this thread, this saves a trip through the job system for chains
+    // the graph may be destroyed as soon as another thread finishes the last
+    // node, so we can't read nodes_ to check for the end of the chain
+    const auto end = nodes_.size();
+
+    while (node != end)
+    {
+        auto &data = *nodes_[node];
+
+        try
+        {
+            data.job();
+        }
+        catch (...)
+        {
+            std::unique_lock lock(mutex_);
+
+            // store first exception, first come first served
+            if (!exception_)
+            {
+                exception_ = std::current_exception();
+            }
+        }
+
+        auto next = end;
+
+        for (const auto successor : data.successors)
+        {
+            if (nodes_[successor]->pending.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+            {
+                if (next == end)
+                {
+                    next = successor;
+                }
+                else
+                {
+                    jobs_manager_->add(nodes_[successor]->launch);
+                }
+            }
+        }
+
+        // last node to finish wakes anyone waiting, the graph may be destroyed
+        // or resubmitted as soon as we release the lock so we cannot touch it
+        // after
+        if (remaining_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        {
+            std::unique_lock lock(mutex_);
+            complete_ = true;
+            condition_.notify_all();
+            break;
+        }
+
+        node = next;
+    }
+}
+
+void TaskGraph::validate()
+{
+    roots_.clear();
+
+    for (auto i = 0u; i < nodes_.size(); ++i)
+    {
+        if (nodes_[i]->predecessor_count == 0u)
+        {
+            roots_.emplace_back(i);
+        }
+    }
+
+    // kahn's algorithm, if we can't visit every node there must be a cycle
+    std::vector<std::size_t> in_degree{};
+    for (const auto &node : nodes_)
+    {
+        in_degree.emplace_back(node->predecessor_count);
+    }
+
+    auto ready = roots_;
+    auto visited = 0u;
+
+    while (!ready.empty())
+    {
+        const auto node = ready.back();
+        ready.pop_back();
+        ++visited;
+
+        for (const auto successor : nodes_[node]->successors)
+        {
+            if (--in_degree[successor] == 0u)
+            {
+                ready.emplace_back(successor);
+            }
+        }
+    }
+
+    ensure(visited == nodes_.size(), "task graph contains a cycle");
+
+    dirty_ = false;
+}
+
+}
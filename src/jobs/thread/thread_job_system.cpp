@@ -6,49 +6,272 @@
 
 #include "jobs/thread/thread_job_system.h"
 
-#include <chrono>
-#include <future>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "core/thread.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_trace.h"
 #include "log/log.h"
 
 namespace iris
 {
 
 ThreadJobSystem::ThreadJobSystem()
-    : running_(true)
+    : ThreadJobSystem(0u)
 {
 }
 
-void ThreadJobSystem::add_jobs(const std::vector<Job> &jobs)
+ThreadJobSystem::ThreadJobSystem(std::size_t worker_count)
+    : mutex_()
+    , condition_()
+    , tasks_()
+    , task_count_(0u)
+    , picks_(0u)
+    , next_task_id_(0u)
+    , running_(true)
+    , workers_()
+{
+    const auto count =
+        (worker_count == 0u) ? std::max(1u, std::thread::hardware_concurrency() - 1u) : worker_count;
+
+    LOG_ENGINE_INFO("job_system", "creating {} threads", count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        workers_.emplace_back(&ThreadJobSystem::job_thread, this, i);
+    }
+}
+
+ThreadJobSystem::~ThreadJobSystem()
+{
+    {
+        std::unique_lock lock(mutex_);
+        running_ = false;
+    }
+
+    condition_.notify_all();
+
+    for (auto &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void ThreadJobSystem::add_jobs(const std::vector<Job> &jobs, JobPriority priority)
 {
-    for (const auto &job : jobs)
     {
-        // we cannot simply call std::async here as the std::future destructor
-        // will block and wait for the job to finish
-        // instead we create a shared_ptr for the future and copy it by value
-        // into the async task
-        // this ensures it keeps a reference to itself and won't go out of
-        // scope until the job is complete
-        auto future = std::make_shared<std::future<void>>();
+        std::unique_lock lock(mutex_);
+
+        for (const auto &job : jobs)
+        {
+            push_task(priority, InplaceJob{job}, nullptr);
+        }
 
-        *future = std::async(std::launch::async, [future, job] { job(); });
+        task_count_ += jobs.size();
     }
+
+    condition_.notify_all();
 }
 
-void ThreadJobSystem::wait_for_jobs(const std::vector<Job> &jobs)
+void ThreadJobSystem::add_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority)
 {
-    std::vector<std::future<void>> waiting_jobs{};
+    {
+        std::unique_lock lock(mutex_);
+
+        for (auto &job : jobs)
+        {
+            push_task(priority, std::move(job), nullptr);
+        }
+
+        task_count_ += jobs.size();
+    }
+
+    condition_.notify_all();
+}
+
+void ThreadJobSystem::wait_for_jobs(const std::vector<Job> &jobs, JobPriority priority)
+{
+    WaitGroup group{jobs.size(), nullptr};
+
+    std::unique_lock lock(mutex_);
 
     for (const auto &job : jobs)
     {
-        waiting_jobs.emplace_back(std::async(std::launch::async, job));
+        push_task(priority, InplaceJob{job}, &group);
+    }
+
+    task_count_ += jobs.size();
+
+    wait_for_group(lock, group);
+}
+
+void ThreadJobSystem::wait_for_jobs(std::vector<InplaceJob> &&jobs, JobPriority priority)
+{
+    WaitGroup group{jobs.size(), nullptr};
+
+    std::unique_lock lock(mutex_);
+
+    for (auto &job : jobs)
+    {
+        push_task(priority, std::move(job), &group);
+    }
+
+    task_count_ += jobs.size();
+
+    wait_for_group(lock, group);
+}
+
+void ThreadJobSystem::push_task(JobPriority priority, InplaceJob &&job, WaitGroup *group)
+{
+    const auto id = next_task_id_++;
+    IRIS_TRACE_JOB(JobTraceEventType::ENQUEUE, id, 0u);
+
+    auto &queue = tasks_[static_cast<std::size_t>(priority)];
+
+    // reuse the space of taken tasks rather than grow
+    if ((queue.head != 0u) && (queue.tasks.size() == queue.tasks.capacity()))
+    {
+        queue.tasks.erase(queue.tasks.begin(), queue.tasks.begin() + queue.head);
+        queue.head = 0u;
+    }
+
+    queue.tasks.push_back({std::move(job), group, id});
+}
+
+void ThreadJobSystem::wait_for_group(std::unique_lock<std::mutex> &lock, WaitGroup &group)
+{
+    condition_.notify_all();
+
+    // rather than block whilst our jobs run we help out by running queued
+    // jobs, these may not be ours but someone has to run them
+    // we take the newest, which is usually one of ours, if we took the oldest
+    // then a recursive split (e.g. parallel_for) would nest a wait for every
+    // queued job and overflow the stack
+    while (group.remaining != 0u)
+    {
+        if (task_count_ != 0u)
+        {
+            run_task(lock, true);
+        }
+        else
+        {
+            condition_.wait(lock, [this, &group]() { return (task_count_ != 0u) || (group.remaining == 0u); });
+        }
     }
 
-    for (auto &waiting_job : waiting_jobs)
+    lock.unlock();
+
+    if (group.exception)
     {
-        waiting_job.get();
+        std::rethrow_exception(group.exception);
     }
 }
+
+void ThreadJobSystem::run_task(std::unique_lock<std::mutex> &lock, bool newest)
+{
+    // take the first task in priority order, this is usually the most urgent
+    // but less urgent tasks get a regular chance to run
+    TaskQueue *queue = nullptr;
+    for (const auto priority : priority_order(picks_++))
+    {
+        queue = &tasks_[static_cast<std::size_t>(priority)];
+        if (queue->head != queue->tasks.size())
+        {
+            break;
+        }
+    }
+
+    Task task{};
+    if (newest)
+    {
+        task = std::move(queue->tasks.back());
+        queue->tasks.pop_back();
+    }
+    else
+    {
+        task = std::move(queue->tasks[queue->head++]);
+    }
+
+    // once empty start again from the front, clear keeps the storage
+    if (queue->head == queue->tasks.size())
+    {
+        queue->tasks.clear();
+        queue->head = 0u;
+    }
+
+    --task_count_;
+
+    lock.unlock();
+
+    std::exception_ptr exception;
+
+    IRIS_TRACE_JOB(JobTraceEventType::START, task.id, 0u);
+
+    try
+    {
+        task.job();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    IRIS_TRACE_JOB(JobTraceEventType::END, task.id, 0u);
+
+    // destroy captures before signalling the group, the waiter may free
+    // anything they refer to as soon as it wakes
+    task.job.reset();
+
+    lock.lock();
+
+    if (task.group != nullptr)
+    {
+        // store first exception, first come first served
+        if (exception && !task.group->exception)
+        {
+            task.group->exception = exception;
+        }
+
+        if (--task.group->remaining == 0u)
+        {
+            // wake up whoever is waiting on the group, we don't know which
+            // thread that is so wake everyone
+            condition_.notify_all();
+        }
+    }
+    else if (exception)
+    {
+        LOG_ENGINE_ERROR("job_system", "fire-and-forget job threw an exception");
+    }
+}
+
+void ThreadJobSystem::job_thread([[maybe_unused]] std::size_t index)
+{
+    IRIS_TRACE_THREAD_NAME("thread worker " + std::to_string(index));
+
+    std::unique_lock lock(mutex_);
+
+    for (;;)
+    {
+        condition_.wait(lock, [this]() { return !running_ || (task_count_ != 0u); });
+
+        if (!running_)
+        {
+            break;
+        }
+
+        run_task(lock);
+    }
+}
+
 }
@@ -7,10 +7,13 @@
 #include "jobs/thread/thread_job_system_manager.h"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "core/error_handling.h"
+#include "jobs/inplace_job.h"
 #include "jobs/job.h"
+#include "jobs/job_priority.h"
 #include "jobs/job_system_manager.h"
 #include "jobs/thread/thread_job_system.h"
 
@@ -19,20 +22,30 @@ namespace iris
 
 JobSystem *ThreadJobSystemManager::create_job_system()
 {
-    ensure(job_system_, "job system already created");
+    ensure(!job_system_, "job system already created");
 
     job_system_ = std::make_unique<ThreadJobSystem>();
     return job_system_.get();
 }
 
-void ThreadJobSystemManager::add(const std::vector<Job> &jobs)
+void ThreadJobSystemManager::add(const std::vector<Job> &jobs, JobPriority priority)
 {
-    job_system_->add_jobs(jobs);
+    job_system_->add_jobs(jobs, priority);
 }
 
-void ThreadJobSystemManager::wait(const std::vector<Job> &jobs)
+void ThreadJobSystemManager::add(std::vector<InplaceJob> &&jobs, JobPriority priority)
 {
-    job_system_->wait_for_jobs(jobs);
+    job_system_->add_jobs(std::move(jobs), priority);
+}
+
+void ThreadJobSystemManager::wait(const std::vector<Job> &jobs, JobPriority priority)
+{
+    job_system_->wait_for_jobs(jobs, priority);
+}
+
+void ThreadJobSystemManager::wait(std::vector<InplaceJob> &&jobs, JobPriority priority)
+{
+    job_system_->wait_for_jobs(std::move(jobs), priority);
 }
 
 }
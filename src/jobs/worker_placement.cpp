@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "jobs/worker_placement.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "core/cpu_topology.h"
+#include "core/error_handling.h"
+
+namespace iris
+{
+
+std::vector<WorkerSlot> place_workers(const CpuTopology &topology, const WorkerPlacement &placement)
+{
+    // reserving a cpu reserves its whole core, otherwise a worker would be
+    // competing with the reserved thread for the same execution units
+    std::set<std::size_t> reserved_cores{};
+    for (const auto &cpu : topology.cpus())
+    {
+        if (std::find(placement.reserved_cpus.begin(), placement.reserved_cpus.end(), cpu.id) !=
+            placement.reserved_cpus.end())
+        {
+            reserved_cores.emplace(cpu.core);
+        }
+    }
+
+    std::vector<LogicalCpu> usable{};
+    for (const auto &cpu : topology.cpus())
+    {
+        if (!reserved_cores.contains(cpu.core) && (cpu.primary || placement.use_smt_siblings))
+        {
+            usable.emplace_back(cpu);
+        }
+    }
+
+    ensure(!usable.empty(), "no cpus left for workers");
+
+    std::stable_sort(
+        usable.begin(),
+        usable.end(),
+        [](const auto &a, const auto &b)
+        { return std::make_tuple(a.node, !a.primary) < std::make_tuple(b.node, !b.primary); });
+
+    std::vector<WorkerSlot> slots{};
+    for (const auto &cpu : usable)
+    {
+        slots.push_back({cpu.id, cpu.node});
+    }
+
+    return slots;
+}
+
+}
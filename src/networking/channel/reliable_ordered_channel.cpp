@@ -7,108 +7,362 @@
 #include "networking/channel/reliable_ordered_channel.h"
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
 #include <vector>
 
+#include "core/data_buffer.h"
+#include "networking/channel/channel_type.h"
+#include "networking/data_buffer_deserialiser.h"
+#include "networking/data_buffer_serialiser.h"
 #include "networking/packet.h"
+#include "networking/packet_type.h"
+#include "networking/sequence.h"
+
+namespace
+{
+
+// retransmission timeout before any round trip time has been measured
+static constexpr auto initial_rto = std::chrono::microseconds(std::chrono::milliseconds(200));
+
+// bounds for the retransmission timeout
+static constexpr auto min_rto = std::chrono::microseconds(std::chrono::milliseconds(20));
+static constexpr auto max_rto = std::chrono::microseconds(std::chrono::seconds(2));
+
+// number of packets before an ack that are covered by its bitfield
+static constexpr auto ack_bits = 32u;
+
+// number of received packets that can be buffered, this has to hold every
+// fragment of a message else it could never be reassembled, and is a power of
+// two so sequence numbers map to the same slot across wraparound
+static constexpr auto reorder_window_size =
+    std::bit_ceil(std::max(iris::ReliableOrderedChannel::window_size, iris::Packet::max_fragments));
+
+}
 
 namespace iris
 {
 
 ReliableOrderedChannel::ReliableOrderedChannel()
     : Channel()
+    , send_window_()
     , next_receive_seq_(0u)
+    , yielded_count_(0u)
     , out_sequence_(0u)
+    , latest_receive_seq_(0u)
+    , ack_pending_(false)
+    , srtt_(0u)
+    , rttvar_(0u)
+    , rto_(initial_rto)
 {
+    static_assert(window_size <= ack_bits, "every packet in flight must be covered by an ack");
+    static_assert(reorder_window_size <= 32768u, "reorder window must be less than half the sequence space");
+
+    receive_queue_.resize(reorder_window_size);
 }
 
 void ReliableOrderedChannel::enqueue_send(Packet packet)
 {
-    // set sequence number of each packet to be once greater than the previous
-    packet.set_sequence(out_sequence_);
-    ++out_sequence_;
+    if (packet.packet_size() <= Packet::max_size)
+    {
+        // set sequence number of each packet to be once greater than the
+        // previous
+        packet.set_sequence(out_sequence_);
+        ++out_sequence_;
 
-    send_queue_.emplace_back(std::move(packet));
+        send_window_.push_back({std::move(packet), {}, 0u, false});
+    }
+    else
+    {
+        // packet is too large to send, so split it in to fragments which each
+        // get their own sequence number, this way they are acked and resent
+        // individually and always arrive in order
+        const auto *body = packet.body();
+        const auto size = packet.body_size();
+        const auto count = static_cast<std::uint8_t>((size + Packet::max_body_size - 1u) / Packet::max_body_size);
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto offset = i * Packet::max_body_size;
+            const auto fragment_size = std::min(Packet::max_body_size, size - offset);
+
+            Packet fragment{packet.type(), packet.channel(), DataBuffer(body + offset, body + offset + fragment_size)};
+            fragment.set_fragment(static_cast<std::uint8_t>(i), count);
+            fragment.set_sequence(out_sequence_);
+            ++out_sequence_;
+
+            send_window_.push_back({std::move(fragment), {}, 0u, false});
+        }
+    }
 }
 
 void ReliableOrderedChannel::enqueue_receive(Packet packet)
+{
+    enqueue_receive(std::move(packet), std::chrono::steady_clock::now());
+}
+
+void ReliableOrderedChannel::enqueue_receive(Packet packet, std::chrono::steady_clock::time_point now)
 {
     if (packet.type() == PacketType::ACK)
     {
-        // we got an ack so remove the corresponding packet from the send queue
-        // also use the opportunity to purge acks we've sent from the send queue
-        send_queue_.erase(
-            std::remove_if(
-                std::begin(send_queue_),
-                std::end(send_queue_),
-                [&packet](const Packet &p)
-                { return (p.type() == PacketType::ACK) || (p.sequence() == packet.sequence()); }),
-            std::end(send_queue_));
+        // we got an ack, which covers the packet with its sequence number and
+        // any of the previous packets with their bit set
+        std::uint32_t bits = 0u;
+        if (packet.body_size() >= sizeof(bits))
+        {
+            DataBufferDeserialiser deserialiser{packet.body_buffer()};
+            bits = deserialiser.pop<std::uint32_t>();
+        }
+
+        ack(packet.sequence(), now);
+
+        for (auto i = 0u; i < ack_bits; ++i)
+        {
+            if ((bits & (1u << i)) != 0u)
+            {
+                ack(static_cast<std::uint16_t>(packet.sequence() - i - 1u), now);
+            }
+        }
+
+        // slide the window past everything that has been acked
+        while (!send_window_.empty() && send_window_.front().acked)
+        {
+            send_window_.pop_front();
+        }
     }
     else
     {
         // we got non-ack i.e. something we will want to yield
 
+        // distance of packet from the one we are expecting, this wraps so
+        // anything before will be a large value
+        const auto offset = static_cast<std::uint16_t>(packet.sequence() - next_receive_seq_);
+
         // we only care about packets which are the one we are expecting or
-        // after, anything before will have been yielded
-        if (packet.sequence() >= next_receive_seq_)
+        // after (and within the window), anything before will have been
+        // yielded
+        if (offset < reorder_window_size)
         {
-            // calculate index of packet into our receive queue
-            const auto index = packet.sequence() - next_receive_seq_;
-
-            // if index is larger than queue then grow the queue
-            if (index >= receive_queue_.size())
+            if (sequence_greater_than(packet.sequence(), latest_receive_seq_))
             {
-                receive_queue_.resize(receive_queue_.size() + index + 1u);
+                latest_receive_seq_ = packet.sequence();
             }
 
-            // if this is a new packet i.e. not a duplicate then put it in the
-            // queue
-            if (!receive_queue_[index].is_valid())
+            // if this is a new packet i.e. not a duplicate then put it in its
+            // slot in the ring
+            auto &buffered = slot(packet.sequence());
+            if (!buffered.is_valid())
             {
-                receive_queue_[index] = packet;
+                buffered = std::move(packet);
             }
         }
 
-        // always send an ack, this is because acks aren't reliable so we may
-        // keep receiving the same packet until an ack finally makes it
+        // always ack, this is because acks aren't reliable so we may keep
+        // receiving the same packet until an ack finally makes it
         // this is why we discard duplicates but still ack
-        Packet ack{PacketType::ACK, ChannelType::RELIABLE_ORDERED, {}};
-        ack.set_sequence(packet.sequence());
-        send_queue_.emplace_back(std::move(ack));
+        ack_pending_ = true;
     }
 }
 
 std::vector<Packet> ReliableOrderedChannel::yield_send_queue()
 {
-    // note that we don't yield the queue but return a copy, this is because
-    // we want to keep sending packets until we receive an ack
+    return yield_send_queue(std::chrono::steady_clock::now());
+}
+
+std::vector<Packet> ReliableOrderedChannel::yield_send_queue(std::chrono::steady_clock::time_point now)
+{
+    std::vector<Packet> packets{};
+
+    // send a single ack for everything received since the last yield
+    if (ack_pending_)
+    {
+        std::uint32_t bits = 0u;
+        for (auto i = 0u; i < ack_bits; ++i)
+        {
+            if (received(static_cast<std::uint16_t>(latest_receive_seq_ - i - 1u)))
+            {
+                bits |= (1u << i);
+            }
+        }
+
+        DataBufferSerialiser serialiser{};
+        serialiser.push(bits);
+
+        Packet ack{PacketType::ACK, ChannelType::RELIABLE_ORDERED, serialiser.data()};
+        ack.set_sequence(latest_receive_seq_);
+        packets.emplace_back(std::move(ack));
+
+        ack_pending_ = false;
+    }
+
+    // send any packets in the window which are new or whose ack is overdue,
+    // backing off the timeout each time a packet is resent
+    const auto in_window = std::min(send_window_.size(), window_size);
+
+    for (auto i = 0u; i < in_window; ++i)
+    {
+        auto &entry = send_window_[i];
+        if (entry.acked)
+        {
+            continue;
+        }
+
+        const auto backoff = std::min(entry.sends, 6u);
+        const auto timeout = std::min(rto_ * (1u << backoff) / 2u, max_rto);
+
+        if ((entry.sends == 0u) || (now - entry.sent >= timeout))
+        {
+            packets.emplace_back(entry.packet);
+            entry.sent = now;
+            ++entry.sends;
+        }
+    }
 
-    return send_queue_;
+    return packets;
 }
 
 std::vector<Packet> ReliableOrderedChannel::yield_receive_queue()
 {
-    // find the first non-valid packet, everything before that will be a
-    // continuous range of valid packets ready to be yielded
-    const auto end_of_valid = std::find_if(
-        std::cbegin(receive_queue_),
-        std::cend(receive_queue_),
-        [](const Packet &element) { return !element.is_valid(); });
+    // count the valid packets from the one we are expecting, this is a
+    // continuous range of packets ready to be yielded
+    std::size_t end_of_valid = 0u;
+    while ((end_of_valid < reorder_window_size) && slot(next_receive_seq_ + end_of_valid).is_valid())
+    {
+        ++end_of_valid;
+    }
 
     std::vector<Packet> packets{};
+    std::size_t yielded = 0u;
 
-    if (end_of_valid != std::cbegin(receive_queue_))
+    // walk the valid packets a message at a time, a fragmented message can
+    // only be yielded once all of its fragments have arrived
+    while (yielded < end_of_valid)
     {
-        // move packets from queue to output collection
-        packets = std::vector<Packet>(std::cbegin(receive_queue_), end_of_valid);
-        receive_queue_.erase(std::begin(receive_queue_), end_of_valid);
+        auto &first = slot(next_receive_seq_ + yielded);
+        const auto count = std::max<std::size_t>(first.fragment_count(), 1u);
+
+        if (yielded + count > end_of_valid)
+        {
+            break;
+        }
+
+        if (count == 1u)
+        {
+            packets.emplace_back(std::move(first));
+        }
+        else
+        {
+            // reassemble the fragments in to a single packet
+            DataBuffer body{};
+            for (auto i = yielded; i < yielded + count; ++i)
+            {
+                const auto &fragment = slot(next_receive_seq_ + i);
+                body.insert(std::end(body), fragment.body(), fragment.body() + fragment.body_size());
+            }
+
+            Packet message{first.type(), first.channel(), body};
+            message.set_sequence(first.sequence());
+            packets.emplace_back(std::move(message));
+        }
 
-        // our next expected sequence number will be one greater than the last
-        // packet we yield
-        next_receive_seq_ = packets.back().sequence() + 1u;
+        // free up the slots for the packets that follow
+        for (auto i = yielded; i < yielded + count; ++i)
+        {
+            slot(next_receive_seq_ + i) = Packet{};
+        }
+
+        yielded += count;
     }
 
+    // our next expected sequence number will be one greater than the last
+    // packet we yield
+    next_receive_seq_ = static_cast<std::uint16_t>(next_receive_seq_ + yielded);
+    yielded_count_ += yielded;
+
     return packets;
 }
 
+std::chrono::microseconds ReliableOrderedChannel::rtt() const
+{
+    return srtt_;
+}
+
+std::chrono::microseconds ReliableOrderedChannel::rto() const
+{
+    return rto_;
+}
+
+void ReliableOrderedChannel::ack(std::uint16_t sequence, std::chrono::steady_clock::time_point now)
+{
+    if (send_window_.empty())
+    {
+        return;
+    }
+
+    // sequence numbers in the window are contiguous so we can index straight
+    // in, anything outside the window is stale
+    const auto index = static_cast<std::uint16_t>(sequence - send_window_.front().packet.sequence());
+    if (index >= std::min(send_window_.size(), window_size))
+    {
+        return;
+    }
+
+    auto &entry = send_window_[index];
+    if (entry.acked)
+    {
+        return;
+    }
+
+    entry.acked = true;
+
+    // only measure round trip time for packets sent once, as we can't tell
+    // which send of a resent packet is being acked
+    if (entry.sends == 1u)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - entry.sent);
+        const auto sample = std::max(elapsed, std::chrono::microseconds(1));
+
+        if (srtt_.count() == 0)
+        {
+            srtt_ = sample;
+            rttvar_ = sample / 2;
+        }
+        else
+        {
+            const auto error = srtt_ > sample ? srtt_ - sample : sample - srtt_;
+            rttvar_ = (rttvar_ * 3 + error) / 4;
+            srtt_ = (srtt_ * 7 + sample) / 8;
+        }
+
+        rto_ = std::clamp(srtt_ + rttvar_ * 4, min_rto, max_rto);
+    }
+}
+
+bool ReliableOrderedChannel::received(std::uint16_t sequence) const
+{
+    // everything before the next expected packet has been received (as long
+    // as we've got that far), after that we have to check if it is buffered
+    if (sequence_less_than(sequence, next_receive_seq_))
+    {
+        return static_cast<std::uint16_t>(next_receive_seq_ - sequence) <= yielded_count_;
+    }
+
+    const auto offset = static_cast<std::uint16_t>(sequence - next_receive_seq_);
+    return (offset < reorder_window_size) && slot(sequence).is_valid();
+}
+
+Packet &ReliableOrderedChannel::slot(std::size_t sequence)
+{
+    return receive_queue_[sequence % reorder_window_size];
+}
+
+const Packet &ReliableOrderedChannel::slot(std::size_t sequence) const
+{
+    return receive_queue_[sequence % reorder_window_size];
+}
+
 }
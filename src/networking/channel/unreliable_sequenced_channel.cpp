@@ -5,8 +5,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "networking/channel/unreliable_sequenced_channel.h"
+
+#include <cstdint>
 #include <vector>
 
+#include "core/error_handling.h"
+#include "networking/packet.h"
+#include "networking/sequence.h"
+
 namespace iris
 {
 
@@ -19,6 +25,10 @@ UnreliableSequencedChannel::UnreliableSequencedChannel()
 
 void UnreliableSequencedChannel::enqueue_send(Packet packet)
 {
+    // only the reliable channel can fragment, as a lost fragment would lose
+    // the whole message
+    ensure(packet.packet_size() <= Packet::max_size, "packet too large for unreliable channel");
+
     // set sequence number of each packet to be once greater than the previous
     packet.set_sequence(send_sequence_);
     send_queue_.emplace_back(std::move(packet));
@@ -29,13 +39,13 @@ void UnreliableSequencedChannel::enqueue_send(Packet packet)
 void UnreliableSequencedChannel::enqueue_receive(Packet packet)
 {
     // discard all packets that are behind the largest sequence number we've
-    // seen
-    if (packet.sequence() >= min_sequence_)
+    // seen, allowing for the sequence number wrapping
+    if (!sequence_less_than(packet.sequence(), min_sequence_))
     {
         receive_queue_.emplace_back(std::move(packet));
 
         // by always incrementing here we automatically drop duplicates
-        min_sequence_ = receive_queue_.back().sequence() + 1u;
+        min_sequence_ = static_cast<std::uint16_t>(receive_queue_.back().sequence() + 1u);
     }
 }
 
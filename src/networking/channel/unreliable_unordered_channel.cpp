@@ -6,11 +6,18 @@
 
 #include "networking/channel/unreliable_unordered_channel.h"
 
+#include "core/error_handling.h"
+#include "networking/packet.h"
+
 namespace iris
 {
 
 void UnreliableUnorderedChannel::enqueue_send(Packet packet)
 {
+    // only the reliable channel can fragment, as a lost fragment would lose
+    // the whole message
+    ensure(packet.packet_size() <= Packet::max_size, "packet too large for unreliable channel");
+
     send_queue_.emplace_back(std::move(packet));
 }
 
@@ -17,14 +17,15 @@
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "core/data_buffer.h"
 #include "core/error_handling.h"
-#include "core/root.h"
-#include "jobs/concurrent_queue.h"
-#include "jobs/job.h"
-#include "jobs/job_system_manager.h"
+#include "jobs/service_thread.h"
+#include "jobs/spsc_queue.h"
 #include "log/log.h"
 #include "networking/channel/channel.h"
 #include "networking/channel/reliable_ordered_channel.h"
@@ -33,11 +34,45 @@
 #include "networking/data_buffer_deserialiser.h"
 #include "networking/data_buffer_serialiser.h"
 #include "networking/packet.h"
+#include "networking/packet_coalescer.h"
 #include "networking/socket.h"
 
 namespace
 {
 
+// how long the reader thread blocks for before checking if it should stop
+static constexpr auto read_timeout = std::chrono::milliseconds(100);
+
+// how long the reader thread backs off for when a channel queue is full
+static constexpr auto full_queue_backoff = std::chrono::milliseconds(1);
+
+// how much data can be queued before it is sent without waiting for a flush
+static constexpr auto flush_threshold = iris::Packet::max_size;
+
+/**
+ * Coalesce packets in to as few datagrams as possible and write them.
+ *
+ * @param socket
+ *   Socket to write to.
+ *
+ * @param coalescer
+ *   Coalescer to use, will be cleared.
+ *
+ * @param packets
+ *   Packets to write.
+ */
+void write_packets(iris::Socket *socket, iris::PacketCoalescer &coalescer, const std::vector<iris::Packet> &packets)
+{
+    coalescer.add(packets);
+
+    for (auto i = 0u; i < coalescer.size(); ++i)
+    {
+        socket->write(coalescer[i].data(), coalescer[i].size());
+    }
+
+    coalescer.clear();
+}
+
 /**
  * Initiate and perform a handshake with the server.
  *
@@ -56,20 +91,18 @@ std::uint32_t handshake(iris::Socket *socket, iris::Channel *channel)
     channel->enqueue_send(hello);
 
     // send all packets
-    for (const auto &packet : channel->yield_send_queue())
-    {
-        socket->write(packet.data(), packet.packet_size());
-    }
+    iris::PacketCoalescer coalescer{};
+    write_packets(socket, coalescer, channel->yield_send_queue());
 
     // keep going until we complete handshake
     for (;;)
     {
-        // read a packet
-        const auto raw_packet = socket->read(sizeof(iris::Packet));
-        iris::Packet packet{raw_packet};
-
-        // enqueue the packet into the channel
-        channel->enqueue_receive(std::move(packet));
+        // read a datagram and enqueue its packets into the channel
+        const auto datagram = socket->read(iris::Packet::max_size);
+        for (auto &packet : iris::PacketCoalescer::split(datagram))
+        {
+            channel->enqueue_receive(std::move(packet));
+        }
 
         // get all received packets
         const auto responses = channel->yield_receive_queue();
@@ -89,7 +122,7 @@ std::uint32_t handshake(iris::Socket *socket, iris::Channel *channel)
         }
     }
 
-    iris::ensure(id == std::numeric_limits<std::uint32_t>::max(), "connection timeout");
+    iris::ensure(id != std::numeric_limits<std::uint32_t>::max(), "connection timeout");
 
     LOG_ENGINE_INFO("client_connection_handler", "i am: {}", id);
 
@@ -118,10 +151,8 @@ void handle_sync_start(iris::Channel *channel, iris::Socket *socket)
     channel->enqueue_send(std::move(response));
 
     // send all packets
-    for (const auto &packet : channel->yield_send_queue())
-    {
-        socket->write(packet.data(), packet.packet_size());
-    }
+    iris::PacketCoalescer coalescer{};
+    write_packets(socket, coalescer, channel->yield_send_queue());
 }
 
 /**
@@ -160,62 +191,103 @@ ClientConnectionHandler::ClientConnectionHandler(std::unique_ptr<Socket> socket)
     , lag_(0u)
     , channels_()
     , queues_()
+    , coalescer_()
+    , pending_bytes_(0u)
+    , mutex_()
+    , reader_()
 {
     // setup channels
     channels_[ChannelType::UNRELIABLE_UNORDERED] = std::make_unique<UnreliableUnorderedChannel>();
     channels_[ChannelType::UNRELIABLE_SEQUENCED] = std::make_unique<UnreliableSequencedChannel>();
     channels_[ChannelType::RELIABLE_ORDERED] = std::make_unique<ReliableOrderedChannel>();
 
-    queues_[ChannelType::UNRELIABLE_UNORDERED] = std::make_unique<ConcurrentQueue<DataBuffer>>();
-    queues_[ChannelType::UNRELIABLE_SEQUENCED] = std::make_unique<ConcurrentQueue<DataBuffer>>();
-    queues_[ChannelType::RELIABLE_ORDERED] = std::make_unique<ConcurrentQueue<DataBuffer>>();
+    queues_[ChannelType::UNRELIABLE_UNORDERED] = std::make_unique<SpscQueue<DataBuffer>>();
+    queues_[ChannelType::UNRELIABLE_SEQUENCED] = std::make_unique<SpscQueue<DataBuffer>>();
+    queues_[ChannelType::RELIABLE_ORDERED] = std::make_unique<SpscQueue<DataBuffer>>();
 
     id_ = handshake(socket_.get(), channels_[ChannelType::RELIABLE_ORDERED].get());
 
     LOG_ENGINE_INFO("client_connection_handler", "connected!");
 
-    // we want to continually read data as fast as possible, so we do reading in
-    // a background job
+    // we want to continually read data as fast as possible, so we do reading on
+    // a dedicated thread, keeping the blocking reads off the job system
     // this will handle any protocol packets and stick data into queues, which
     // can then be retrieved by calls to try_read
-    Root::jobs_manager().add(
-        {[this]()
-         {
-             for (;;)
-             {
-                 // block and read the next Packet
-                 const auto raw_packet = socket_->read(sizeof(Packet));
-                 iris::Packet packet{raw_packet};
-
-                 // enqueue the packet into the right channel
-                 const auto channel_type = packet.channel();
-                 auto *channel = channels_.at(channel_type).get();
-                 channel->enqueue_receive(std::move(packet));
-
-                 // handle all received packets from that channel
-                 for (const auto &p : channel->yield_receive_queue())
-                 {
-                     switch (p.type())
-                     {
-                         case PacketType::DATA:
-                             // we got data, stick it in the queue for this
-                             // channel
-                             queues_[channel_type]->enqueue(p.body_buffer());
-                             break;
-                         case PacketType::SYNC_START: handle_sync_start(channel, socket_.get()); break;
-                         case PacketType::SYNC_FINISH: lag_ = handle_sync_finish(packet); break;
-                         default:
-                             LOG_ERROR(
-                                 "client_connection_handler", "unknown packet type {}", static_cast<int>(p.type()));
-                             break;
-                     }
-                 }
-             }
-         }});
+    reader_ = std::make_unique<ServiceThread>(
+        "client_connection_handler",
+        [this](const StopToken &token)
+        {
+            while (!token.stop_requested())
+            {
+                // block and read the next datagram, the timeout means we
+                // regularly get a chance to check if we should stop
+                const auto datagram = socket_->read(Packet::max_size, read_timeout);
+                if (!datagram)
+                {
+                    continue;
+                }
+
+                for (auto &packet : PacketCoalescer::split(*datagram))
+                {
+                    handle_packet(std::move(packet), token);
+                }
+            }
+        });
+}
+
+ClientConnectionHandler::~ClientConnectionHandler() = default;
+
+void ClientConnectionHandler::handle_packet(Packet packet, const StopToken &token)
+{
+    // enqueue the packet into the right channel and collect everything that
+    // can now be yielded, the lock isn't held whilst handling them as we may
+    // have to wait for the caller to drain a queue
+    const auto channel_type = packet.channel();
+    auto *channel = channels_.at(channel_type).get();
+    std::vector<Packet> received{};
+
+    {
+        std::unique_lock lock(mutex_);
+        channel->enqueue_receive(std::move(packet));
+        received = channel->yield_receive_queue();
+    }
+
+    // handle all received packets from that channel
+    for (const auto &p : received)
+    {
+        switch (p.type())
+        {
+            case PacketType::DATA:
+            {
+                // we got data, stick it in the queue for this channel, if the
+                // queue is full then wait for it to be drained rather than
+                // drop data
+                auto buffer = p.body_buffer();
+                while (!queues_[channel_type]->try_enqueue(std::move(buffer)) && !token.stop_requested())
+                {
+                    token.wait_for(full_queue_backoff);
+                }
+                break;
+            }
+            case PacketType::SYNC_START:
+            {
+                std::unique_lock lock(mutex_);
+                handle_sync_start(channel, socket_.get());
+                break;
+            }
+            case PacketType::SYNC_FINISH: lag_ = handle_sync_finish(p); break;
+            default:
+                LOG_ERROR("client_connection_handler", "unknown packet type {}", static_cast<int>(p.type()));
+                break;
+        }
+    }
 }
 
 std::optional<DataBuffer> ClientConnectionHandler::try_read(ChannelType channel_type)
 {
+    // nothing more would ever be received, so don't let that go unnoticed
+    ensure(reader_->is_running(), "reader stopped");
+
     DataBuffer buffer;
 
     // try and read data from the supplied channel
@@ -224,28 +296,45 @@ std::optional<DataBuffer> ClientConnectionHandler::try_read(ChannelType channel_
 
 void ClientConnectionHandler::send(const DataBuffer &data, ChannelType channel_type)
 {
-    auto *channel = channels_[channel_type].get();
-
-    // wrap data in a Packet and enqueue
+    // wrap data in a Packet and enqueue, it gets sent on the next flush
     Packet packet{PacketType::DATA, channel_type, data};
-    channel->enqueue_send(std::move(packet));
 
-    // send all packets
-    for (const auto &p : channel->yield_send_queue())
+    std::unique_lock lock(mutex_);
+
+    pending_bytes_ += packet.packet_size();
+    channels_[channel_type]->enqueue_send(std::move(packet));
+
+    // once there is more than a datagram's worth queued there is nothing to
+    // gain from waiting, so send now
+    if (pending_bytes_ >= flush_threshold)
     {
-        socket_->write(p.data(), p.packet_size());
+        write_pending();
     }
 }
 
 void ClientConnectionHandler::flush()
 {
+    ensure(reader_->is_running(), "reader stopped");
+
+    std::unique_lock lock(mutex_);
+    write_pending();
+}
+
+void ClientConnectionHandler::write_pending()
+{
+    // coalesce packets (including acks) from all channels
     for (auto &[type, channel] : channels_)
     {
-        for (const auto &p : channel->yield_send_queue())
-        {
-            socket_->write(p.data(), p.packet_size());
-        }
+        coalescer_.add(channel->yield_send_queue());
+    }
+
+    for (auto i = 0u; i < coalescer_.size(); ++i)
+    {
+        socket_->write(coalescer_[i].data(), coalescer_[i].size());
     }
+
+    coalescer_.clear();
+    pending_bytes_ = 0u;
 }
 
 std::uint32_t ClientConnectionHandler::id() const
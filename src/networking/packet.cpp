@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <ostream>
 
 #include "core/data_buffer.h"
@@ -26,91 +27,158 @@ Packet::Packet()
 }
 
 Packet::Packet(PacketType type, ChannelType channel, const DataBuffer &body)
-    : header_(type, channel)
-    , body_()
-    , size_(body.size())
+    : buffer_(header_size + body.size())
 {
-    expect(body.size() <= sizeof(body_), "body too large");
+    // check the header has no padding, so it can be sent as is
+    static_assert(sizeof(Header) == header_size, "header has padding");
 
-    std::memcpy(body_, body.data(), body.size());
+    // fragment indices have to fit in the header
+    static_assert(
+        max_fragments <= std::numeric_limits<std::uint8_t>::max(), "mtu too small to fragment the largest message");
+
+    ensure(body.size() <= max_message_size, "body too large");
+
+    const Header header{type, channel, static_cast<std::uint16_t>(body.size())};
+    std::memcpy(buffer_.data(), &header, sizeof(header));
+    std::memcpy(buffer_.data() + header_size, body.data(), body.size());
 }
 
 Packet::Packet(const DataBuffer &raw_packet)
+    : Packet(raw_packet.data(), raw_packet.size())
+{
+}
+
+Packet::Packet(const std::byte *raw_packet, std::size_t size)
     : Packet()
 {
-    const auto size_to_copy = std::min<std::size_t>(128ul, raw_packet.size());
+    if (size < header_size)
+    {
+        return;
+    }
+
+    Header header{PacketType::INVAlID, ChannelType::INVAlID, 0u};
+    std::memcpy(&header, raw_packet, sizeof(header));
 
-    std::memcpy(this, raw_packet.data(), size_to_copy);
+    // a packet on the wire always fits in a datagram, and if the header claims
+    // more than we were given then it was truncated, either way we can't trust
+    // any of it so leave the packet invalid
+    if ((header.size > max_body_size) || (header.size > size - header_size))
+    {
+        return;
+    }
 
-    size_ = size_to_copy - sizeof(Header);
+    // the receiving channel is looked up from the header and fragments are
+    // reassembled from their index and count, so anything we wouldn't have
+    // sent ourselves is also rejected here rather than further up the stack
+    const auto type = static_cast<std::uint8_t>(header.type);
+    const auto channel = static_cast<std::uint8_t>(header.channel);
+
+    if ((type == static_cast<std::uint8_t>(PacketType::INVAlID)) ||
+        (type > static_cast<std::uint8_t>(PacketType::SYNC_FINISH)) ||
+        (channel == static_cast<std::uint8_t>(ChannelType::INVAlID)) ||
+        (channel > static_cast<std::uint8_t>(ChannelType::RELIABLE_ORDERED)))
+    {
+        return;
+    }
+
+    if ((header.fragment_count == 0u) || (header.fragment_count > max_fragments) ||
+        (header.fragment >= header.fragment_count))
+    {
+        return;
+    }
+
+    buffer_.assign(raw_packet, raw_packet + header_size + header.size);
 }
 
 const std::byte *Packet::data() const
 {
-    return reinterpret_cast<const std::byte *>(this);
+    return buffer_.data();
 }
 
 std::byte *Packet::data()
 {
-    return reinterpret_cast<std::byte *>(this);
+    return buffer_.data();
 }
 
 const std::byte *Packet::body() const
 {
-    return body_;
+    return buffer_.data() + header_size;
 }
 
 std::byte *Packet::body()
 {
-    return body_;
+    return buffer_.data() + header_size;
 }
 
 DataBuffer Packet::body_buffer() const
 {
-    return DataBuffer(body(), body() + size_);
+    return DataBuffer(body(), body() + body_size());
 }
 
 std::size_t Packet::packet_size() const
 {
-    // sanity check the Packet class is the expected size
-    static_assert(sizeof(Packet) == 128 + sizeof(size_), "packet has invalid size");
-
-    return sizeof(Header) + body_size();
+    return buffer_.size();
 }
 
 std::size_t Packet::body_size() const
 {
-    return size_;
+    return buffer_.size() - header_size;
 }
 
 PacketType Packet::type() const
 {
-    return header_.type;
+    return header().type;
 }
 
 ChannelType Packet::channel() const
 {
-    return header_.channel;
+    return header().channel;
 }
 
 bool Packet::is_valid() const
 {
-    return header_.type != PacketType::INVAlID;
+    return header().type != PacketType::INVAlID;
 }
 
 std::uint16_t Packet::sequence() const
 {
-    return header_.sequence;
+    return header().sequence;
 }
 
 void Packet::set_sequence(std::uint16_t sequence)
 {
-    header_.sequence = sequence;
+    header().sequence = sequence;
+}
+
+std::uint8_t Packet::fragment() const
+{
+    return header().fragment;
+}
+
+std::uint8_t Packet::fragment_count() const
+{
+    return header().fragment_count;
+}
+
+void Packet::set_fragment(std::uint8_t fragment, std::uint8_t count)
+{
+    header().fragment = fragment;
+    header().fragment_count = count;
+}
+
+const Packet::Header &Packet::header() const
+{
+    return *reinterpret_cast<const Header *>(buffer_.data());
+}
+
+Packet::Header &Packet::header()
+{
+    return *reinterpret_cast<Header *>(buffer_.data());
 }
 
 bool Packet::operator==(const Packet &other) const
 {
-    return ((packet_size() == other.packet_size()) && (std::memcmp(data(), other.data(), packet_size()) == 0));
+    return buffer_ == other.buffer_;
 }
 
 bool Packet::operator!=(const Packet &other) const
@@ -120,7 +188,7 @@ bool Packet::operator!=(const Packet &other) const
 
 std::ostream &operator<<(std::ostream &out, const Packet &packet)
 {
-    switch (packet.header_.type)
+    switch (packet.type())
     {
         case PacketType::INVAlID: out << "INVALID"; break;
         case PacketType::HELLO: out << "HELLO"; break;
@@ -132,7 +200,7 @@ std::ostream &operator<<(std::ostream &out, const Packet &packet)
 
     out << ", ";
 
-    switch (packet.header_.channel)
+    switch (packet.channel())
     {
         case ChannelType::INVAlID: out << "INVALID"; break;
         case ChannelType::UNRELIABLE_UNORDERED: out << "UNRELIABLE_UNORDERED"; break;
@@ -143,16 +211,22 @@ std::ostream &operator<<(std::ostream &out, const Packet &packet)
 
     out << ", ";
 
-    out << "[" << packet.header_.sequence << "]";
+    out << "[" << packet.sequence() << "]";
+
+    if (packet.fragment_count() > 1u)
+    {
+        out << " (" << static_cast<int>(packet.fragment()) << "/" << static_cast<int>(packet.fragment_count()) << ")";
+    }
+
     out << "  ";
-    out << packet.size_;
+    out << packet.body_size();
     out << " | ";
 
     out << std::hex;
 
-    for (auto i = 0u; i < std::min(static_cast<std::uint32_t>(packet.size_), 8u); ++i)
+    for (auto i = 0u; i < std::min(static_cast<std::uint32_t>(packet.body_size()), 8u); ++i)
     {
-        out << static_cast<int>(packet.body_[i]) << " ";
+        out << static_cast<int>(packet.body()[i]) << " ";
     }
 
     out << std::dec << std::endl;
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "networking/packet_coalescer.h"
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "core/data_buffer.h"
+#include "core/error_handling.h"
+#include "networking/packet.h"
+
+namespace iris
+{
+
+PacketCoalescer::PacketCoalescer()
+    : datagrams_()
+    , count_(0u)
+{
+}
+
+void PacketCoalescer::add(const Packet &packet)
+{
+    expect(packet.packet_size() <= Packet::max_size, "packet too large to coalesce");
+
+    // start a new datagram if there isn't one or the packet won't fit
+    if ((count_ == 0u) || (datagrams_[count_ - 1u].size() + packet.packet_size() > Packet::max_size))
+    {
+        if (count_ == datagrams_.size())
+        {
+            datagrams_.emplace_back().reserve(Packet::max_size);
+        }
+
+        ++count_;
+    }
+
+    auto &datagram = datagrams_[count_ - 1u];
+    datagram.insert(std::end(datagram), packet.data(), packet.data() + packet.packet_size());
+}
+
+void PacketCoalescer::add(const std::vector<Packet> &packets)
+{
+    for (const auto &packet : packets)
+    {
+        add(packet);
+    }
+}
+
+bool PacketCoalescer::empty() const
+{
+    return count_ == 0u;
+}
+
+std::size_t PacketCoalescer::size() const
+{
+    return count_;
+}
+
+const DataBuffer &PacketCoalescer::operator[](std::size_t index) const
+{
+    expect(index < count_, "index out of range");
+
+    return datagrams_[index];
+}
+
+void PacketCoalescer::clear()
+{
+    for (auto i = 0u; i < count_; ++i)
+    {
+        datagrams_[i].clear();
+    }
+
+    count_ = 0u;
+}
+
+std::vector<Packet> PacketCoalescer::split(const DataBuffer &datagram)
+{
+    std::vector<Packet> packets{};
+    std::size_t offset = 0u;
+
+    while (offset < datagram.size())
+    {
+        Packet packet{datagram.data() + offset, datagram.size() - offset};
+        if (!packet.is_valid())
+        {
+            break;
+        }
+
+        offset += packet.packet_size();
+        packets.emplace_back(std::move(packet));
+    }
+
+    return packets;
+}
+
+}
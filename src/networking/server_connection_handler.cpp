@@ -16,13 +16,13 @@
 #include <memory>
 #include <mutex>
 #include <numeric>
+#include <set>
 #include <vector>
 
 #include "core/data_buffer.h"
-#include "core/root.h"
+#include "core/error_handling.h"
 #include "jobs/concurrent_queue.h"
-#include "jobs/job.h"
-#include "jobs/job_system_manager.h"
+#include "jobs/service_thread.h"
 #include "log/log.h"
 #include "networking/channel/channel_type.h"
 #include "networking/channel/reliable_ordered_channel.h"
@@ -30,12 +30,23 @@
 #include "networking/channel/unreliable_unordered_channel.h"
 #include "networking/data_buffer_deserialiser.h"
 #include "networking/data_buffer_serialiser.h"
+#include "networking/datagram.h"
 #include "networking/packet.h"
+#include "networking/packet_coalescer.h"
+#include "networking/server_socket.h"
+#include "networking/server_socket_data.h"
 #include "networking/socket.h"
 
 namespace
 {
 
+// how long the reader thread blocks for before checking if it should stop
+static constexpr auto read_timeout = std::chrono::milliseconds(100);
+
+// how much data can be queued for a connection before it is sent without
+// waiting for an update
+static constexpr auto flush_threshold = iris::Packet::max_size;
+
 /**
  * Helper function to handle a hello message. This is the first part of the
  * handshake and the server needs to respond with CONNECTED. We also use this
@@ -47,10 +58,13 @@ namespace
  * @param channel
  *   The channel HELLO was received on.
  *
- * @param socket
- *   Socket for the connection.
+ * @param mutex
+ *   Mutex guarding channels.
+ *
+ * @returns
+ *   Packets to send to the connection.
  */
-void handle_hello(std::size_t id, iris::Channel *channel, iris::Socket *socket, std::mutex &mutex)
+std::vector<iris::Packet> handle_hello(std::size_t id, iris::Channel *channel, std::mutex &mutex)
 {
     // we will send the client their id
     iris::DataBufferSerialiser serialiser{};
@@ -60,21 +74,12 @@ void handle_hello(std::size_t id, iris::Channel *channel, iris::Socket *socket,
     iris::Packet connected{iris::PacketType::CONNECTED, iris::ChannelType::RELIABLE_ORDERED, serialiser.data()};
     iris::Packet sync_start{iris::PacketType::SYNC_START, iris::ChannelType::RELIABLE_ORDERED, {}};
 
-    std::vector<iris::Packet> send_queue{};
-
-    {
-        std::unique_lock lock(mutex);
+    std::unique_lock lock(mutex);
 
-        channel->enqueue_send(std::move(connected));
-        channel->enqueue_send(std::move(sync_start));
-        send_queue = channel->yield_send_queue();
-    }
+    channel->enqueue_send(std::move(connected));
+    channel->enqueue_send(std::move(sync_start));
 
-    // send all packets
-    for (const auto &packet : send_queue)
-    {
-        socket->write(packet.data(), packet.packet_size());
-    }
+    return channel->yield_send_queue();
 }
 
 /**
@@ -83,13 +88,16 @@ void handle_hello(std::size_t id, iris::Channel *channel, iris::Socket *socket,
  * @param channel
  *   The channel to communicate on.
  *
- * @param socket
- *   Socket for the connection.
- *
  * @param packet
  *   The received SYNC_RESPONSE packet.
+ *
+ * @param mutex
+ *   Mutex guarding channels.
+ *
+ * @returns
+ *   Packets to send to the connection.
  */
-void handle_sync_response(iris::Channel *channel, iris::Socket *socket, const iris::Packet &packet, std::mutex &mutex)
+std::vector<iris::Packet> handle_sync_response(iris::Channel *channel, const iris::Packet &packet, std::mutex &mutex)
 {
     // get the client time and our time
     iris::DataBufferDeserialiser deserialiser{packet.body_buffer()};
@@ -103,19 +111,10 @@ void handle_sync_response(iris::Channel *channel, iris::Socket *socket, const ir
     serialiser.push(static_cast<std::uint32_t>(now.count()));
     iris::Packet sync_finish{iris::PacketType::SYNC_FINISH, iris::ChannelType::RELIABLE_ORDERED, serialiser.data()};
 
-    std::vector<iris::Packet> send_queue{};
+    std::unique_lock lock(mutex);
+    channel->enqueue_send(std::move(sync_finish));
 
-    {
-        std::unique_lock lock(mutex);
-        channel->enqueue_send(std::move(sync_finish));
-        send_queue = channel->yield_send_queue();
-    }
-
-    // send all packets
-    for (const auto &p : send_queue)
-    {
-        socket->write(p.data(), p.packet_size());
-    }
+    return channel->yield_send_queue();
 }
 
 }
@@ -131,6 +130,72 @@ struct ServerConnectionHandler::Connection
     Socket *socket;
     std::map<ChannelType, std::unique_ptr<Channel>> channels;
     std::chrono::milliseconds rtt;
+
+    /** Channels which have packets (data or acks) queued since the last update. */
+    std::set<ChannelType> pending_sends;
+
+    /** Size of data queued with send since the last update. */
+    std::size_t pending_bytes;
+};
+
+/**
+ * Helper struct to coalesce packets, per client, so they can be written with
+ * a single batched socket write. Coalescers are cleared but never removed, so
+ * once warmed up flushing doesn't allocate.
+ */
+struct ServerConnectionHandler::SendBatch
+{
+    /**
+     * Add packets to the batch.
+     *
+     * @param client
+     *   Socket to send packets to.
+     *
+     * @param queue
+     *   Packets to send.
+     */
+    void add(Socket *client, const std::vector<Packet> &queue)
+    {
+        coalescers[client].add(queue);
+    }
+
+    /**
+     * Write all datagrams in the batch and clear it.
+     *
+     * @param socket
+     *   Socket to write batch with.
+     */
+    void flush(ServerSocket &socket)
+    {
+        // datagrams are stable now, so it is safe to point at them
+        for (const auto &[client, coalescer] : coalescers)
+        {
+            for (auto i = 0u; i < coalescer.size(); ++i)
+            {
+                datagrams.push_back({client, coalescer[i].data(), coalescer[i].size()});
+            }
+        }
+
+        if (datagrams.empty())
+        {
+            return;
+        }
+
+        socket.write_batch(datagrams);
+
+        for (auto &[client, coalescer] : coalescers)
+        {
+            coalescer.clear();
+        }
+
+        datagrams.clear();
+    }
+
+    /** Datagrams being built for each client. */
+    std::map<Socket *, PacketCoalescer> coalescers;
+
+    /** Datagrams for the batched write. */
+    std::vector<Datagram> datagrams;
 };
 
 ServerConnectionHandler::ServerConnectionHandler(
@@ -144,105 +209,178 @@ ServerConnectionHandler::ServerConnectionHandler(
     , connections_()
     , mutex_()
     , messages_()
+    , send_batch_(std::make_unique<SendBatch>())
+    // we want to always be accepting connections, so we do this on a dedicated
+    // thread, keeping the blocking reads off the job system
+    , reader_(
+          "server_connection_handler",
+          [this](const StopToken &token)
+          {
+              // reused for every read, so we only allocate whilst warming up
+              std::vector<ServerSocketData> batch{};
+              SendBatch responses{};
+
+              while (!token.stop_requested())
+              {
+                  // the timeout means we regularly get a chance to check if
+                  // we should stop
+                  const auto count = socket_->read_batch(read_timeout, batch);
+
+                  for (auto i = 0u; i < count; ++i)
+                  {
+                      handle_data(batch[i], responses);
+                  }
+
+                  // send any responses for the whole batch in one go
+                  responses.flush(*socket_);
+              }
+          })
 {
-    // we want to always be accepting connections, so we do this in a background
-    // job
-    Root::jobs_manager().add({[this]()
-                              {
-                                  for (;;)
-                                  {
-                                      auto [client_socket, raw_packet, new_connection] = socket_->read();
-
-                                      std::hash<Socket *> hash{};
-
-                                      const auto id = hash(client_socket);
-
-                                      if (new_connection)
-                                      {
-                                          // setup internal struct to manage connection
-                                          auto connection = std::make_unique<Connection>();
-                                          connection->socket = client_socket;
-                                          connection->channels[ChannelType::UNRELIABLE_UNORDERED] =
-                                              std::make_unique<UnreliableUnorderedChannel>();
-                                          connection->channels[ChannelType::UNRELIABLE_SEQUENCED] =
-                                              std::make_unique<UnreliableSequencedChannel>();
-                                          connection->channels[ChannelType::RELIABLE_ORDERED] =
-                                              std::make_unique<ReliableOrderedChannel>();
-
-                                          connections_[id] = std::move(connection);
-                                      }
-
-                                      auto *connection = connections_[id].get();
-
-                                      iris::Packet packet{raw_packet};
-
-                                      // enqueue the packet into the right channel
-                                      const auto channel_type = packet.channel();
-                                      auto *channel = connection->channels.at(channel_type).get();
-
-                                      std::vector<Packet> receive_queue{};
-
-                                      {
-                                          std::unique_lock lock(mutex_);
-                                          channel->enqueue_receive(std::move(packet));
-                                          receive_queue = channel->yield_receive_queue();
-                                      }
-
-                                      // handle all received packets from that channel
-                                      for (const auto &p : receive_queue)
-                                      {
-                                          switch (p.type())
-                                          {
-                                              case PacketType::HELLO:
-                                              {
-                                                  handle_hello(id, channel, connection->socket, mutex_);
-
-                                                  // we got a new client, fire it back to the
-                                                  // application
-                                                  new_connection_callback_(id);
-                                                  break;
-                                              }
-                                              case PacketType::DATA:
-                                              {
-                                                  // we got data, fire it back to the application
-                                                  recv_callback_(id, p.body_buffer(), p.channel());
-                                                  break;
-                                              }
-                                              case PacketType::SYNC_RESPONSE:
-                                              {
-                                                  handle_sync_response(channel, connection->socket, packet, mutex_);
-                                                  break;
-                                              }
-                                              default:
-                                                  LOG_ENGINE_ERROR("server_connection_handler", "unknown packet type");
-                                          }
-                                      }
-                                  }
-                              }});
 }
 
 ServerConnectionHandler::~ServerConnectionHandler() = default;
 
 void ServerConnectionHandler::update()
 {
+    // nothing more would ever be received, so don't let that go unnoticed
+    ensure(reader_.is_running(), "reader stopped");
+
+    std::unique_lock lock(mutex_);
+
+    // collect everything queued since the last update, the reliable channel is
+    // always checked as it resends packets that time out
+    for (auto &[id, connection] : connections_)
+    {
+        connection->pending_sends.emplace(ChannelType::RELIABLE_ORDERED);
+        collect_pending(*connection);
+    }
+
+    // the batch is shared with send, so flush whilst we still hold the lock
+    send_batch_->flush(*socket_);
 }
 
 void ServerConnectionHandler::send(std::size_t id, const DataBuffer &message, ChannelType channel_type)
 {
-    auto *channel = connections_[id]->channels[channel_type].get();
-    auto *socket = connections_[id]->socket;
+    std::unique_lock lock(mutex_);
+
+    auto *connection = connections_[id].get();
+
+    // wrap data in a Packet and enqueue, it gets sent on the next update
+    Packet packet(PacketType::DATA, channel_type, message);
+    connection->pending_bytes += packet.packet_size();
+    connection->channels[channel_type]->enqueue_send(std::move(packet));
+    connection->pending_sends.emplace(channel_type);
+
+    // once there is more than a datagram's worth queued there is nothing to
+    // gain from waiting, so send now (still holding the lock as the batch is
+    // shared with update)
+    if (connection->pending_bytes >= flush_threshold)
+    {
+        collect_pending(*connection);
+        send_batch_->flush(*socket_);
+    }
+}
+
+void ServerConnectionHandler::collect_pending(Connection &connection)
+{
+    for (const auto channel_type : connection.pending_sends)
+    {
+        send_batch_->add(connection.socket, connection.channels[channel_type]->yield_send_queue());
+    }
+
+    connection.pending_sends.clear();
+    connection.pending_bytes = 0u;
+}
+
+void ServerConnectionHandler::handle_data(const ServerSocketData &data, SendBatch &responses)
+{
+    const auto &[client_socket, raw_packet, new_connection] = data;
+
+    std::hash<Socket *> hash{};
+
+    const auto id = hash(client_socket);
+
+    Connection *connection = nullptr;
+
+    {
+        std::unique_lock lock(mutex_);
+
+        if (new_connection)
+        {
+            // setup internal struct to manage connection
+            auto created = std::make_unique<Connection>();
+            created->socket = client_socket;
+            created->channels[ChannelType::UNRELIABLE_UNORDERED] = std::make_unique<UnreliableUnorderedChannel>();
+            created->channels[ChannelType::UNRELIABLE_SEQUENCED] = std::make_unique<UnreliableSequencedChannel>();
+            created->channels[ChannelType::RELIABLE_ORDERED] = std::make_unique<ReliableOrderedChannel>();
+
+            connections_[id] = std::move(created);
+        }
+
+        connection = connections_[id].get();
+    }
+
+    // a datagram may contain packets for several channels, so enqueue them all
+    // then collect everything that can now be yielded
+    std::vector<Packet> receive_queue{};
 
     {
         std::unique_lock lock(mutex_);
 
-        // wrap data in a Packet and enqueue
-        Packet packet(PacketType::DATA, channel_type, message);
-        channel->enqueue_send(std::move(packet));
+        std::set<ChannelType> received{};
+
+        for (auto &packet : PacketCoalescer::split(raw_packet))
+        {
+            const auto channel_type = packet.channel();
+            const auto is_ack = packet.type() == PacketType::ACK;
+
+            auto *channel = connection->channels.at(channel_type).get();
+            channel->enqueue_receive(std::move(packet));
+            received.emplace(channel_type);
+
+            // reliable packets need acking, which we do on the next update
+            if ((channel_type == ChannelType::RELIABLE_ORDERED) && !is_ack)
+            {
+                connection->pending_sends.emplace(channel_type);
+            }
+        }
+
+        for (const auto channel_type : received)
+        {
+            for (auto &packet : connection->channels[channel_type]->yield_receive_queue())
+            {
+                receive_queue.emplace_back(std::move(packet));
+            }
+        }
+    }
+
+    // handle all received packets
+    for (const auto &p : receive_queue)
+    {
+        auto *channel = connection->channels.at(p.channel()).get();
 
-        // send all packets
-        for (const auto &p : channel->yield_send_queue())
+        switch (p.type())
         {
-            socket->write(p.data(), p.packet_size());
+            case PacketType::HELLO:
+            {
+                responses.add(connection->socket, handle_hello(id, channel, mutex_));
+
+                // we got a new client, fire it back to the application
+                new_connection_callback_(id);
+                break;
+            }
+            case PacketType::DATA:
+            {
+                // we got data, fire it back to the application
+                recv_callback_(id, p.body_buffer(), p.channel());
+                break;
+            }
+            case PacketType::SYNC_RESPONSE:
+            {
+                responses.add(connection->socket, handle_sync_response(channel, p, mutex_));
+                break;
+            }
+            default: LOG_ENGINE_ERROR("server_connection_handler", "unknown packet type");
         }
     }
 }
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "networking/server_socket.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "networking/datagram.h"
+#include "networking/server_socket_data.h"
+
+namespace iris
+{
+
+std::size_t ServerSocket::read_batch(std::chrono::milliseconds timeout, std::vector<ServerSocketData> &batch)
+{
+    auto data = read(timeout);
+    if (!data)
+    {
+        return 0u;
+    }
+
+    if (batch.empty())
+    {
+        batch.emplace_back(std::move(*data));
+    }
+    else
+    {
+        batch.front() = std::move(*data);
+    }
+
+    return 1u;
+}
+
+void ServerSocket::write_batch(const std::vector<Datagram> &datagrams)
+{
+    for (const auto &datagram : datagrams)
+    {
+        datagram.client->write(datagram.data, datagram.size);
+    }
+}
+
+}
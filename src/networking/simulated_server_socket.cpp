@@ -8,6 +8,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 
 #include "networking/server_socket_data.h"
 #include "networking/simulated_socket.h"
@@ -40,4 +41,16 @@ ServerSocketData SimulatedServerSocket::read()
     return {client_.get(), data, new_client};
 }
 
+std::optional<ServerSocketData> SimulatedServerSocket::read(std::chrono::milliseconds timeout)
+{
+    auto data = socket_->read(timeout);
+
+    if (data && !client_)
+    {
+        client_ = std::make_unique<SimulatedSocket>(delay_, jitter_, drop_rate_, data->client);
+    }
+
+    return data ? std::optional<ServerSocketData>{{client_.get(), data->data, data->new_connection}} : std::nullopt;
+}
+
 }
@@ -10,13 +10,10 @@
 #include <cstddef>
 #include <optional>
 #include <random>
-#include <thread>
 
 #include "core/random.h"
-#include "core/root.h"
-#include "jobs/concurrent_queue.h"
-#include "jobs/job.h"
-#include "jobs/job_system_manager.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/service_thread.h"
 #include "log/log.h"
 
 using namespace std::chrono_literals;
@@ -33,29 +30,36 @@ SimulatedSocket::SimulatedSocket(
     , jitter_(jitter)
     , drop_rate_(drop_rate)
     , socket_(socket)
-{
+    , write_queue_()
     // in order to facilitate message delay without blocking we have write()
-    // enqueue data with a time point, this job then grabs them and can wait
+    // enqueue data with a time point, this thread then grabs them and can wait
     // until the delay has passed before sending
-    Root::jobs_manager().add({[this]()
-                              {
-                                  for (;;)
-                                  {
-                                      if (write_queue_.empty())
-                                      {
-                                          std::this_thread::sleep_for(10ms);
-                                      }
-                                      else
-                                      {
-                                          const auto &[buffer, time_point] = write_queue_.dequeue();
-
-                                          // wait until its time to send the data
-                                          std::this_thread::sleep_until(time_point);
-
-                                          socket_->write(buffer);
-                                      }
-                                  }
-                              }});
+    , writer_(
+          "simulated_socket",
+          [this](const StopToken &token)
+          {
+              std::tuple<DataBuffer, std::chrono::steady_clock::time_point> entry{};
+
+              while (!token.stop_requested())
+              {
+                  if (!write_queue_.try_dequeue(entry))
+                  {
+                      token.wait_for(10ms);
+                  }
+                  else
+                  {
+                      const auto &[buffer, time_point] = entry;
+
+                      // wait until its time to send the data, if we are asked
+                      // to stop first then the data is dropped
+                      if (!token.wait_until(time_point))
+                      {
+                          socket_->write(buffer);
+                      }
+                  }
+              }
+          })
+{
 }
 
 SimulatedSocket::~SimulatedSocket() = default;
@@ -70,6 +74,11 @@ DataBuffer SimulatedSocket::read(std::size_t count)
     return socket_->read(count);
 }
 
+std::optional<DataBuffer> SimulatedSocket::read(std::size_t count, std::chrono::milliseconds timeout)
+{
+    return socket_->read(count, timeout);
+}
+
 void SimulatedSocket::write(const DataBuffer &buffer)
 {
     if (!flip_coin(drop_rate_))
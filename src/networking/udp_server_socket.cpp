@@ -6,31 +6,107 @@
 
 #include "networking/udp_server_socket.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
 
 #include "core/auto_release.h"
 #include "core/data_buffer.h"
 #include "core/error_handling.h"
 #include "log/log.h"
+#include "networking/datagram.h"
 #include "networking/networking.h"
+#include "networking/packet.h"
 #include "networking/server_socket_data.h"
 #include "networking/socket.h"
 #include "networking/udp_socket.h"
 
+namespace
+{
+
+// largest datagram we will read, nothing larger than a packet is ever sent
+static constexpr auto max_datagram_size = iris::Packet::max_size;
+
+#if defined(IRIS_PLATFORM_LINUX)
+// maximum number of datagrams read or written with a single syscall
+static constexpr auto batch_size = 64u;
+#endif
+
+}
+
 namespace iris
 {
 
+/**
+ * Preallocated state for a batch of datagrams, so a batched read or write
+ * doesn't need to allocate.
+ */
+struct UdpServerSocket::Batch
+{
+#if defined(IRIS_PLATFORM_LINUX)
+    /**
+     * Construct a new Batch.
+     *
+     * @param buffer_size
+     *   Size of buffer for each datagram, zero if datagrams are supplied by
+     *   the caller.
+     */
+    explicit Batch(std::size_t buffer_size)
+        : headers(batch_size)
+        , iovecs(batch_size)
+        , addresses(batch_size)
+        , buffers(batch_size * buffer_size)
+    {
+        for (auto i = 0u; i < batch_size; ++i)
+        {
+            std::memset(&headers[i], 0x0, sizeof(headers[i]));
+            headers[i].msg_hdr.msg_name = &addresses[i];
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1u;
+
+            iovecs[i].iov_base = buffers.data() + (i * buffer_size);
+            iovecs[i].iov_len = buffer_size;
+        }
+    }
+
+    /** Message header for each datagram. */
+    std::vector<struct ::mmsghdr> headers;
+
+    /** Single element scatter/gather array for each datagram. */
+    std::vector<struct ::iovec> iovecs;
+
+    /** Address for each datagram. */
+    std::vector<struct sockaddr_in> addresses;
+
+    /** Contiguous storage for each datagram. */
+    DataBuffer buffers;
+#endif
+};
+
 UdpServerSocket::UdpServerSocket(const std::string &address, std::uint32_t port)
     : connections_()
     , socket_()
+#if defined(IRIS_PLATFORM_LINUX)
+    , read_batch_(std::make_unique<Batch>(max_datagram_size))
+    , write_batch_(std::make_unique<Batch>(0u))
+#else
+    , read_batch_()
+    , write_batch_()
+#endif
+    , write_mutex_()
 {
     LOG_ENGINE_INFO("udp_server_socket", "creating server socket ({}:{})", address, port);
 
     // create socket
     socket_ = {::socket(AF_INET, SOCK_DGRAM, 0), CloseSocket};
-    ensure(socket_ == INVALID_SOCKET, "socket failed");
+    ensure(socket_ != INVALID_SOCKET, "socket failed");
 
     // configure address
     struct sockaddr_in address_storage = {0};
@@ -53,15 +129,118 @@ UdpServerSocket::UdpServerSocket(const std::string &address, std::uint32_t port)
     LOG_ENGINE_INFO("udp_server_socket", "connected!");
 }
 
+UdpServerSocket::~UdpServerSocket() = default;
+
 ServerSocketData UdpServerSocket::read()
+{
+    // block and wait for a new connection
+    set_receive_timeout(socket_, std::chrono::milliseconds::zero());
+
+    auto data = receive();
+    ensure(data.has_value(), "recvfrom failed");
+
+    return *data;
+}
+
+std::optional<ServerSocketData> UdpServerSocket::read(std::chrono::milliseconds timeout)
+{
+    expect(timeout > std::chrono::milliseconds::zero(), "timeout must be greater than zero");
+
+    set_receive_timeout(socket_, timeout);
+
+    return receive();
+}
+
+std::size_t UdpServerSocket::read_batch(std::chrono::milliseconds timeout, std::vector<ServerSocketData> &batch)
+{
+#if defined(IRIS_PLATFORM_LINUX)
+    expect(timeout > std::chrono::milliseconds::zero(), "timeout must be greater than zero");
+
+    set_receive_timeout(socket_, timeout);
+
+    // the kernel writes back the lengths, so reset them to the full buffer
+    for (auto i = 0u; i < batch_size; ++i)
+    {
+        read_batch_->headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        read_batch_->iovecs[i].iov_len = max_datagram_size;
+    }
+
+    // wait (up to the receive timeout) for the first datagram then take
+    // whatever else is already queued
+    const auto read = ::recvmmsg(socket_, read_batch_->headers.data(), batch_size, MSG_WAITFORONE, nullptr);
+
+    if (read == -1)
+    {
+        ensure(last_call_timed_out(), "recvmmsg failed");
+        return 0u;
+    }
+
+    const auto count = static_cast<std::size_t>(read);
+    if (batch.size() < count)
+    {
+        batch.resize(count);
+    }
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        const auto &header = read_batch_->headers[i];
+        const auto *data = static_cast<const std::byte *>(read_batch_->iovecs[i].iov_base);
+
+        auto [client_socket, new_connection] = client(read_batch_->addresses[i], header.msg_hdr.msg_namelen);
+
+        // assign rather than construct, so we reuse the existing capacity
+        batch[i].client = client_socket;
+        batch[i].data.assign(data, data + header.msg_len);
+        batch[i].new_connection = new_connection;
+    }
+
+    return count;
+#else
+    return ServerSocket::read_batch(timeout, batch);
+#endif
+}
+
+void UdpServerSocket::write_batch(const std::vector<Datagram> &datagrams)
+{
+#if defined(IRIS_PLATFORM_LINUX)
+    std::unique_lock lock(write_mutex_);
+
+    auto written = std::size_t{0u};
+
+    while (written != datagrams.size())
+    {
+        const auto count = std::min<std::size_t>(batch_size, datagrams.size() - written);
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto &datagram = datagrams[written + i];
+            const auto *client_socket = static_cast<const UdpSocket *>(datagram.client);
+
+            write_batch_->addresses[i] = client_socket->address();
+            write_batch_->headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            write_batch_->iovecs[i].iov_base = const_cast<std::byte *>(datagram.data);
+            write_batch_->iovecs[i].iov_len = datagram.size;
+        }
+
+        const auto sent = ::sendmmsg(socket_, write_batch_->headers.data(), static_cast<unsigned int>(count), 0);
+        ensure(sent > 0, "sendmmsg failed");
+
+        // sendmmsg may send fewer than requested, in which case we go round
+        // again with the rest
+        written += static_cast<std::size_t>(sent);
+    }
+#else
+    ServerSocket::write_batch(datagrams);
+#endif
+}
+
+std::optional<ServerSocketData> UdpServerSocket::receive()
 {
     struct sockaddr_in address;
     socklen_t length = sizeof(address);
 
-    static constexpr auto new_connection_size = 1024u;
-    DataBuffer buffer(new_connection_size);
+    DataBuffer buffer(max_datagram_size);
 
-    // block and wait for a new connection
     const auto read = ::recvfrom(
         socket_,
         reinterpret_cast<char *>(buffer.data()),
@@ -70,25 +249,39 @@ ServerSocketData UdpServerSocket::read()
         reinterpret_cast<struct sockaddr *>(&address),
         &length);
 
-    ensure(read != -1, "recvfrom failed");
+    if (read == -1)
+    {
+        ensure(last_call_timed_out(), "recvfrom failed");
+        return std::nullopt;
+    }
 
     // resize buffer to amount of data read
     buffer.resize(read);
 
-    const auto byte_address = address.sin_addr.s_addr;
+    auto [client_socket, new_connection] = client(address, length);
+
+    return ServerSocketData{client_socket, buffer, new_connection};
+}
+
+std::tuple<Socket *, bool> UdpServerSocket::client(const struct sockaddr_in &address, socklen_t length)
+{
+    // key on address and port, so multiple clients behind the same address
+    // are kept apart
+    const auto key = (static_cast<std::uint64_t>(address.sin_addr.s_addr) << 16u) | address.sin_port;
 
     auto new_connection = false;
 
-    if (connections_.count(byte_address) == 0u)
+    auto connection = connections_.find(key);
+    if (connection == std::cend(connections_))
     {
-        connections_[byte_address] = std::make_unique<UdpSocket>(address, length, socket_.get());
+        connection = connections_.emplace(key, std::make_unique<UdpSocket>(address, length, socket_.get())).first;
 
         new_connection = true;
 
         LOG_ENGINE_INFO("udp_server_socket", "new connection");
     }
 
-    return {connections_[byte_address].get(), buffer, new_connection};
+    return {connection->second.get(), new_connection};
 }
 
 }
@@ -6,6 +6,7 @@
 
 #include "networking/udp_socket.h"
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -14,6 +15,7 @@
 #include <string>
 
 #include "core/data_buffer.h"
+#include "core/error_handling.h"
 #include "core/exception.h"
 #include "log/log.h"
 #include "networking/networking.h"
@@ -105,6 +107,7 @@ DataBuffer UdpSocket::read(std::size_t count)
     DataBuffer buffer(count);
 
     set_blocking(socket_, true);
+    set_receive_timeout(socket_, std::chrono::milliseconds::zero());
 
     // perform blocking read
     auto read = ::recvfrom(
@@ -126,6 +129,43 @@ DataBuffer UdpSocket::read(std::size_t count)
     return buffer;
 }
 
+std::optional<DataBuffer> UdpSocket::read(std::size_t count, std::chrono::milliseconds timeout)
+{
+    expect(timeout > std::chrono::milliseconds::zero(), "timeout must be greater than zero");
+
+    std::optional<DataBuffer> out = DataBuffer(count);
+
+    set_blocking(socket_, true);
+    set_receive_timeout(socket_, timeout);
+
+    // perform blocking read, which will give up after the timeout
+    auto read = ::recvfrom(
+        socket_,
+        reinterpret_cast<char *>(out->data()),
+        static_cast<int>(out->size()),
+        0,
+        reinterpret_cast<struct sockaddr *>(&address_),
+        &address_length_);
+
+    if (read == -1)
+    {
+        if (!last_call_timed_out())
+        {
+            throw Exception("recvfrom failed");
+        }
+
+        // no data arrived in time
+        out.reset();
+    }
+    else
+    {
+        // resize buffer to amount of data read
+        out->resize(read);
+    }
+
+    return out;
+}
+
 void UdpSocket::write(const DataBuffer &buffer)
 {
     write(buffer.data(), buffer.size());
@@ -133,16 +173,24 @@ void UdpSocket::write(const DataBuffer &buffer)
 
 void UdpSocket::write(const std::byte *data, std::size_t size)
 {
-    if (::sendto(
-            socket_,
-            reinterpret_cast<const char *>(data),
-            static_cast<int>(size),
-            0,
-            reinterpret_cast<struct sockaddr *>(&address_),
-            address_length_) != size)
+    const auto sent = ::sendto(
+        socket_,
+        reinterpret_cast<const char *>(data),
+        static_cast<int>(size),
+        0,
+        reinterpret_cast<struct sockaddr *>(&address_),
+        address_length_);
+
+    // sendto returns int on windows and ssize_t elsewhere
+    if (sent != static_cast<decltype(sent)>(size))
     {
         throw Exception("sendto failed");
     }
 }
 
+const struct sockaddr_in &UdpSocket::address() const
+{
+    return address_;
+}
+
 }
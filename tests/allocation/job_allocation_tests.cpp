@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/inplace_job.h"
+#include "jobs/thread/thread_job_system.h"
+
+namespace
+{
+
+// whether allocations are currently being counted
+std::atomic<bool> counting = false;
+
+// number of global allocations made, on any thread, whilst counting
+std::atomic<std::size_t> allocation_count = 0u;
+
+/**
+ * Counts global allocations made whilst in scope.
+ */
+class AllocationCounter
+{
+  public:
+    AllocationCounter()
+    {
+        allocation_count = 0u;
+        counting = true;
+    }
+
+    ~AllocationCounter()
+    {
+        counting = false;
+    }
+
+    std::size_t count() const
+    {
+        return allocation_count;
+    }
+};
+
+/**
+ * Helper to make a batch of jobs which each increment a counter.
+ */
+std::vector<iris::InplaceJob> make_jobs(std::size_t count, std::atomic<std::size_t> &done)
+{
+    std::vector<iris::InplaceJob> jobs{};
+    jobs.reserve(count);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        jobs.emplace_back([&done]() { ++done; });
+    }
+
+    return jobs;
+}
+
+/**
+ * Helper to submit batches of fire-and-forget jobs and count the allocations
+ * made whilst they are submitted and run, after a warm up to fill any pools.
+ */
+template <class JobSystem>
+std::size_t steady_state_allocations(JobSystem &js)
+{
+    static constexpr auto batch_size = 64u;
+    static constexpr auto batch_count = 20u;
+
+    std::atomic<std::size_t> done = 0u;
+
+    const auto run_batch = [&js, &done](std::vector<iris::InplaceJob> &&jobs)
+    {
+        const auto target = done + jobs.size();
+        js.add_jobs(std::move(jobs));
+
+        while (done != target)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    for (auto i = 0u; i < batch_count; ++i)
+    {
+        run_batch(make_jobs(batch_size, done));
+    }
+
+    // build the batches up front so only the job system is measured
+    std::vector<std::vector<iris::InplaceJob>> batches{};
+    for (auto i = 0u; i < batch_count; ++i)
+    {
+        batches.emplace_back(make_jobs(batch_size, done));
+    }
+
+    AllocationCounter counter{};
+
+    for (auto &batch : batches)
+    {
+        run_batch(std::move(batch));
+    }
+
+    return counter.count();
+}
+
+}
+
+void *operator new(std::size_t size)
+{
+    if (counting)
+    {
+        ++allocation_count;
+    }
+
+    if (auto *ptr = std::malloc(size == 0u ? 1u : size); ptr != nullptr)
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(job_allocation, inline_job_does_not_allocate)
+{
+    auto called = false;
+
+    AllocationCounter counter{};
+
+    iris::InplaceJob job{[&called]() { called = true; }};
+    auto moved = std::move(job);
+    moved();
+
+    ASSERT_TRUE(called);
+    ASSERT_EQ(counter.count(), 0u);
+}
+
+TEST(job_allocation, fiber_job_system_add_jobs)
+{
+    iris::FiberJobSystem js{2u};
+
+    ASSERT_EQ(steady_state_allocations(js), 0u);
+}
+
+TEST(job_allocation, thread_job_system_add_jobs)
+{
+    iris::ThreadJobSystem js{2u};
+
+    ASSERT_EQ(steady_state_allocations(js), 0u);
+}
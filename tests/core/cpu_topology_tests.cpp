@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "core/cpu_topology.h"
+
+namespace
+{
+
+/**
+ * Fixture which builds a fake sysfs tree for a dual socket machine, each
+ * socket has two cores with two hardware threads and is its own node.
+ *
+ * Linux numbers the second thread of each core after all the first threads:
+ *   package 0: core 0 = cpu 0, 4  core 1 = cpu 1, 5
+ *   package 1: core 0 = cpu 2, 6  core 1 = cpu 3, 7
+ *
+ * cpu 8 is offline.
+ */
+class CpuTopologyTests : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        root_ = std::filesystem::temp_directory_path() /
+                ("iris_sysfs_" + std::string{::testing::UnitTest::GetInstance()->current_test_info()->name()});
+        std::filesystem::remove_all(root_);
+
+        for (auto cpu = 0u; cpu < 8u; ++cpu)
+        {
+            write_cpu(cpu, (cpu % 4u) / 2u, cpu % 2u);
+        }
+
+        std::filesystem::create_directories(root_ / "cpu" / "cpu8");
+        write(root_ / "cpu" / "online", "0-7");
+
+        write(root_ / "node" / "node0" / "cpulist", "0-1,4-5");
+        write(root_ / "node" / "node1" / "cpulist", "2-3,6-7");
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root_);
+    }
+
+    void write_cpu(std::size_t cpu, std::size_t package, std::size_t core)
+    {
+        const auto topology = root_ / "cpu" / ("cpu" + std::to_string(cpu)) / "topology";
+        write(topology / "physical_package_id", std::to_string(package));
+        write(topology / "core_id", std::to_string(core));
+    }
+
+    static void write(const std::filesystem::path &path, const std::string &contents)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream strm{path};
+        strm << contents << "\n";
+    }
+
+    std::filesystem::path root_;
+};
+
+}
+
+TEST(cpu_topology, flat)
+{
+    const auto topology = iris::CpuTopology::flat(4u);
+
+    ASSERT_EQ(topology.cpus().size(), 4u);
+    ASSERT_EQ(topology.physical_core_count(), 4u);
+    ASSERT_EQ(topology.node_count(), 1u);
+}
+
+TEST(cpu_topology, detect)
+{
+    const auto topology = iris::CpuTopology::detect();
+
+    ASSERT_FALSE(topology.cpus().empty());
+    ASSERT_GE(topology.physical_core_count(), 1u);
+    ASSERT_GE(topology.node_count(), 1u);
+}
+
+TEST_F(CpuTopologyTests, from_sysfs)
+{
+    const auto topology = iris::CpuTopology::from_sysfs(root_);
+    const auto &cpus = topology.cpus();
+
+    ASSERT_EQ(cpus.size(), 8u);
+    ASSERT_EQ(topology.physical_core_count(), 4u);
+    ASSERT_EQ(topology.node_count(), 2u);
+
+    for (auto i = 0u; i < cpus.size(); ++i)
+    {
+        ASSERT_EQ(cpus[i].id, i);
+        ASSERT_EQ(cpus[i].package, (i % 4u) / 2u);
+        ASSERT_EQ(cpus[i].node, (i % 4u) / 2u);
+        ASSERT_EQ(cpus[i].primary, i < 4u);
+
+        // siblings share a core
+        ASSERT_EQ(cpus[i].core, cpus[i % 4u].core);
+    }
+
+    // core ids are unique across packages
+    ASSERT_NE(cpus[0].core, cpus[2].core);
+    ASSERT_NE(cpus[0].core, cpus[1].core);
+}
+
+TEST_F(CpuTopologyTests, from_sysfs_no_nodes)
+{
+    std::filesystem::remove_all(root_ / "node");
+
+    const auto topology = iris::CpuTopology::from_sysfs(root_);
+
+    ASSERT_EQ(topology.cpus().size(), 8u);
+    ASSERT_EQ(topology.node_count(), 1u);
+}
+
+TEST_F(CpuTopologyTests, from_sysfs_missing)
+{
+    const auto topology = iris::CpuTopology::from_sysfs(root_ / "missing");
+
+    ASSERT_TRUE(topology.cpus().empty());
+}
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "core/pipelined_looper.h"
+#include "jobs/thread/thread_job_system.h"
+
+using namespace std::chrono_literals;
+
+TEST(pipelined_looper, renders_snapshots_in_order)
+{
+    for (auto depth = 1u; depth <= 3u; ++depth)
+    {
+        iris::ThreadJobSystem js{2u};
+        std::atomic<int> snapshots = 0;
+        auto rendered = 0;
+
+        iris::PipelinedLooper<int> looper{
+            0us,
+            1us,
+            depth,
+            js,
+            [](auto, auto) { return true; },
+            [&snapshots](int &frame) { frame = snapshots++; },
+            [&](const int &frame, auto, auto)
+            {
+                // frames are rendered in order, and only once simulated
+                EXPECT_EQ(frame, rendered);
+                EXPECT_GT(snapshots.load(), rendered);
+
+                ++rendered;
+                return rendered != 20;
+            }};
+
+        looper.run();
+
+        // frames still in the pipeline are simulated but not rendered
+        ASSERT_EQ(rendered, 20);
+        ASSERT_GE(snapshots, 20);
+        ASSERT_LE(snapshots, 20 + static_cast<int>(depth));
+    }
+}
+
+TEST(pipelined_looper, slow_simulation_frame_does_not_stall_render)
+{
+    for (auto depth = 2u; depth <= 3u; ++depth)
+    {
+        iris::ThreadJobSystem js{2u};
+        auto snapshots = 0;
+        std::atomic<bool> slow_running = false;
+        auto rendered = 0;
+        auto rendered_during_slow = 0;
+
+        iris::PipelinedLooper<int> looper{
+            0us,
+            1us,
+            depth,
+            js,
+            [](auto, auto) { return true; },
+            [&](int &)
+            {
+                // one frame, once the pipeline is full, takes much longer than
+                // rendering all the queued frames
+                if (++snapshots == 10)
+                {
+                    slow_running = true;
+                    std::this_thread::sleep_for(100ms);
+                    slow_running = false;
+                }
+            },
+            [&](const int &, auto, auto)
+            {
+                if (slow_running)
+                {
+                    ++rendered_during_slow;
+                }
+
+                std::this_thread::sleep_for(2ms);
+                return ++rendered != 20;
+            }};
+
+        looper.run();
+
+        // the queued frames are rendered whilst the slow frame simulates, bar
+        // possibly the first if it rendered before the job started
+        ASSERT_GE(rendered_during_slow, static_cast<int>(depth) - 1);
+    }
+}
+
+TEST(pipelined_looper, fixed_steps_consume_time)
+{
+    iris::ThreadJobSystem js{2u};
+    std::chrono::microseconds last_step_clock{};
+    std::chrono::microseconds last_render_clock{};
+    std::atomic<int> steps = 0;
+
+    iris::PipelinedLooper<std::chrono::microseconds> looper{
+        0us,
+        1ms,
+        1u,
+        js,
+        [&](auto clock, auto delta)
+        {
+            EXPECT_EQ(delta, 1ms);
+            EXPECT_EQ(clock, 1ms * steps.load());
+
+            last_step_clock = clock;
+            ++steps;
+            return true;
+        },
+        [&last_step_clock](std::chrono::microseconds &frame) { frame = last_step_clock; },
+        [&](const std::chrono::microseconds &, auto clock, auto)
+        {
+            last_render_clock = clock;
+            std::this_thread::sleep_for(2ms);
+            return steps < 10;
+        }};
+
+    looper.run();
+
+    ASSERT_GE(steps, 10);
+    ASSERT_LE(last_render_clock, 1ms * steps.load());
+}
+
+TEST(pipelined_looper, simulation_overlaps_render)
+{
+    static constexpr auto frame_count = 10;
+    static constexpr auto work = 20ms;
+
+    iris::ThreadJobSystem js{2u};
+    auto rendered = 0;
+
+    iris::PipelinedLooper<int> looper{
+        0us,
+        1ms,
+        1u,
+        js,
+        [](auto, auto) { return true; },
+        [](int &) { std::this_thread::sleep_for(work); },
+        [&rendered](const int &, auto, auto)
+        {
+            std::this_thread::sleep_for(work);
+            return ++rendered != frame_count;
+        }};
+
+    const auto start = std::chrono::steady_clock::now();
+    looper.run();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // sequentially this would take at least 2 * work per frame
+    ASSERT_LT(elapsed, work * frame_count * 2 * 3 / 4);
+}
+
+TEST(pipelined_looper, simulation_can_stop_loop)
+{
+    iris::ThreadJobSystem js{2u};
+    auto steps = 0;
+
+    iris::PipelinedLooper<int> looper{
+        0us,
+        1us,
+        2u,
+        js,
+        [&steps](auto, auto) { return ++steps != 5; },
+        [](int &) {},
+        [](const int &, auto, auto) { return true; }};
+
+    looper.run();
+
+    ASSERT_EQ(steps, 5);
+}
+
+TEST(pipelined_looper, simulation_exception_propagates)
+{
+    iris::ThreadJobSystem js{2u};
+
+    iris::PipelinedLooper<int> looper{
+        0us,
+        1us,
+        2u,
+        js,
+        [](auto, auto) -> bool { throw std::runtime_error("simulation failed"); },
+        [](int &) {},
+        [](const int &, auto, auto) { return true; }};
+
+    ASSERT_THROW(looper.run(), std::runtime_error);
+}
@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+class CountingMemoryResource : public std::pmr::memory_resource
+{
+  public:
+    std::size_t allocations() const
+    {
+        return allocations_;
+    }
+
+    std::size_t deallocations() const
+    {
+        return deallocations_;
+    }
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations_;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+    {
+        ++deallocations_;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::atomic<std::size_t> allocations_ = 0u;
+    std::atomic<std::size_t> deallocations_ = 0u;
+};
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+#include "core/colour.h"
+#include "core/data_buffer.h"
+#include "core/exception.h"
+#include "graphics/null/null_mesh_manager.h"
+#include "graphics/null/null_texture_manager.h"
+#include "graphics/null/null_window_manager.h"
+#include "graphics/render_target.h"
+#include "graphics/texture_usage.h"
+#include "graphics/window.h"
+
+#include <gtest/gtest.h>
+
+TEST(null_graphics, window_manager)
+{
+    iris::NullWindowManager window_manager{};
+
+    ASSERT_EQ(window_manager.current_window(), nullptr);
+
+    auto *window = window_manager.create_window(800u, 600u);
+
+    ASSERT_EQ(window_manager.current_window(), window);
+    ASSERT_EQ(window->width(), 800u);
+    ASSERT_EQ(window->height(), 600u);
+    ASSERT_EQ(window->screen_scale(), 1u);
+    ASSERT_FALSE(window->pump_event().has_value());
+    ASSERT_THROW(window_manager.create_window(800u, 600u), iris::Exception);
+}
+
+TEST(null_graphics, window_render)
+{
+    iris::NullWindowManager window_manager{};
+    auto *window = window_manager.create_window(800u, 600u);
+
+    window->set_render_passes({});
+    window->render();
+}
+
+TEST(null_graphics, render_target)
+{
+    iris::NullWindowManager window_manager{};
+    auto *window = window_manager.create_window(800u, 600u);
+
+    const auto *default_target = window->create_render_target();
+    ASSERT_EQ(default_target->width(), 800u);
+    ASSERT_EQ(default_target->height(), 600u);
+
+    const auto *target = window->create_render_target(100u, 200u);
+    ASSERT_NE(target, default_target);
+    ASSERT_EQ(target->width(), 100u);
+    ASSERT_EQ(target->height(), 200u);
+    ASSERT_EQ(target->colour_texture()->usage(), iris::TextureUsage::RENDER_TARGET);
+    ASSERT_EQ(target->depth_texture()->usage(), iris::TextureUsage::DEPTH);
+}
+
+TEST(null_graphics, texture_discards_data)
+{
+    iris::NullTextureManager texture_manager{};
+
+    const iris::DataBuffer data(4u * 2u * 2u, std::byte{0xff});
+    const auto *texture = texture_manager.create(data, 2u, 2u, iris::TextureUsage::IMAGE);
+
+    ASSERT_EQ(texture->width(), 2u);
+    ASSERT_EQ(texture->height(), 2u);
+    ASSERT_EQ(texture->usage(), iris::TextureUsage::IMAGE);
+    ASSERT_TRUE(texture->data().empty());
+}
+
+TEST(null_graphics, mesh_manager)
+{
+    iris::NullMeshManager mesh_manager{};
+
+    auto *mesh = mesh_manager.cube(iris::Colour{1.0f, 0.0f, 0.0f});
+
+    ASSERT_NE(mesh, nullptr);
+    ASSERT_EQ(mesh_manager.cube(iris::Colour{1.0f, 0.0f, 0.0f}), mesh);
+
+    mesh->update_vertex_data({});
+    mesh->update_index_data({});
+}
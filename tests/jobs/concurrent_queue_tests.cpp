@@ -5,6 +5,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <numeric>
 #include <thread>
 #include <vector>
@@ -12,6 +15,88 @@
 #include <gtest/gtest.h>
 
 #include "jobs/concurrent_queue.h"
+#include "jobs/mpmc_queue.h"
+#include "jobs/spsc_queue.h"
+
+namespace
+{
+
+/**
+ * Helper to push values through a queue from multiple producers to multiple
+ * consumers.
+ *
+ * @param q
+ *   Queue to use.
+ *
+ * @param producers
+ *   Number of producer threads.
+ *
+ * @param consumers
+ *   Number of consumer threads.
+ *
+ * @param per_producer
+ *   Number of values each producer enqueues.
+ *
+ * @returns
+ *   All dequeued values, sorted.
+ */
+template <class Queue>
+std::vector<int> transfer(Queue &q, int producers, int consumers, int per_producer)
+{
+    const auto total = producers * per_producer;
+    std::atomic<int> remaining = total;
+    std::vector<std::vector<int>> popped(consumers);
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0; i < producers; ++i)
+    {
+        threads.emplace_back(
+            [&q, i, per_producer]
+            {
+                for (auto j = 0; j < per_producer; ++j)
+                {
+                    q.enqueue(i * per_producer + j);
+                }
+            });
+    }
+
+    for (auto i = 0; i < consumers; ++i)
+    {
+        threads.emplace_back(
+            [&q, &remaining, &values = popped[i]]
+            {
+                while (remaining > 0)
+                {
+                    auto element = 0;
+                    if (q.try_dequeue(element))
+                    {
+                        values.emplace_back(element);
+                        --remaining;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<int> values{};
+    for (const auto &v : popped)
+    {
+        values.insert(values.end(), v.begin(), v.end());
+    }
+
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+}
 
 TEST(concurrent_queue, constructor)
 {
@@ -75,3 +160,140 @@ TEST(concurrent_queue, enqueue_thread_safe)
     std::sort(std::begin(popped), std::end(popped));
     ASSERT_EQ(popped, values);
 }
+
+TEST(mpmc_queue, constructor)
+{
+    iris::MpmcQueue<int> q{8u};
+
+    ASSERT_TRUE(q.empty());
+    ASSERT_EQ(q.capacity(), 8u);
+}
+
+TEST(mpmc_queue, fifo)
+{
+    iris::MpmcQueue<int> q{8u};
+    q.enqueue(1);
+    q.enqueue(2);
+    auto value = 0;
+
+    ASSERT_FALSE(q.empty());
+    ASSERT_TRUE(q.try_dequeue(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(q.try_dequeue(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_FALSE(q.try_dequeue(value));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue, full)
+{
+    iris::MpmcQueue<int> q{4u};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(q.try_enqueue(i));
+    }
+
+    ASSERT_FALSE(q.try_enqueue(4));
+
+    auto value = 0;
+    ASSERT_TRUE(q.try_dequeue(value));
+    ASSERT_EQ(value, 0);
+    ASSERT_TRUE(q.try_enqueue(4));
+}
+
+TEST(mpmc_queue, wraps_around)
+{
+    iris::MpmcQueue<int> q{4u};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        auto value = 0;
+        ASSERT_TRUE(q.try_enqueue(i));
+        ASSERT_TRUE(q.try_dequeue(value));
+        ASSERT_EQ(value, i);
+    }
+}
+
+TEST(mpmc_queue, move_only_elements)
+{
+    iris::MpmcQueue<std::unique_ptr<int>> q{4u};
+    q.enqueue(std::make_unique<int>(1));
+    std::unique_ptr<int> value{};
+
+    ASSERT_TRUE(q.try_dequeue(value));
+    ASSERT_EQ(*value, 1);
+}
+
+TEST(mpmc_queue, multi_producer_stress)
+{
+    static constexpr auto per_producer = 50000;
+
+    // small capacity so producers regularly find the queue full
+    iris::MpmcQueue<int> q{64u};
+    std::vector<int> expected(8 * per_producer);
+    std::iota(std::begin(expected), std::end(expected), 0);
+
+    ASSERT_EQ(transfer(q, 8, 4, per_producer), expected);
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(spsc_queue, fifo)
+{
+    iris::SpscQueue<int> q{4u};
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(q.try_enqueue(i));
+    }
+
+    ASSERT_FALSE(q.try_enqueue(4));
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        auto value = 0;
+        ASSERT_TRUE(q.try_dequeue(value));
+        ASSERT_EQ(value, i);
+    }
+
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(spsc_queue, stress_keeps_order)
+{
+    static constexpr auto value_count = 200000;
+    iris::SpscQueue<int> q{64u};
+
+    std::thread producer{[&q]
+                         {
+                             for (auto i = 0; i < value_count; ++i)
+                             {
+                                 q.enqueue(i);
+                             }
+                         }};
+
+    std::vector<int> values{};
+    values.reserve(value_count);
+
+    while (values.size() < static_cast<std::size_t>(value_count))
+    {
+        auto value = 0;
+        if (q.try_dequeue(value))
+        {
+            values.emplace_back(value);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // join before asserting, a failed assert returns early and destroying a
+    // joinable thread terminates
+    producer.join();
+
+    std::vector<int> expected(value_count);
+    std::iota(std::begin(expected), std::end(expected), 0);
+
+    ASSERT_EQ(values, expected);
+}
@@ -6,11 +6,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <mutex>
 #include <thread>
 
 #include "core/exception.h"
 #include "jobs/fiber/counter.h"
+#include "jobs/fiber/fiber.h"
 
 TEST(counter, constructor)
 {
@@ -59,3 +61,64 @@ TEST(counter, thread_safe)
 
     ASSERT_EQ(static_cast<int>(ctr), 0);
 }
+
+TEST(counter, decrement_releases_waiters)
+{
+    iris::Counter ctr(2);
+    iris::Fiber fiber1{nullptr};
+    iris::Fiber fiber2{nullptr};
+
+    ASSERT_TRUE(ctr.add_waiter(&fiber1));
+    ASSERT_TRUE(ctr.add_waiter(&fiber2));
+
+    ASSERT_EQ(ctr.decrement(), nullptr);
+
+    auto *waiters = ctr.decrement();
+    ASSERT_EQ(waiters, &fiber2);
+    ASSERT_EQ(waiters->next_waiter(), &fiber1);
+    ASSERT_EQ(waiters->next_waiter()->next_waiter(), nullptr);
+}
+
+TEST(counter, add_waiter_after_zero)
+{
+    iris::Counter ctr(1);
+    iris::Fiber fiber{nullptr};
+
+    ASSERT_FALSE(ctr.is_released());
+    ASSERT_EQ(ctr.decrement(), nullptr);
+    ASSERT_TRUE(ctr.is_released());
+    ASSERT_FALSE(ctr.add_waiter(&fiber));
+}
+
+TEST(counter, waiters_released_once)
+{
+    static constexpr auto value = 10000;
+    iris::Counter ctr(value);
+    iris::Fiber fiber{nullptr};
+    std::atomic<int> released = 0;
+
+    ASSERT_TRUE(ctr.add_waiter(&fiber));
+
+    auto dec_thread = [&ctr, &released]() {
+        for (auto i = 0; i < value / 4; ++i)
+        {
+            if (ctr.decrement() != nullptr)
+            {
+                ++released;
+            }
+        }
+    };
+
+    std::thread thrd1{dec_thread};
+    std::thread thrd2{dec_thread};
+    std::thread thrd3{dec_thread};
+    std::thread thrd4{dec_thread};
+
+    thrd1.join();
+    thrd2.join();
+    thrd3.join();
+    thrd4.join();
+
+    ASSERT_EQ(static_cast<int>(ctr), 0);
+    ASSERT_EQ(released, 1);
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "jobs/fiber/fiber_event.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/job.h"
+
+TEST(fiber_event, constructor)
+{
+    iris::FiberEvent event{};
+
+    ASSERT_FALSE(event.is_set());
+}
+
+TEST(fiber_event, set_reset)
+{
+    iris::FiberEvent event{};
+
+    event.set();
+    ASSERT_TRUE(event.is_set());
+
+    // already set, so should not wait
+    event.wait();
+
+    event.reset();
+    ASSERT_FALSE(event.is_set());
+}
+
+TEST(fiber_event, wakes_threads)
+{
+    iris::FiberEvent event{};
+    std::atomic<int> woken = 0;
+
+    const auto work = [&]
+    {
+        event.wait();
+        ++woken;
+    };
+
+    std::thread thrd1{work};
+    std::thread thrd2{work};
+
+    event.set();
+
+    thrd1.join();
+    thrd2.join();
+
+    ASSERT_EQ(woken, 2);
+}
+
+TEST(fiber_event, waiting_fibers_do_not_block_worker)
+{
+    // more waiters than workers, if waiting blocked the thread then the job
+    // setting the event would never run
+    static constexpr auto waiter_count = 16;
+
+    iris::FiberJobSystem js{2u};
+    iris::FiberEvent event{};
+    std::atomic<int> woken = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < waiter_count; ++i)
+    {
+        jobs.emplace_back(
+            [&]
+            {
+                event.wait();
+                ++woken;
+            });
+    }
+    jobs.emplace_back([&] { event.set(); });
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(woken, waiter_count);
+}
+
+TEST(fiber_event, thread_waits_on_fiber)
+{
+    iris::FiberJobSystem js{1u};
+    iris::FiberEvent event{};
+
+    js.add_jobs({[&] { event.set(); }});
+
+    event.wait();
+
+    ASSERT_TRUE(event.is_set());
+}
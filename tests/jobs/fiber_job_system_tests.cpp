@@ -6,6 +6,217 @@
 
 #include "jobs/job_system_tests.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/fiber.h"
 #include "jobs/fiber/fiber_job_system.h"
+#include "jobs/job.h"
 
 INSTANTIATE_TYPED_TEST_SUITE_P(fiber, JobSystemTests, iris::FiberJobSystem);
+
+TEST(fiber_job_system, wait_for_jobs_many_workers)
+{
+    iris::FiberJobSystem js{8u};
+    std::atomic<int> counter = 0;
+
+    // each job spawns children on its own worker, which idle workers must
+    // steal to make progress
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < 16; ++i)
+    {
+        jobs.emplace_back(
+            [&js, &counter]()
+            {
+                std::vector<iris::Job> children(16u, [&counter]() { ++counter; });
+                js.wait_for_jobs(children);
+            });
+    }
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(counter, 16 * 16);
+}
+
+TEST(fiber_job_system, wait_for_jobs_does_not_spin)
+{
+    iris::FiberJobSystem js{4u};
+    const auto before = js.stats();
+
+    const auto cpu_start = std::clock();
+    const auto wall_start = std::chrono::steady_clock::now();
+
+    // bootstrap fiber waits on outer job which waits on two long running
+    // children, whilst they run the waiting fibers should stay parked
+    js.wait_for_jobs({[&js]()
+                      {
+                          js.wait_for_jobs(
+                              {[]() { std::this_thread::sleep_for(std::chrono::milliseconds(250)); },
+                               []() { std::this_thread::sleep_for(std::chrono::milliseconds(250)); }});
+                      }});
+
+    const auto cpu_seconds = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    const auto wall_seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+    const auto after = js.stats();
+
+    // every dequeue should do useful work: four fibers started and the two
+    // waiting fibers resumed exactly once
+    ASSERT_EQ(after.starts - before.starts, 4u);
+    ASSERT_EQ(after.resumes - before.resumes, 2u);
+    ASSERT_EQ(after.dequeues - before.dequeues, 6u);
+
+#if !defined(IRIS_PLATFORM_WIN32)
+    // std::clock is wall time on windows, elsewhere it is process cpu time
+    // which should be a small fraction of the time spent waiting
+    ASSERT_LT(cpu_seconds, wall_seconds * 0.25);
+#else
+    (void)cpu_seconds;
+    (void)wall_seconds;
+#endif
+}
+
+TEST(fiber_job_system, fibers_are_reused)
+{
+    iris::FiberJobSystem js{{.worker_count = 2u, .stack_pages = 16u, .max_pooled_fibers = 64u}};
+    std::atomic<int> counter = 0;
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        js.wait_for_jobs({[&counter]() { ++counter; }, [&counter]() { ++counter; }});
+    }
+
+    const auto stats = js.stats();
+
+    ASSERT_EQ(counter, 200);
+    ASSERT_EQ(stats.pool.hits + stats.pool.misses, 300u);
+    ASSERT_GT(stats.pool.hits, stats.pool.misses);
+    ASSERT_LE(stats.pool.peak_live, 6u);
+}
+
+TEST(fiber_job_system, job_ids_are_unique)
+{
+    iris::FiberJobSystem js{{.worker_count = 1u, .stack_pages = 16u, .max_pooled_fibers = 64u}};
+    std::uint64_t first = 0u;
+    std::uint64_t second = 0u;
+
+    // sequential jobs will likely run on the same pooled fiber, but must still
+    // be told apart in traces
+    js.wait_for_jobs({[&first]() { first = (*iris::Fiber::this_fiber())->id(); }});
+    js.wait_for_jobs({[&second]() { second = (*iris::Fiber::this_fiber())->id(); }});
+
+    ASSERT_NE(first, 0u);
+    ASSERT_NE(second, 0u);
+    ASSERT_NE(first, second);
+}
+
+TEST(fiber_job_system, idle_workers_park)
+{
+    iris::FiberJobSystem js{{.worker_count = 4u, .idle = {.spin_count = 0u, .yield_count = 0u}}};
+
+    // give the workers a chance to run out of things to look for
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_GE(js.stats().parks, 4u);
+
+    std::atomic<bool> done = false;
+    js.add_jobs({[&done]() { done = true; }});
+
+    while (!done)
+    {
+        std::this_thread::yield();
+    }
+
+    const auto stats = js.stats();
+
+    ASSERT_GE(stats.wake_calls, 1u);
+    ASSERT_GE(stats.wakeups, 1u);
+}
+
+TEST(fiber_job_system, wake_latency_only_counts_issued_wakes)
+{
+    // add work whilst workers are still starting up and parking, so some
+    // return from waiting without ever being woken, a fresh job system each
+    // time means there may not have been any wake at all yet
+    for (auto i = 0u; i < 50u; ++i)
+    {
+        iris::FiberJobSystem js{{.worker_count = 4u, .idle = {.spin_count = 0u, .yield_count = 0u}}};
+
+        for (auto j = 0u; j < 10u; ++j)
+        {
+            std::atomic<bool> done = false;
+            js.add_jobs({[&done]() { done = true; }});
+
+            while (!done)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        const auto stats = js.stats();
+
+        // counting a stale wake would add its age (or the time since boot)
+        ASSERT_LE(stats.wakeups, stats.parks);
+        if (stats.wakeups != 0u)
+        {
+            ASSERT_LT(stats.wake_latency_ns / stats.wakeups, 1'000'000'000u);
+        }
+    }
+}
+
+TEST(fiber_job_system, wakes_are_batched)
+{
+    iris::FiberJobSystem js{{.worker_count = 4u, .idle = {.spin_count = 0u, .yield_count = 0u}}};
+    std::atomic<int> counter = 0;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto before = js.stats();
+
+    // one batch of jobs should cost at most one wake, not one per job
+    js.add_jobs(std::vector<iris::Job>(64u, [&counter]() { ++counter; }));
+
+    while (counter != 64)
+    {
+        std::this_thread::yield();
+    }
+
+    const auto after = js.stats();
+
+    ASSERT_EQ(after.starts - before.starts, 64u);
+    ASSERT_LE(after.wake_calls - before.wake_calls, 1u);
+}
+
+#if !defined(IRIS_PLATFORM_WIN32)
+
+TEST(fiber_job_system, stack_high_water)
+{
+    static constexpr auto used_bytes = 8192u;
+
+    iris::FiberJobSystem js{{.worker_count = 2u, .stack_pages = 16u, .paint_stacks = true}};
+
+    js.wait_for_jobs(
+        {[]()
+         {
+             volatile std::byte buffer[used_bytes];
+             for (auto &b : buffer)
+             {
+                 b = std::byte{0x0};
+             }
+         }},
+        iris::JobPriority::BACKGROUND);
+
+    const auto high_water = js.stats().pool.stack_high_water;
+
+    ASSERT_GE(high_water[static_cast<std::size_t>(iris::JobPriority::BACKGROUND)], used_bytes);
+    ASSERT_LT(high_water[static_cast<std::size_t>(iris::JobPriority::BACKGROUND)], 16u * 4096u);
+    ASSERT_EQ(high_water[static_cast<std::size_t>(iris::JobPriority::CRITICAL)], 0u);
+}
+
+#endif
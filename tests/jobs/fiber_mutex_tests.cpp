@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_mutex.h"
+#include "jobs/job.h"
+
+TEST(fiber_mutex, try_lock)
+{
+    iris::FiberMutex mutex{};
+
+    ASSERT_TRUE(mutex.try_lock());
+    ASSERT_FALSE(mutex.try_lock());
+
+    mutex.unlock();
+
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(fiber_mutex, threads_contend)
+{
+    static constexpr auto iterations = 10000;
+
+    iris::FiberMutex mutex{};
+    auto value = 0;
+
+    const auto work = [&]
+    {
+        for (auto i = 0; i < iterations; ++i)
+        {
+            std::scoped_lock lock(mutex);
+            ++value;
+        }
+    };
+
+    std::thread thrd1{work};
+    std::thread thrd2{work};
+    std::thread thrd3{work};
+    std::thread thrd4{work};
+
+    thrd1.join();
+    thrd2.join();
+    thrd3.join();
+    thrd4.join();
+
+    ASSERT_EQ(value, iterations * 4);
+}
+
+TEST(fiber_mutex, more_fibers_than_workers_contend)
+{
+    static constexpr auto fiber_count = 64;
+    static constexpr auto iterations = 1000;
+
+    iris::FiberJobSystem js{2u};
+    iris::FiberMutex mutex{};
+    auto value = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < fiber_count; ++i)
+    {
+        jobs.emplace_back(
+            [&]
+            {
+                for (auto j = 0; j < iterations; ++j)
+                {
+                    std::scoped_lock lock(mutex);
+                    ++value;
+                }
+            });
+    }
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(value, fiber_count * iterations);
+}
+
+TEST(fiber_mutex, held_across_suspend_does_not_block_worker)
+{
+    // a single worker, so if waiting on the mutex blocked the thread the
+    // holder could never run again to release it
+    iris::FiberJobSystem js{1u};
+    iris::FiberMutex mutex{};
+    auto value = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < 4; ++i)
+    {
+        jobs.emplace_back(
+            [&]
+            {
+                std::scoped_lock lock(mutex);
+                js.wait_for_jobs({[&] { ++value; }});
+            });
+    }
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(value, 4);
+}
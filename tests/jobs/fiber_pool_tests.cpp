@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/fiber.h"
+#include "jobs/fiber/fiber_pool.h"
+#include "jobs/job_priority.h"
+
+TEST(fiber_pool, constructor)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.hits, 0u);
+    ASSERT_EQ(stats.misses, 0u);
+    ASSERT_EQ(stats.live, 0u);
+    ASSERT_EQ(stats.peak_live, 0u);
+    ASSERT_EQ(pool.shared_cache(), 2u);
+}
+
+TEST(fiber_pool, acquire_empty_pool_misses)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber = pool.acquire(0u, nullptr, nullptr);
+    const auto stats = pool.stats();
+
+    ASSERT_NE(fiber, nullptr);
+    ASSERT_EQ(stats.hits, 0u);
+    ASSERT_EQ(stats.misses, 1u);
+    ASSERT_EQ(stats.live, 1u);
+
+    pool.release(0u, fiber);
+}
+
+TEST(fiber_pool, acquire_reuses_released_fiber)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber1 = pool.acquire(0u, nullptr, nullptr);
+    pool.release(0u, fiber1);
+
+    auto *fiber2 = pool.acquire(0u, nullptr, nullptr);
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(fiber1, fiber2);
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 1u);
+    ASSERT_EQ(stats.live, 1u);
+
+    pool.release(0u, fiber2);
+}
+
+TEST(fiber_pool, acquire_falls_back_to_shared_cache)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber1 = pool.acquire(pool.shared_cache(), nullptr, nullptr);
+    pool.release(pool.shared_cache(), fiber1);
+
+    auto *fiber2 = pool.acquire(1u, nullptr, nullptr);
+
+    ASSERT_EQ(fiber1, fiber2);
+    ASSERT_EQ(pool.stats().hits, 1u);
+
+    pool.release(1u, fiber2);
+}
+
+TEST(fiber_pool, acquire_does_not_use_other_worker_cache)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber1 = pool.acquire(0u, nullptr, nullptr);
+    pool.release(0u, fiber1);
+
+    auto *fiber2 = pool.acquire(1u, nullptr, nullptr);
+
+    ASSERT_NE(fiber1, fiber2);
+    ASSERT_EQ(pool.stats().misses, 2u);
+
+    pool.release(1u, fiber2);
+}
+
+TEST(fiber_pool, release_returns_shared_fiber_to_shared_cache)
+{
+    // a job added from outside the job system is released by a worker
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber1 = pool.acquire(pool.shared_cache(), nullptr, nullptr);
+    pool.release(0u, fiber1);
+
+    auto *fiber2 = pool.acquire(pool.shared_cache(), nullptr, nullptr);
+
+    ASSERT_EQ(fiber1, fiber2);
+    ASSERT_EQ(pool.stats().hits, 1u);
+
+    pool.release(pool.shared_cache(), fiber2);
+}
+
+TEST(fiber_pool, release_to_full_cache_destroys_fiber)
+{
+    // 3 caches with a total limit of 3 means each holds one fiber
+    iris::FiberPool pool{2u, 4u, 3u};
+    auto *fiber1 = pool.acquire(0u, nullptr, nullptr);
+    auto *fiber2 = pool.acquire(0u, nullptr, nullptr);
+    pool.release(0u, fiber1);
+    pool.release(0u, fiber2);
+
+    auto *fiber3 = pool.acquire(0u, nullptr, nullptr);
+    auto *fiber4 = pool.acquire(0u, nullptr, nullptr);
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.hits, 1u);
+    ASSERT_EQ(stats.misses, 3u);
+
+    pool.release(0u, fiber3);
+    pool.release(0u, fiber4);
+}
+
+TEST(fiber_pool, peak_live)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber1 = pool.acquire(0u, nullptr, nullptr);
+    auto *fiber2 = pool.acquire(1u, nullptr, nullptr);
+    auto *fiber3 = pool.acquire(2u, nullptr, nullptr);
+    pool.release(0u, fiber1);
+    pool.release(1u, fiber2);
+    pool.release(2u, fiber3);
+    const auto stats = pool.stats();
+
+    ASSERT_EQ(stats.live, 0u);
+    ASSERT_EQ(stats.peak_live, 3u);
+}
+
+TEST(fiber_pool, per_priority_stack_sizes)
+{
+    iris::FiberPool pool{2u, {8u, 4u, 4u}, 12u, false};
+    auto *critical = pool.acquire(0u, nullptr, nullptr, iris::JobPriority::CRITICAL);
+    auto *normal = pool.acquire(0u, nullptr, nullptr, iris::JobPriority::NORMAL);
+
+    ASSERT_EQ(critical->stack_pages(), 8u);
+    ASSERT_EQ(critical->priority(), iris::JobPriority::CRITICAL);
+    ASSERT_EQ(normal->stack_pages(), 4u);
+
+    pool.release(0u, critical);
+    pool.release(0u, normal);
+
+    // only fibers with the right stack size are reused
+    auto *background = pool.acquire(0u, nullptr, nullptr, iris::JobPriority::BACKGROUND);
+    auto *critical2 = pool.acquire(0u, nullptr, nullptr, iris::JobPriority::CRITICAL);
+
+    ASSERT_EQ(background, normal);
+    ASSERT_EQ(critical2, critical);
+    ASSERT_EQ(pool.stats().hits, 2u);
+
+    pool.release(0u, background);
+    pool.release(0u, critical2);
+}
+
+TEST(fiber_pool, unpainted_stacks_have_no_high_water)
+{
+    iris::FiberPool pool{2u, 4u, 12u};
+    auto *fiber = pool.acquire(0u, nullptr, nullptr);
+
+    ASSERT_EQ(fiber->stack_high_water(), 0u);
+
+    pool.release(0u, fiber);
+
+    for (const auto high_water : pool.stats().stack_high_water)
+    {
+        ASSERT_EQ(high_water, 0u);
+    }
+}
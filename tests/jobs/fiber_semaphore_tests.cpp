@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/fiber/fiber_semaphore.h"
+#include "jobs/job.h"
+
+TEST(fiber_semaphore, try_acquire)
+{
+    iris::FiberSemaphore semaphore{2};
+
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_TRUE(semaphore.try_acquire());
+    ASSERT_FALSE(semaphore.try_acquire());
+
+    semaphore.release(2);
+
+    ASSERT_TRUE(semaphore.try_acquire());
+}
+
+TEST(fiber_semaphore, limits_concurrency)
+{
+    static constexpr auto fiber_count = 64;
+    static constexpr auto limit = 3;
+
+    iris::FiberJobSystem js{4u};
+    iris::FiberSemaphore semaphore{limit};
+    std::atomic<int> active = 0;
+    std::atomic<int> max_active = 0;
+
+    std::vector<iris::Job> jobs{};
+    for (auto i = 0; i < fiber_count; ++i)
+    {
+        jobs.emplace_back(
+            [&]
+            {
+                semaphore.acquire();
+
+                const auto now = ++active;
+                auto max = max_active.load();
+                while ((now > max) && !max_active.compare_exchange_weak(max, now))
+                {
+                }
+
+                // suspend whilst holding, so other fibers pile up on the
+                // semaphore
+                js.wait_for_jobs({[] {}});
+
+                --active;
+                semaphore.release();
+            });
+    }
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_LE(max_active, limit);
+    ASSERT_TRUE(semaphore.try_acquire());
+}
+
+TEST(fiber_semaphore, producer_consumer)
+{
+    static constexpr auto item_count = 100;
+
+    // one worker so a blocked consumer would deadlock the producer
+    iris::FiberJobSystem js{1u};
+    iris::FiberSemaphore semaphore{};
+    auto consumed = 0;
+
+    js.wait_for_jobs(
+        {[&]
+         {
+             for (auto i = 0; i < item_count; ++i)
+             {
+                 semaphore.acquire();
+                 ++consumed;
+             }
+         },
+         [&]
+         {
+             for (auto i = 0; i < item_count; ++i)
+             {
+                 semaphore.release();
+             }
+         }});
+
+    ASSERT_EQ(consumed, item_count);
+}
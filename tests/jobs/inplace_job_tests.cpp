@@ -0,0 +1,261 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fakes/counting_memory_resource.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job.h"
+#include "jobs/job_arena.h"
+#include "jobs/thread/thread_job_system.h"
+
+namespace
+{
+
+/**
+ * Callable which counts how often it is copied, moved, called and destroyed.
+ * It also records where it was when last called, so tests can check where a
+ * job stored it.
+ */
+template <std::size_t N>
+struct Tracked
+{
+    struct Counts
+    {
+        std::atomic<int> copies = 0;
+        std::atomic<int> calls = 0;
+        std::atomic<int> destroys = 0;
+        std::atomic<const void *> address = nullptr;
+    };
+
+    explicit Tracked(Counts &counts)
+        : counts(&counts)
+        , padding()
+    {
+    }
+
+    Tracked(const Tracked &other)
+        : counts(other.counts)
+        , padding(other.padding)
+    {
+        ++counts->copies;
+    }
+
+    Tracked(Tracked &&other) noexcept
+        : counts(std::exchange(other.counts, nullptr))
+        , padding(other.padding)
+    {
+    }
+
+    ~Tracked()
+    {
+        if (counts != nullptr)
+        {
+            ++counts->destroys;
+        }
+    }
+
+    void operator()() const
+    {
+        ++counts->calls;
+        counts->address = this;
+    }
+
+    Counts *counts;
+    std::array<std::byte, N> padding;
+};
+
+using SmallJob = Tracked<32u>;
+using BigJob = Tracked<256u>;
+
+static_assert(iris::InplaceJob::fits_inline<SmallJob>);
+static_assert(!iris::InplaceJob::fits_inline<BigJob>);
+
+/**
+ * Check if an address lies within the bytes of an object.
+ *
+ * @param address
+ *   Address to check.
+ *
+ * @param object
+ *   Object to check against.
+ *
+ * @returns
+ *   True if address is inside object.
+ */
+template <class T>
+bool is_inside(const void *address, const T &object)
+{
+    const auto *begin = reinterpret_cast<const std::byte *>(std::addressof(object));
+    const auto *ptr = static_cast<const std::byte *>(address);
+
+    return std::less_equal<>{}(begin, ptr) && std::less<>{}(ptr, begin + sizeof(T));
+}
+
+}
+
+TEST(inplace_job, default_constructor)
+{
+    iris::InplaceJob job{};
+
+    ASSERT_FALSE(job);
+}
+
+TEST(inplace_job, inline_callable_does_not_allocate)
+{
+    SmallJob::Counts counts{};
+
+    {
+        iris::InplaceJob job{SmallJob{counts}};
+        auto moved = std::move(job);
+
+        ASSERT_FALSE(job);
+        ASSERT_TRUE(moved);
+
+        moved();
+
+        // callable ran from inside the job itself, so nothing was allocated
+        ASSERT_TRUE(is_inside(counts.address, moved));
+    }
+
+    ASSERT_EQ(counts.copies, 0);
+    ASSERT_EQ(counts.calls, 1);
+    ASSERT_EQ(counts.destroys, 1);
+}
+
+TEST(inplace_job, move_only_callable)
+{
+    auto value = std::make_unique<int>(0);
+    auto *ptr = value.get();
+
+    iris::InplaceJob job{[value = std::move(value)]() { ++*value; }};
+    job();
+
+    ASSERT_EQ(*ptr, 1);
+}
+
+TEST(inplace_job, wrap_job)
+{
+    SmallJob::Counts counts{};
+    iris::Job function = SmallJob{counts};
+    const auto copies = counts.copies.load();
+
+    iris::InplaceJob job{std::move(function)};
+    auto moved = std::move(job);
+    moved();
+
+    // the Job is moved inline, its target is never copied
+    ASSERT_EQ(counts.copies, copies);
+    ASSERT_EQ(counts.calls, 1);
+}
+
+TEST(inplace_job, small_callable_with_arena_stays_inline)
+{
+    CountingMemoryResource resource{};
+    iris::JobArena arena{1024u, &resource};
+    SmallJob::Counts counts{};
+
+    iris::InplaceJob job{SmallJob{counts}, arena};
+    job();
+
+    ASSERT_TRUE(is_inside(counts.address, job));
+    ASSERT_EQ(arena.used(), 0u);
+    ASSERT_EQ(resource.allocations(), 1u);
+    ASSERT_EQ(counts.calls, 1);
+}
+
+TEST(inplace_job, big_callable_uses_arena)
+{
+    CountingMemoryResource resource{};
+    iris::JobArena arena{4096u, &resource};
+    BigJob::Counts counts{};
+
+    {
+        std::vector<iris::InplaceJob> jobs{};
+        jobs.reserve(8u);
+
+        for (auto i = 0u; i < 8u; ++i)
+        {
+            jobs.emplace_back(BigJob{counts}, arena);
+        }
+
+        for (auto &job : jobs)
+        {
+            job();
+
+            ASSERT_FALSE(is_inside(counts.address, job));
+        }
+    }
+
+    // the arena only allocated its block once, on construction, and every
+    // callable was placed in it
+    ASSERT_EQ(resource.allocations(), 1u);
+    ASSERT_GE(arena.used(), 8u * sizeof(BigJob));
+    ASSERT_EQ(counts.copies, 0);
+    ASSERT_EQ(counts.calls, 8);
+    ASSERT_EQ(counts.destroys, 8);
+}
+
+TEST(inplace_job, fiber_job_system_does_not_copy)
+{
+    iris::FiberJobSystem js{2u};
+    CountingMemoryResource resource{};
+    iris::JobArena arena{4096u, &resource};
+    SmallJob::Counts small_counts{};
+    BigJob::Counts big_counts{};
+
+    std::vector<iris::InplaceJob> jobs{};
+    for (auto i = 0u; i < 8u; ++i)
+    {
+        jobs.emplace_back(SmallJob{small_counts});
+        jobs.emplace_back(BigJob{big_counts}, arena);
+    }
+
+    js.wait_for_jobs(std::move(jobs));
+
+    ASSERT_EQ(small_counts.copies, 0);
+    ASSERT_EQ(small_counts.calls, 8);
+    ASSERT_EQ(small_counts.destroys, 8);
+    ASSERT_EQ(big_counts.copies, 0);
+    ASSERT_EQ(big_counts.calls, 8);
+    ASSERT_EQ(big_counts.destroys, 8);
+    ASSERT_EQ(resource.allocations(), 1u);
+}
+
+TEST(inplace_job, thread_job_system_does_not_copy)
+{
+    iris::ThreadJobSystem js{2u};
+    CountingMemoryResource resource{};
+    iris::JobArena arena{4096u, &resource};
+    SmallJob::Counts small_counts{};
+    BigJob::Counts big_counts{};
+
+    std::vector<iris::InplaceJob> jobs{};
+    for (auto i = 0u; i < 8u; ++i)
+    {
+        jobs.emplace_back(SmallJob{small_counts});
+        jobs.emplace_back(BigJob{big_counts}, arena);
+    }
+
+    js.wait_for_jobs(std::move(jobs));
+
+    ASSERT_EQ(small_counts.copies, 0);
+    ASSERT_EQ(small_counts.calls, 8);
+    ASSERT_EQ(small_counts.destroys, 8);
+    ASSERT_EQ(big_counts.copies, 0);
+    ASSERT_EQ(big_counts.calls, 8);
+    ASSERT_EQ(big_counts.destroys, 8);
+    ASSERT_EQ(resource.allocations(), 1u);
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fakes/counting_memory_resource.h"
+#include "jobs/job_arena.h"
+
+TEST(job_arena, constructor)
+{
+    CountingMemoryResource resource{};
+
+    {
+        iris::JobArena arena{1024u, &resource};
+
+        ASSERT_EQ(arena.used(), 0u);
+        ASSERT_EQ(resource.allocations(), 1u);
+    }
+
+    ASSERT_EQ(resource.deallocations(), 1u);
+}
+
+TEST(job_arena, allocate_is_aligned)
+{
+    CountingMemoryResource resource{};
+    iris::JobArena arena{1024u, &resource};
+
+    arena.allocate(1u, 1u);
+    auto *ptr = arena.allocate(8u, 64u);
+
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64u, 0u);
+    ASSERT_EQ(resource.allocations(), 1u);
+}
+
+TEST(job_arena, overflow_uses_upstream)
+{
+    CountingMemoryResource resource{};
+    iris::JobArena arena{64u, &resource};
+
+    arena.allocate(64u, 8u);
+    ASSERT_EQ(resource.allocations(), 1u);
+
+    ASSERT_NE(arena.allocate(64u, 8u), nullptr);
+    ASSERT_GT(resource.allocations(), 1u);
+}
+
+TEST(job_arena, reset)
+{
+    CountingMemoryResource resource{};
+    iris::JobArena arena{64u, &resource};
+
+    auto *ptr1 = arena.allocate(32u, 8u);
+    arena.allocate(64u, 8u);
+    arena.reset();
+
+    ASSERT_EQ(arena.used(), 0u);
+    ASSERT_EQ(arena.allocate(32u, 8u), ptr1);
+    ASSERT_EQ(resource.allocations(), resource.deallocations() + 1u);
+}
+
+TEST(job_arena, allocate_multi_threaded)
+{
+    static constexpr auto thread_count = 4u;
+    static constexpr auto allocation_count = 256u;
+
+    CountingMemoryResource resource{};
+    iris::JobArena arena{thread_count * allocation_count * 16u, &resource};
+    std::vector<std::vector<std::byte *>> allocations(thread_count);
+    std::vector<std::thread> threads{};
+
+    for (auto i = 0u; i < thread_count; ++i)
+    {
+        threads.emplace_back(
+            [&arena, &allocations, i]()
+            {
+                for (auto j = 0u; j < allocation_count; ++j)
+                {
+                    auto *ptr = static_cast<std::byte *>(arena.allocate(16u, 16u));
+                    *ptr = static_cast<std::byte>(i);
+                    allocations[i].emplace_back(ptr);
+                }
+            });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // every allocation should be distinct and still hold its writer's value
+    for (auto i = 0u; i < thread_count; ++i)
+    {
+        for (auto *ptr : allocations[i])
+        {
+            ASSERT_EQ(*ptr, static_cast<std::byte>(i));
+        }
+    }
+
+    ASSERT_EQ(arena.used(), thread_count * allocation_count * 16u);
+    ASSERT_EQ(resource.allocations(), 1u);
+}
@@ -0,0 +1,163 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/fiber/fiber_job_system_manager.h"
+#include "jobs/inplace_job.h"
+#include "jobs/job_priority.h"
+#include "jobs/job_system_manager.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+template <class T>
+class JobSystemManagerTests : public ::testing::Test
+{
+  protected:
+    JobSystemManagerTests()
+        : manager_()
+    {
+        manager_.create_job_system();
+    }
+
+    T manager_;
+};
+
+using Managers = ::testing::Types<iris::FiberJobSystemManager, iris::ThreadJobSystemManager>;
+TYPED_TEST_SUITE(JobSystemManagerTests, Managers);
+
+TYPED_TEST(JobSystemManagerTests, parallel_for_empty_range)
+{
+    auto called = false;
+
+    this->manager_.parallel_for(10u, 10u, 1u, [&called](std::size_t) { called = true; });
+
+    ASSERT_FALSE(called);
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_for_visits_every_index_once)
+{
+    std::vector<std::atomic<int>> visited(1000u);
+
+    this->manager_.parallel_for(0u, visited.size(), 7u, [&visited](std::size_t i) { ++visited[i]; });
+
+    for (const auto &count : visited)
+    {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_for_offset_range)
+{
+    std::vector<std::atomic<int>> visited(100u);
+
+    this->manager_.parallel_for(25u, 75u, 0u, [&visited](std::size_t i) { ++visited[i]; });
+
+    for (auto i = 0u; i < visited.size(); ++i)
+    {
+        ASSERT_EQ(visited[i], ((i >= 25u) && (i < 75u)) ? 1 : 0);
+    }
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_for_fine_grain)
+{
+    // a job per index, so waits nest as deep as the split (and no deeper)
+    std::vector<std::atomic<int>> visited(1u << 15u);
+
+    this->manager_.parallel_for(0u, visited.size(), 1u, [&visited](std::size_t i) { ++visited[i]; });
+
+    for (const auto &count : visited)
+    {
+        ASSERT_EQ(count, 1);
+    }
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_for_exceptions_propagate)
+{
+    ASSERT_THROW(
+        this->manager_.parallel_for(
+            0u,
+            100u,
+            1u,
+            [](std::size_t i)
+            {
+                if (i == 50u)
+                {
+                    throw std::runtime_error("");
+                }
+            }),
+        std::runtime_error);
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_reduce_empty_range)
+{
+    const auto result = this->manager_.parallel_reduce(
+        0u, 0u, 1u, 42, [](std::size_t i) { return static_cast<int>(i); }, [](int a, int b) { return a + b; });
+
+    ASSERT_EQ(result, 42);
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_reduce_sum)
+{
+    std::vector<std::size_t> values(10000u);
+    std::iota(std::begin(values), std::end(values), 0u);
+
+    const auto result = this->manager_.parallel_reduce(
+        0u,
+        values.size(),
+        0u,
+        std::size_t{0u},
+        [&values](std::size_t i) { return values[i]; },
+        [](std::size_t a, std::size_t b) { return a + b; });
+
+    ASSERT_EQ(result, std::accumulate(std::cbegin(values), std::cend(values), std::size_t{0u}));
+}
+
+TYPED_TEST(JobSystemManagerTests, parallel_reduce_preserves_order)
+{
+    // string concatenation is associative but not commutative
+    const auto result = this->manager_.parallel_reduce(
+        0u,
+        10u,
+        1u,
+        std::string{},
+        [](std::size_t i) { return std::to_string(i); },
+        [](std::string a, const std::string &b) { return a + b; });
+
+    ASSERT_EQ(result, "0123456789");
+}
+
+TYPED_TEST(JobSystemManagerTests, wait_with_priority)
+{
+    std::atomic<int> counter = 0;
+
+    for (const auto priority : {iris::JobPriority::CRITICAL, iris::JobPriority::NORMAL, iris::JobPriority::BACKGROUND})
+    {
+        this->manager_.wait({[&counter]() { ++counter; }, [&counter]() { ++counter; }}, priority);
+    }
+
+    ASSERT_EQ(counter, 6);
+}
+
+TYPED_TEST(JobSystemManagerTests, wait_inplace_jobs_with_priority)
+{
+    std::atomic<int> counter = 0;
+
+    std::vector<iris::InplaceJob> jobs{};
+    jobs.emplace_back([&counter]() { ++counter; });
+    jobs.emplace_back([&counter]() { ++counter; });
+
+    this->manager_.wait(std::move(jobs), iris::JobPriority::CRITICAL);
+
+    ASSERT_EQ(counter, 2);
+}
@@ -7,7 +7,11 @@
 #include <atomic>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 
+#include <jobs/inplace_job.h>
+#include <jobs/job.h>
+#include <jobs/job_priority.h>
 #include <jobs/job_system.h>
 
 #include <gtest/gtest.h>
@@ -101,6 +105,25 @@ TYPED_TEST_P(JobSystemTests, wait_for_jobs_sequential)
     ASSERT_EQ(counter, 2);
 }
 
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_empty)
+{
+    this->js_.wait_for_jobs(std::vector<iris::Job>{});
+    this->js_.wait_for_jobs(std::vector<iris::InplaceJob>{});
+}
+
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_empty_nested)
+{
+    std::atomic<bool> done = false;
+
+    this->js_.wait_for_jobs({[&done, this]() {
+        this->js_.wait_for_jobs(std::vector<iris::Job>{});
+        this->js_.wait_for_jobs(std::vector<iris::InplaceJob>{});
+        done = true;
+    }});
+
+    ASSERT_TRUE(done);
+}
+
 TYPED_TEST_P(JobSystemTests, exceptions_propagate)
 {
     const auto throws = []() { throw std::runtime_error(""); };
@@ -132,6 +155,105 @@ TYPED_TEST_P(JobSystemTests, exceptions_propagate_first_job)
         std::runtime_error);
 }
 
+TYPED_TEST_P(JobSystemTests, critical_job_not_starved_by_background)
+{
+    // single worker so the order jobs are picked in is deterministic
+    TypeParam js{1u};
+    std::atomic<bool> gate_started = false;
+    std::atomic<bool> gate_open = false;
+    std::atomic<int> background_count = 0;
+    std::atomic<int> background_before_critical = -1;
+
+    // block the worker whilst we fill up the queues
+    js.add_jobs(
+        {[&gate_started, &gate_open]()
+         {
+             gate_started = true;
+             while (!gate_open)
+             {
+                 std::this_thread::yield();
+             }
+         }},
+        iris::JobPriority::BACKGROUND);
+
+    while (!gate_started)
+    {
+        std::this_thread::yield();
+    }
+
+    js.add_jobs(
+        std::vector<iris::Job>(10000u, [&background_count]() { ++background_count; }),
+        iris::JobPriority::BACKGROUND);
+    js.add_jobs(
+        {[&background_count, &background_before_critical]() { background_before_critical = background_count.load(); }},
+        iris::JobPriority::CRITICAL);
+
+    gate_open = true;
+
+    while ((background_count != 10000) || (background_before_critical == -1))
+    {
+        std::this_thread::yield();
+    }
+
+    // at most one pick can go to background work for starvation protection
+    ASSERT_LE(background_before_critical, 1);
+}
+
+TYPED_TEST_P(JobSystemTests, background_job_not_starved_by_critical)
+{
+    TypeParam js{1u};
+    std::atomic<bool> gate_started = false;
+    std::atomic<bool> gate_open = false;
+    std::atomic<int> critical_count = 0;
+    std::atomic<int> critical_before_background = -1;
+
+    js.add_jobs(
+        {[&gate_started, &gate_open]()
+         {
+             gate_started = true;
+             while (!gate_open)
+             {
+                 std::this_thread::yield();
+             }
+         }},
+        iris::JobPriority::CRITICAL);
+
+    while (!gate_started)
+    {
+        std::this_thread::yield();
+    }
+
+    js.add_jobs(
+        {[&critical_count, &critical_before_background]() { critical_before_background = critical_count.load(); }},
+        iris::JobPriority::BACKGROUND);
+    js.add_jobs(std::vector<iris::Job>(1000u, [&critical_count]() { ++critical_count; }), iris::JobPriority::CRITICAL);
+
+    gate_open = true;
+
+    while ((critical_count != 1000) || (critical_before_background == -1))
+    {
+        std::this_thread::yield();
+    }
+
+    // background work is guaranteed a pick at least once every 16
+    ASSERT_LT(critical_before_background, 16);
+}
+
+TYPED_TEST_P(JobSystemTests, wait_for_jobs_priority)
+{
+    std::atomic<int> counter = 0;
+
+    this->js_.wait_for_jobs(
+        {[&counter, this]()
+         {
+             this->js_.wait_for_jobs({[&counter]() { ++counter; }}, iris::JobPriority::BACKGROUND);
+             ++counter;
+         }},
+        iris::JobPriority::CRITICAL);
+
+    ASSERT_EQ(counter, 2);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     JobSystemTests,
     add_jobs_single,
@@ -140,6 +262,11 @@ REGISTER_TYPED_TEST_SUITE_P(
     wait_for_jobs_multiple,
     wait_for_jobs_nested,
     wait_for_jobs_sequential,
+    wait_for_jobs_empty,
+    wait_for_jobs_empty_nested,
     exceptions_propagate,
     exceptions_propagate_complex,
-    exceptions_propagate_first_job);
+    exceptions_propagate_first_job,
+    critical_job_not_starved_by_background,
+    background_job_not_starved_by_critical,
+    wait_for_jobs_priority);
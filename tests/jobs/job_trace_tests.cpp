@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "jobs/job_trace.h"
+#include "jobs/thread/thread_job_system.h"
+
+namespace
+{
+
+/**
+ * Helper to export a trace to a string.
+ */
+std::string export_trace(std::size_t frame_count)
+{
+    std::stringstream strm{};
+    iris::JobTracer::write_chrome_trace(strm, frame_count);
+
+    return strm.str();
+}
+
+/**
+ * Helper to make an id argument string.
+ */
+std::string id_arg(std::uint64_t id)
+{
+    return R"("id":)" + std::to_string(id) + "}";
+}
+
+/**
+ * Helper to get the timestamp of an event in a trace.
+ */
+double event_ts(const std::string &trace, std::uint64_t id)
+{
+    // events are written one per line
+    const auto id_pos = trace.find(id_arg(id));
+    const auto line_start = trace.rfind('\n', id_pos);
+    const auto ts_pos = trace.find(R"("ts":)", line_start) + 5u;
+
+    return std::stod(trace.substr(ts_pos, trace.find(',', ts_pos) - ts_pos));
+}
+
+}
+
+TEST(job_trace, export_format)
+{
+    iris::JobTracer::record(iris::JobTraceEventType::START, 0xaaaa0001u, 0u);
+    iris::JobTracer::record(iris::JobTraceEventType::END, 0xaaaa0001u, 0u);
+
+    const auto trace = export_trace(0u);
+
+    ASSERT_EQ(trace.find(R"({"displayTimeUnit":"ns","traceEvents":[)"), 0u);
+    ASSERT_NE(trace.find(R"("ph":"B")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("ph":"E")"), std::string::npos);
+    ASSERT_NE(trace.find(id_arg(0xaaaa0001u)), std::string::npos);
+    ASSERT_EQ(trace.substr(trace.size() - 3u), "]}\n");
+}
+
+TEST(job_trace, thread_names)
+{
+    std::thread thrd{[]
+                     {
+                         iris::JobTracer::set_thread_name("trace test thread");
+                         iris::JobTracer::record(iris::JobTraceEventType::START, 0xaaaa0002u, 0u);
+                     }};
+    thrd.join();
+
+    const auto trace = export_trace(0u);
+
+    // events from exited threads are kept
+    ASSERT_NE(trace.find(R"("args":{"name":"trace test thread"})"), std::string::npos);
+    ASSERT_NE(trace.find(id_arg(0xaaaa0002u)), std::string::npos);
+}
+
+TEST(job_trace, thread_names_escaped)
+{
+    std::thread thrd{[]
+                     {
+                         iris::JobTracer::set_thread_name("a \"quoted\" \\ name\n");
+                         iris::JobTracer::record(iris::JobTraceEventType::START, 0xaaaa0005u, 0u);
+                     }};
+    thrd.join();
+
+    const auto trace = export_trace(0u);
+
+    ASSERT_NE(trace.find(R"("args":{"name":"a \"quoted\" \\ name\n"})"), std::string::npos);
+}
+
+TEST(job_trace, timestamps_in_microseconds)
+{
+    iris::JobTracer::record(iris::JobTraceEventType::WAKE, 0xaaaa0006u, 0u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    iris::JobTracer::record(iris::JobTraceEventType::WAKE, 0xaaaa0007u, 0u);
+
+    const auto trace = export_trace(0u);
+    const auto elapsed = event_ts(trace, 0xaaaa0007u) - event_ts(trace, 0xaaaa0006u);
+
+    ASSERT_GE(elapsed, 19000.0);
+    ASSERT_LT(elapsed, 1000000.0);
+}
+
+TEST(job_trace, frame_window)
+{
+    iris::JobTracer::mark_frame();
+    iris::JobTracer::record(iris::JobTraceEventType::ENQUEUE, 0xaaaa0003u, 0u);
+    iris::JobTracer::mark_frame();
+    iris::JobTracer::record(iris::JobTraceEventType::ENQUEUE, 0xaaaa0004u, 0u);
+
+    const auto last_frame = export_trace(1u);
+    ASSERT_EQ(last_frame.find(id_arg(0xaaaa0003u)), std::string::npos);
+    ASSERT_NE(last_frame.find(id_arg(0xaaaa0004u)), std::string::npos);
+
+    const auto last_two_frames = export_trace(2u);
+    ASSERT_NE(last_two_frames.find(id_arg(0xaaaa0003u)), std::string::npos);
+    ASSERT_NE(last_two_frames.find(id_arg(0xaaaa0004u)), std::string::npos);
+}
+
+TEST(job_trace, buffer_wraps)
+{
+    static constexpr std::uint64_t base = 0xbbbb0000u;
+
+    // record on a fresh thread so we know exactly what is in its buffer
+    std::thread thrd{[]
+                     {
+                         for (auto i = 0u; i < iris::JobTracer::buffer_capacity + 10u; ++i)
+                         {
+                             iris::JobTracer::record(iris::JobTraceEventType::WAKE, base + i, 0u);
+                         }
+                     }};
+    thrd.join();
+
+    const auto trace = export_trace(0u);
+
+    ASSERT_EQ(trace.find(id_arg(base)), std::string::npos);
+    ASSERT_EQ(trace.find(id_arg(base + 9u)), std::string::npos);
+    ASSERT_NE(trace.find(id_arg(base + 10u)), std::string::npos);
+    ASSERT_NE(trace.find(id_arg(base + iris::JobTracer::buffer_capacity + 9u)), std::string::npos);
+}
+
+#if defined(IRIS_ENABLE_JOB_TRACING)
+
+TEST(job_trace, job_system_records_jobs)
+{
+    iris::ThreadJobSystem js{1u};
+    std::atomic<bool> done = false;
+
+    // a waiting caller may run the job itself, so add it and let the worker
+    // pick it up
+    iris::JobTracer::mark_frame();
+    js.add_jobs({[&done] { done = true; }});
+
+    while (!done)
+    {
+        std::this_thread::yield();
+    }
+
+    const auto trace = export_trace(1u);
+
+    ASSERT_NE(trace.find(R"("name":"enqueue")"), std::string::npos);
+    ASSERT_NE(trace.find(R"("name":"thread worker 0"})"), std::string::npos);
+}
+
+#endif
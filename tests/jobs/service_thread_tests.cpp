@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "jobs/service_thread.h"
+
+using namespace std::chrono_literals;
+
+TEST(service_thread, runs_until_stopped)
+{
+    std::atomic<int> iterations = 0;
+
+    iris::ServiceThread service{
+        "test",
+        [&iterations](const iris::StopToken &token)
+        {
+            while (!token.stop_requested())
+            {
+                ++iterations;
+                std::this_thread::yield();
+            }
+        }};
+
+    while (iterations < 10)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_TRUE(service.is_running());
+
+    service.stop();
+
+    ASSERT_FALSE(service.is_running());
+}
+
+TEST(service_thread, stop_wakes_waiting_service)
+{
+    std::atomic<bool> started = false;
+    std::atomic<bool> woken_by_stop = false;
+
+    iris::ServiceThread service{
+        "test",
+        [&started, &woken_by_stop](const iris::StopToken &token)
+        {
+            started = true;
+            woken_by_stop = token.wait_for(60s);
+        }};
+
+    while (!started)
+    {
+        std::this_thread::yield();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    service.stop();
+
+    ASSERT_TRUE(woken_by_stop);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, 10s);
+}
+
+TEST(service_thread, wait_times_out)
+{
+    std::atomic<bool> woken_by_stop = true;
+
+    iris::ServiceThread service{
+        "test", [&woken_by_stop](const iris::StopToken &token) { woken_by_stop = token.wait_for(1ms); }};
+
+    while (service.is_running())
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_FALSE(woken_by_stop);
+}
+
+TEST(service_thread, exception_stops_service)
+{
+    iris::ServiceThread service{"test", [](const iris::StopToken &) { throw std::runtime_error("error"); }};
+
+    while (service.is_running())
+    {
+        std::this_thread::yield();
+    }
+
+    service.stop();
+}
+
+TEST(service_thread, unknown_exception_stops_service)
+{
+    iris::ServiceThread service{"test", [](const iris::StopToken &) { throw 1; }};
+
+    while (service.is_running())
+    {
+        std::this_thread::yield();
+    }
+
+    service.stop();
+}
+
+TEST(service_thread, destructor_stops_service)
+{
+    std::atomic<bool> stopped = false;
+
+    {
+        iris::ServiceThread service{
+            "test",
+            [&stopped](const iris::StopToken &token)
+            {
+                while (!token.wait_for(1ms))
+                {
+                }
+
+                stopped = true;
+            }};
+    }
+
+    ASSERT_TRUE(stopped);
+}
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+#include "jobs/fiber/fiber_job_system_manager.h"
+#include "jobs/task_graph.h"
+#include "jobs/thread/thread_job_system_manager.h"
+
+template <class T>
+class TaskGraphTests : public ::testing::Test
+{
+  protected:
+    TaskGraphTests()
+        : manager_()
+    {
+        manager_.create_job_system();
+    }
+
+    T manager_;
+};
+
+using Managers = ::testing::Types<iris::FiberJobSystemManager, iris::ThreadJobSystemManager>;
+TYPED_TEST_SUITE(TaskGraphTests, Managers);
+
+TYPED_TEST(TaskGraphTests, empty_graph)
+{
+    iris::TaskGraph graph{};
+
+    graph.submit(this->manager_);
+    graph.wait();
+
+    ASSERT_TRUE(graph.is_complete());
+}
+
+TYPED_TEST(TaskGraphTests, chain_runs_in_order)
+{
+    std::mutex mutex;
+    std::vector<int> order;
+    iris::TaskGraph graph{};
+
+    const auto record = [&mutex, &order](int value)
+    {
+        return [&mutex, &order, value]()
+        {
+            std::unique_lock lock(mutex);
+            order.emplace_back(value);
+        };
+    };
+
+    const auto a = graph.add(record(1));
+    const auto b = graph.add(record(2));
+    const auto c = graph.add(record(3));
+    graph.precede(b, c);
+    graph.precede(a, b);
+
+    graph.submit(this->manager_);
+    graph.wait();
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TYPED_TEST(TaskGraphTests, diamond)
+{
+    std::atomic<int> counter = 0;
+    std::atomic<int> left_seen = -1;
+    std::atomic<int> right_seen = -1;
+    std::atomic<int> join_seen = -1;
+    iris::TaskGraph graph{};
+
+    const auto top = graph.add([&counter]() { ++counter; });
+    const auto left = graph.add([&counter, &left_seen]() { left_seen = counter++; });
+    const auto right = graph.add([&counter, &right_seen]() { right_seen = counter++; });
+    const auto join = graph.add([&counter, &join_seen]() { join_seen = counter++; });
+
+    graph.precede(top, left);
+    graph.precede(top, right);
+    graph.precede(left, join);
+    graph.precede(right, join);
+
+    graph.submit(this->manager_);
+    graph.wait();
+
+    ASSERT_GE(left_seen, 1);
+    ASSERT_GE(right_seen, 1);
+    ASSERT_EQ(join_seen, 3);
+}
+
+TYPED_TEST(TaskGraphTests, resubmit)
+{
+    std::atomic<int> counter = 0;
+    iris::TaskGraph graph{};
+
+    const auto root = graph.add([&counter]() { ++counter; });
+    for (auto i = 0; i < 8; ++i)
+    {
+        graph.precede(root, graph.add([&counter]() { ++counter; }));
+    }
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        graph.submit(this->manager_);
+        graph.wait();
+    }
+
+    ASSERT_EQ(counter, 900);
+}
+
+TYPED_TEST(TaskGraphTests, destroyed_after_wait)
+{
+    std::atomic<int> counter = 0;
+
+    // a wide graph has many nodes finishing at once, the graph must be safe
+    // to destroy as soon as wait returns even if those threads are still
+    // winding down
+    for (auto i = 0; i < 200; ++i)
+    {
+        auto graph = std::make_unique<iris::TaskGraph>();
+
+        const auto root = graph->add([&counter]() { ++counter; });
+        for (auto j = 0; j < 64; ++j)
+        {
+            graph->precede(root, graph->add([&counter]() { ++counter; }));
+        }
+
+        graph->submit(this->manager_);
+        graph->wait();
+    }
+
+    ASSERT_EQ(counter, 200 * 65);
+}
+
+TYPED_TEST(TaskGraphTests, exceptions_propagate)
+{
+    std::atomic<bool> after_ran = false;
+    iris::TaskGraph graph{};
+
+    const auto throws = graph.add([]() { throw std::runtime_error(""); });
+    const auto after = graph.add([&after_ran]() { after_ran = true; });
+    graph.precede(throws, after);
+
+    graph.submit(this->manager_);
+
+    ASSERT_THROW(graph.wait(), std::runtime_error);
+    ASSERT_TRUE(after_ran);
+}
+
+TYPED_TEST(TaskGraphTests, cycle_throws)
+{
+    iris::TaskGraph graph{};
+
+    const auto a = graph.add([]() {});
+    const auto b = graph.add([]() {});
+    const auto c = graph.add([]() {});
+    graph.precede(a, b);
+    graph.precede(b, c);
+    graph.precede(c, b);
+
+    ASSERT_THROW(graph.submit(this->manager_), iris::Exception);
+}
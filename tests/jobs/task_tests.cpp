@@ -0,0 +1,279 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/completion.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/job.h"
+#include "jobs/task.h"
+#include "jobs/task_awaitables.h"
+#include "jobs/thread/thread_job_system.h"
+
+namespace
+{
+
+iris::Task<int> value_task(int value)
+{
+    co_return value;
+}
+
+iris::Task<int> add_task(int a, int b)
+{
+    const auto x = co_await value_task(a);
+    const auto y = co_await value_task(b);
+
+    co_return x + y;
+}
+
+iris::Task<> throwing_task()
+{
+    throw std::runtime_error("error");
+    co_return;
+}
+
+}
+
+TEST(task, sync_wait_value)
+{
+    ASSERT_EQ(iris::sync_wait(value_task(42)), 42);
+}
+
+TEST(task, sync_wait_move_only)
+{
+    auto task = []() -> iris::Task<std::unique_ptr<int>> { co_return std::make_unique<int>(3); };
+
+    ASSERT_EQ(*iris::sync_wait(task()), 3);
+}
+
+TEST(task, nested)
+{
+    ASSERT_EQ(iris::sync_wait(add_task(1, 2)), 3);
+}
+
+TEST(task, lazy)
+{
+    auto started = false;
+    auto function = [&started]() -> iris::Task<>
+    {
+        started = true;
+        co_return;
+    };
+    auto task = function();
+
+    ASSERT_FALSE(started);
+    ASSERT_FALSE(task.is_ready());
+
+    iris::sync_wait(std::move(task));
+
+    ASSERT_TRUE(started);
+}
+
+TEST(task, exception_propagates)
+{
+    ASSERT_THROW(iris::sync_wait(throwing_task()), std::runtime_error);
+}
+
+TEST(task, many_sequential_awaits)
+{
+    auto task = []() -> iris::Task<int>
+    {
+        auto total = 0;
+        for (auto i = 0; i < 1000; ++i)
+        {
+            total += co_await value_task(1);
+        }
+
+        co_return total;
+    };
+
+    ASSERT_EQ(iris::sync_wait(task()), 1000);
+}
+
+TEST(task, completion_inline)
+{
+    iris::Completion<std::string> completion{};
+
+    auto task = [&completion]() -> iris::Task<std::string> { co_return co_await completion; };
+
+    std::thread thrd{[&completion]
+                     {
+                         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                         completion.complete("hello");
+                     }};
+
+    ASSERT_EQ(iris::sync_wait(task()), "hello");
+
+    thrd.join();
+}
+
+TEST(task, completion_before_await)
+{
+    iris::Completion<> completion{};
+    completion.complete();
+
+    auto task = [&completion]() -> iris::Task<> { co_await completion; };
+
+    iris::sync_wait(task());
+
+    ASSERT_TRUE(completion.is_complete());
+}
+
+template <class T>
+class TaskTests : public ::testing::Test
+{
+  protected:
+    T js_{4u};
+};
+
+using JobSystemTypes = ::testing::Types<iris::FiberJobSystem, iris::ThreadJobSystem>;
+TYPED_TEST_SUITE(TaskTests, JobSystemTypes);
+
+TYPED_TEST(TaskTests, schedule_moves_to_worker)
+{
+    auto &js = this->js_;
+    const auto caller = std::this_thread::get_id();
+
+    auto task = [&js]() -> iris::Task<std::thread::id>
+    {
+        co_await iris::schedule(js);
+        co_return std::this_thread::get_id();
+    };
+
+    ASSERT_NE(iris::sync_wait(task()), caller);
+}
+
+TYPED_TEST(TaskTests, run_jobs)
+{
+    auto &js = this->js_;
+    std::atomic<int> counter = 0;
+
+    auto task = [&js, &counter]() -> iris::Task<int>
+    {
+        co_await iris::schedule(js);
+        co_await iris::run_jobs(js, std::vector<iris::Job>(100u, [&counter] { ++counter; }));
+        co_return counter.load();
+    };
+
+    ASSERT_EQ(iris::sync_wait(task()), 100);
+}
+
+TYPED_TEST(TaskTests, run_jobs_exception)
+{
+    auto &js = this->js_;
+
+    auto task = [&js]() -> iris::Task<>
+    {
+        std::vector<iris::Job> jobs{};
+        jobs.emplace_back([] {});
+        jobs.emplace_back([] { throw std::runtime_error("error"); });
+        jobs.emplace_back([] {});
+
+        co_await iris::run_jobs(js, jobs);
+    };
+
+    ASSERT_THROW(iris::sync_wait(task()), std::runtime_error);
+}
+
+TYPED_TEST(TaskTests, when_all_values)
+{
+    auto &js = this->js_;
+
+    auto task = [&js]() -> iris::Task<std::vector<int>>
+    {
+        std::vector<iris::Task<int>> children{};
+        for (auto i = 0; i < 64; ++i)
+        {
+            children.emplace_back(add_task(i, i));
+        }
+
+        co_return co_await iris::when_all(js, std::move(children));
+    };
+
+    const auto results = iris::sync_wait(task());
+
+    ASSERT_EQ(results.size(), 64u);
+    for (auto i = 0u; i < results.size(); ++i)
+    {
+        ASSERT_EQ(results[i], static_cast<int>(i * 2u));
+    }
+}
+
+TYPED_TEST(TaskTests, when_all_void)
+{
+    auto &js = this->js_;
+    std::atomic<int> counter = 0;
+
+    auto child = [&js, &counter]() -> iris::Task<>
+    {
+        // hop again so children finish on arbitrary workers
+        co_await iris::schedule(js);
+        ++counter;
+    };
+
+    auto task = [&js, &child]() -> iris::Task<>
+    {
+        std::vector<iris::Task<>> children{};
+        for (auto i = 0; i < 64; ++i)
+        {
+            children.emplace_back(child());
+        }
+
+        co_await iris::when_all(js, std::move(children));
+    };
+
+    iris::sync_wait(task());
+
+    ASSERT_EQ(counter, 64);
+}
+
+TYPED_TEST(TaskTests, when_all_exception)
+{
+    auto &js = this->js_;
+
+    auto task = [&js]() -> iris::Task<>
+    {
+        std::vector<iris::Task<>> children{};
+        children.emplace_back(throwing_task());
+        children.emplace_back([]() -> iris::Task<> { co_return; }());
+
+        co_await iris::when_all(js, std::move(children));
+    };
+
+    ASSERT_THROW(iris::sync_wait(task()), std::runtime_error);
+}
+
+TYPED_TEST(TaskTests, completion_resumes_on_job_system)
+{
+    auto &js = this->js_;
+    iris::Completion<int> completion{js};
+    const auto caller = std::this_thread::get_id();
+
+    auto task = [&completion]() -> iris::Task<std::thread::id>
+    {
+        const auto value = co_await completion;
+        EXPECT_EQ(value, 7);
+        co_return std::this_thread::get_id();
+    };
+
+    std::thread thrd{[&completion]
+                     {
+                         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                         completion.complete(7);
+                     }};
+
+    ASSERT_NE(iris::sync_wait(task()), caller);
+
+    thrd.join();
+}
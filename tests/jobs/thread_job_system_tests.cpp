@@ -6,6 +6,56 @@
 
 #include "jobs/job_system_tests.h"
 
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/job.h"
 #include "jobs/thread/thread_job_system.h"
 
 INSTANTIATE_TYPED_TEST_SUITE_P(thread, JobSystemTests, iris::ThreadJobSystem);
+
+TEST(thread_job_system, jobs_run_on_fixed_threads)
+{
+    iris::ThreadJobSystem js{2u};
+    std::mutex mutex;
+    std::set<std::thread::id> ids;
+
+    std::vector<iris::Job> jobs(
+        1000u,
+        [&mutex, &ids]()
+        {
+            std::unique_lock lock(mutex);
+            ids.emplace(std::this_thread::get_id());
+        });
+
+    js.wait_for_jobs(jobs);
+
+    // two workers plus the waiting thread helping out
+    ASSERT_LE(ids.size(), 3u);
+}
+
+TEST(thread_job_system, nested_waits_help)
+{
+    // with a single worker every nested wait must be run by a helping thread
+    iris::ThreadJobSystem js{1u};
+    std::atomic<int> counter = 0;
+
+    std::vector<iris::Job> jobs(
+        8u,
+        [&js, &counter]()
+        {
+            js.wait_for_jobs({[&js, &counter]()
+                              {
+                                  js.wait_for_jobs({[&counter]() { ++counter; }});
+                              }});
+        });
+
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(counter, 8);
+}
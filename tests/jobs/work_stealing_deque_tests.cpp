@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "jobs/work_stealing_deque.h"
+
+TEST(work_stealing_deque, constructor)
+{
+    iris::WorkStealingDeque<int> q;
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_deque, push)
+{
+    iris::WorkStealingDeque<int> q;
+    q.push(1);
+
+    ASSERT_FALSE(q.empty());
+}
+
+TEST(work_stealing_deque, try_pop_empty)
+{
+    iris::WorkStealingDeque<int> q;
+    int value = 0;
+
+    ASSERT_FALSE(q.try_pop(value));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_deque, try_steal_empty)
+{
+    iris::WorkStealingDeque<int> q;
+    int value = 0;
+
+    ASSERT_FALSE(q.try_steal(value));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_deque, pop_is_lifo)
+{
+    iris::WorkStealingDeque<int> q;
+    q.push(1);
+    q.push(2);
+    q.push(3);
+    int value = 0;
+
+    ASSERT_TRUE(q.try_pop(value));
+    ASSERT_EQ(value, 3);
+    ASSERT_TRUE(q.try_pop(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(q.try_pop(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_deque, steal_is_fifo)
+{
+    iris::WorkStealingDeque<int> q;
+    q.push(1);
+    q.push(2);
+    q.push(3);
+    int value = 0;
+
+    ASSERT_TRUE(q.try_steal(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(q.try_steal(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(q.try_steal(value));
+    ASSERT_EQ(value, 3);
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_deque, grow)
+{
+    iris::WorkStealingDeque<int> q{2u};
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        q.push(i);
+    }
+
+    int value = 0;
+    ASSERT_TRUE(q.try_steal(value));
+    ASSERT_EQ(value, 0);
+
+    for (auto i = 99; i > 0; --i)
+    {
+        ASSERT_TRUE(q.try_pop(value));
+        ASSERT_EQ(value, i);
+    }
+
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(work_stealing_deque, steal_thread_safe)
+{
+    static constexpr auto value_count = 100000;
+    iris::WorkStealingDeque<int> q{16u};
+    std::atomic<bool> done = false;
+
+    const auto thief = [&q, &done](std::vector<int> &stolen)
+    {
+        int value = 0;
+
+        while (!done || !q.empty())
+        {
+            if (q.try_steal(value))
+            {
+                stolen.emplace_back(value);
+            }
+        }
+    };
+
+    std::vector<int> stolen1;
+    std::vector<int> stolen2;
+    std::vector<int> stolen3;
+    std::thread thrd1{thief, std::ref(stolen1)};
+    std::thread thrd2{thief, std::ref(stolen2)};
+    std::thread thrd3{thief, std::ref(stolen3)};
+
+    // owner interleaves pushing and popping whilst the other threads steal
+    std::vector<int> popped;
+    for (auto i = 0; i < value_count; ++i)
+    {
+        q.push(i);
+
+        int value = 0;
+        if (((i % 3) == 0) && q.try_pop(value))
+        {
+            popped.emplace_back(value);
+        }
+    }
+
+    done = true;
+
+    thrd1.join();
+    thrd2.join();
+    thrd3.join();
+
+    std::vector<int> values(value_count);
+    std::iota(std::begin(values), std::end(values), 0);
+
+    popped.insert(std::end(popped), std::cbegin(stolen1), std::cend(stolen1));
+    popped.insert(std::end(popped), std::cbegin(stolen2), std::cend(stolen2));
+    popped.insert(std::end(popped), std::cbegin(stolen3), std::cend(stolen3));
+
+    std::sort(std::begin(popped), std::end(popped));
+    ASSERT_EQ(popped, values);
+}
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/cpu_topology.h"
+#include "core/exception.h"
+#include "jobs/fiber/fiber_job_system.h"
+#include "jobs/job.h"
+#include "jobs/worker_placement.h"
+
+namespace
+{
+
+/**
+ * Dual socket topology, each socket has two cores with two hardware threads and
+ * is its own node. Cpus are numbered as linux does, siblings after all primary
+ * threads.
+ */
+iris::CpuTopology dual_socket()
+{
+    std::vector<iris::LogicalCpu> cpus{};
+
+    for (auto i = std::size_t{0u}; i < 8u; ++i)
+    {
+        const auto core = i % 4u;
+        cpus.push_back({i, core, core / 2u, core / 2u, false});
+    }
+
+    return iris::CpuTopology{cpus};
+}
+
+std::vector<std::size_t> slot_cpus(const std::vector<iris::WorkerSlot> &slots)
+{
+    std::vector<std::size_t> cpus{};
+    for (const auto &slot : slots)
+    {
+        cpus.emplace_back(slot.cpu);
+    }
+
+    return cpus;
+}
+
+}
+
+TEST(worker_placement, one_per_physical_core)
+{
+    const auto slots = iris::place_workers(dual_socket(), {.pin_workers = true});
+
+    ASSERT_EQ(slot_cpus(slots), (std::vector<std::size_t>{0u, 1u, 2u, 3u}));
+    ASSERT_EQ(slots[0].node, 0u);
+    ASSERT_EQ(slots[1].node, 0u);
+    ASSERT_EQ(slots[2].node, 1u);
+    ASSERT_EQ(slots[3].node, 1u);
+}
+
+TEST(worker_placement, smt_siblings)
+{
+    const auto slots = iris::place_workers(dual_socket(), {.pin_workers = true, .use_smt_siblings = true});
+
+    // grouped by node, primaries first
+    ASSERT_EQ(slot_cpus(slots), (std::vector<std::size_t>{0u, 1u, 4u, 5u, 2u, 3u, 6u, 7u}));
+}
+
+TEST(worker_placement, reserved_cpus)
+{
+    // reserving a sibling reserves its whole core
+    const auto slots = iris::place_workers(
+        dual_socket(), {.pin_workers = true, .use_smt_siblings = true, .reserved_cpus = {0u, 7u}});
+
+    ASSERT_EQ(slot_cpus(slots), (std::vector<std::size_t>{1u, 5u, 2u, 6u}));
+}
+
+TEST(worker_placement, affinity_subset)
+{
+    // as if the process could only run on cpus 1, 5 and 6, cpu 6 is a sibling
+    // so becomes the primary of its core
+    const auto topology = dual_socket().restrict_to({1u, 5u, 6u});
+
+    ASSERT_EQ(slot_cpus(iris::place_workers(topology, {.pin_workers = true})), (std::vector<std::size_t>{1u, 6u}));
+    ASSERT_EQ(
+        slot_cpus(iris::place_workers(topology, {.pin_workers = true, .use_smt_siblings = true})),
+        (std::vector<std::size_t>{1u, 5u, 6u}));
+}
+
+TEST(worker_placement, all_reserved)
+{
+    ASSERT_THROW(
+        iris::place_workers(iris::CpuTopology::flat(2u), {.pin_workers = true, .reserved_cpus = {0u, 1u}}),
+        iris::Exception);
+}
+
+TEST(worker_placement, pinned_fiber_job_system)
+{
+    iris::FiberJobSystem js{{.worker_count = 0u, .placement = {.pin_workers = true}}};
+    std::atomic<int> counter = 0;
+
+    std::vector<iris::Job> jobs(100u, [&counter]() { ++counter; });
+    js.wait_for_jobs(jobs);
+
+    ASSERT_EQ(counter, 100);
+}
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/data_buffer.h"
+#include "networking/channel/channel_type.h"
+#include "networking/client_connection_handler.h"
+#include "networking/data_buffer_deserialiser.h"
+#include "networking/data_buffer_serialiser.h"
+#include "networking/server_connection_handler.h"
+#include "networking/udp_server_socket.h"
+#include "networking/udp_socket.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+static constexpr auto port = 8897u;
+
+}
+
+TEST(client_connection_handler, concurrent_send_and_flush)
+{
+    static constexpr auto message_count = 2000u;
+
+    // server which echoes everything back to the client
+    iris::ServerConnectionHandler *server_ptr = nullptr;
+    iris::ServerConnectionHandler server{
+        std::make_unique<iris::UdpServerSocket>("127.0.0.1", port),
+        [](std::size_t) {},
+        [&server_ptr](std::size_t id, const iris::DataBuffer &data, iris::ChannelType channel_type)
+        { server_ptr->send(id, data, channel_type); }};
+    server_ptr = &server;
+
+    std::atomic<bool> running = true;
+    std::thread server_updater{[&server, &running]()
+                               {
+                                   while (running)
+                                   {
+                                       server.update();
+                                       std::this_thread::sleep_for(1ms);
+                                   }
+                               }};
+
+    iris::ClientConnectionHandler client{std::make_unique<iris::UdpSocket>("127.0.0.1", port)};
+
+    // flush from another thread whilst we send, the reader thread is also
+    // using the channels as echoes and acks arrive
+    std::thread flusher{[&client, &running]()
+                        {
+                            while (running)
+                            {
+                                client.flush();
+                                std::this_thread::sleep_for(1ms);
+                            }
+                        }};
+
+    std::vector<std::uint32_t> received{};
+    const auto drain = [&client, &received]()
+    {
+        while (const auto data = client.try_read(iris::ChannelType::RELIABLE_ORDERED))
+        {
+            iris::DataBufferDeserialiser deserialiser{*data};
+            received.emplace_back(deserialiser.pop<std::uint32_t>());
+        }
+    };
+
+    for (auto i = 0u; i < message_count; ++i)
+    {
+        iris::DataBufferSerialiser serialiser{};
+        serialiser.push(static_cast<std::uint32_t>(i));
+        client.send(serialiser.data(), iris::ChannelType::RELIABLE_ORDERED);
+
+        drain();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + 20s;
+    while ((received.size() < message_count) && (std::chrono::steady_clock::now() < deadline))
+    {
+        drain();
+        std::this_thread::sleep_for(1ms);
+    }
+
+    running = false;
+    flusher.join();
+    server_updater.join();
+
+    ASSERT_EQ(received.size(), message_count);
+    for (auto i = 0u; i < message_count; ++i)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+}
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "core/data_buffer.h"
+#include "networking/data_buffer_serialiser.h"
 #include "networking/packet.h"
 
 static const iris::DataBuffer test_data{
@@ -48,3 +49,26 @@ create_packets(const std::vector<std::tuple<std::uint16_t, iris::PacketType>>
 
     return packets;
 }
+
+/**
+ * Helper method to create a reliable ack packet.
+ *
+ * @param sequence
+ *   Most recent sequence number being acked.
+ *
+ * @param bits
+ *   Bitfield of previous packets being acked.
+ *
+ * @returns
+ *   Ack packet.
+ */
+inline iris::Packet create_ack(std::uint16_t sequence, std::uint32_t bits)
+{
+    iris::DataBufferSerialiser serialiser{};
+    serialiser.push(bits);
+
+    iris::Packet packet{iris::PacketType::ACK, iris::ChannelType::RELIABLE_ORDERED, serialiser.data()};
+    packet.set_sequence(sequence);
+
+    return packet;
+}
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "core/data_buffer.h"
+#include "networking/channel/channel_type.h"
+#include "networking/packet.h"
+#include "networking/packet_coalescer.h"
+#include "networking/packet_type.h"
+
+#include "helper.h"
+
+TEST(packet_coalescer, construct)
+{
+    iris::PacketCoalescer coalescer{};
+
+    ASSERT_TRUE(coalescer.empty());
+    ASSERT_EQ(coalescer.size(), 0u);
+}
+
+TEST(packet_coalescer, single_datagram)
+{
+    const auto packets = create_packets({
+        {0u, iris::PacketType::DATA},
+        {0u, iris::PacketType::ACK},
+        {1u, iris::PacketType::DATA},
+    });
+    iris::PacketCoalescer coalescer{};
+
+    coalescer.add(packets);
+
+    ASSERT_EQ(coalescer.size(), 1u);
+    ASSERT_EQ(iris::PacketCoalescer::split(coalescer[0u]), packets);
+}
+
+TEST(packet_coalescer, mixed_channels)
+{
+    const std::vector<iris::Packet> packets{
+        {iris::PacketType::DATA, iris::ChannelType::UNRELIABLE_UNORDERED, test_data},
+        {iris::PacketType::DATA, iris::ChannelType::UNRELIABLE_SEQUENCED, test_data},
+        {iris::PacketType::ACK, iris::ChannelType::RELIABLE_ORDERED, {}},
+    };
+    iris::PacketCoalescer coalescer{};
+
+    coalescer.add(packets);
+
+    ASSERT_EQ(coalescer.size(), 1u);
+    ASSERT_EQ(iris::PacketCoalescer::split(coalescer[0u]), packets);
+}
+
+TEST(packet_coalescer, multiple_datagrams)
+{
+    // three packets that each fill just over a third of a datagram
+    const iris::Packet packet{
+        iris::PacketType::DATA,
+        iris::ChannelType::RELIABLE_ORDERED,
+        iris::DataBuffer(iris::Packet::max_size / 3u, std::byte{0xaa})};
+    const std::vector<iris::Packet> packets{packet, packet, packet};
+    iris::PacketCoalescer coalescer{};
+
+    coalescer.add(packets);
+
+    ASSERT_EQ(coalescer.size(), 2u);
+
+    std::vector<iris::Packet> split{};
+    for (auto i = 0u; i < coalescer.size(); ++i)
+    {
+        ASSERT_LE(coalescer[i].size(), iris::Packet::max_size);
+
+        const auto datagram_packets = iris::PacketCoalescer::split(coalescer[i]);
+        split.insert(std::end(split), std::cbegin(datagram_packets), std::cend(datagram_packets));
+    }
+
+    ASSERT_EQ(split, packets);
+}
+
+TEST(packet_coalescer, max_size_packet)
+{
+    const iris::Packet packet{
+        iris::PacketType::DATA,
+        iris::ChannelType::RELIABLE_ORDERED,
+        iris::DataBuffer(iris::Packet::max_body_size, std::byte{0xaa})};
+    iris::PacketCoalescer coalescer{};
+
+    coalescer.add(packet);
+    coalescer.add(packet);
+
+    ASSERT_EQ(coalescer.size(), 2u);
+    ASSERT_EQ(coalescer[0u].size(), iris::Packet::max_size);
+    ASSERT_EQ(coalescer[1u].size(), iris::Packet::max_size);
+}
+
+TEST(packet_coalescer, clear)
+{
+    const auto packets = create_packets({
+        {0u, iris::PacketType::DATA},
+    });
+    const auto other_packets = create_packets({
+        {1u, iris::PacketType::ACK},
+    });
+    iris::PacketCoalescer coalescer{};
+
+    coalescer.add(packets);
+    coalescer.clear();
+
+    ASSERT_TRUE(coalescer.empty());
+
+    coalescer.add(other_packets);
+
+    ASSERT_EQ(coalescer.size(), 1u);
+    ASSERT_EQ(iris::PacketCoalescer::split(coalescer[0u]), other_packets);
+}
+
+TEST(packet_coalescer, split_stops_at_invalid)
+{
+    const auto packets = create_packets({
+        {0u, iris::PacketType::DATA},
+    });
+    iris::PacketCoalescer coalescer{};
+    coalescer.add(packets);
+
+    auto datagram = coalescer[0u];
+    datagram.insert(std::end(datagram), iris::Packet::header_size, std::byte{0x0});
+
+    ASSERT_EQ(iris::PacketCoalescer::split(datagram), packets);
+}
+
+TEST(packet_coalescer, split_stops_at_unknown_channel)
+{
+    const auto packets = create_packets({
+        {0u, iris::PacketType::DATA},
+    });
+    iris::PacketCoalescer coalescer{};
+    coalescer.add(packets);
+    coalescer.add(packets);
+
+    // corrupt the channel of the second packet
+    auto datagram = coalescer[0u];
+    datagram[packets.front().packet_size() + 1u] = std::byte{0xff};
+
+    ASSERT_EQ(iris::PacketCoalescer::split(datagram), packets);
+}
+
+TEST(packet_coalescer, split_empty)
+{
+    ASSERT_TRUE(iris::PacketCoalescer::split({}).empty());
+}
@@ -6,7 +6,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include "core/data_buffer.h"
 #include "core/exception.h"
+#include "networking/channel/channel_type.h"
 #include "networking/packet.h"
 #include "networking/packet_type.h"
 
@@ -34,7 +40,26 @@ TEST(packet, construct_normal)
     ASSERT_EQ(p.body_size(), test_data.size());
     ASSERT_EQ(p.sequence(), 0u);
     ASSERT_EQ(iris::DataBuffer(p.body(), p.body() + p.body_size()), test_data);
-    ASSERT_EQ(std::memcmp(p.data(), &p, p.packet_size()), 0u);
+    ASSERT_EQ(p.packet_size(), iris::Packet::header_size + test_data.size());
+    ASSERT_EQ(p.fragment(), 0u);
+    ASSERT_EQ(p.fragment_count(), 1u);
+}
+
+TEST(packet, construct_max_size)
+{
+    const iris::DataBuffer body(iris::Packet::max_body_size, std::byte{0xaa});
+    iris::Packet p{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, body};
+
+    ASSERT_EQ(p.body_buffer(), body);
+    ASSERT_EQ(p.packet_size(), iris::Packet::max_size);
+}
+
+TEST(packet, construct_too_large)
+{
+    const iris::DataBuffer body(iris::Packet::max_message_size + 1u, std::byte{0xaa});
+
+    ASSERT_THROW(
+        (iris::Packet{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, body}), iris::Exception);
 }
 
 TEST(packet, construct_raw_packet)
@@ -49,6 +74,98 @@ TEST(packet, construct_raw_packet)
     ASSERT_EQ(p1, p2);
 }
 
+TEST(packet, construct_raw_packet_trailing_data)
+{
+    iris::Packet p1{
+        iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    iris::DataBuffer raw_packet{p1.data(), p1.data() + p1.packet_size()};
+    raw_packet.insert(std::end(raw_packet), std::begin(test_data), std::end(test_data));
+
+    iris::Packet p2{raw_packet};
+
+    ASSERT_EQ(p1, p2);
+}
+
+TEST(packet, construct_raw_packet_truncated)
+{
+    const iris::DataBuffer raw_packet(iris::Packet::header_size - 1u, std::byte{0x3});
+
+    iris::Packet p{raw_packet};
+
+    ASSERT_FALSE(p.is_valid());
+}
+
+TEST(packet, construct_raw_packet_truncated_body)
+{
+    iris::Packet p1{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    // header claims more body than we have
+    const iris::DataBuffer raw_packet{p1.data(), p1.data() + p1.packet_size() - 1u};
+
+    iris::Packet p2{raw_packet};
+
+    ASSERT_FALSE(p2.is_valid());
+}
+
+TEST(packet, construct_raw_packet_oversized)
+{
+    // a body too large to have been sent in a single datagram
+    const iris::DataBuffer body(iris::Packet::max_body_size + 1u, std::byte{0xaa});
+    iris::Packet p1{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, body};
+
+    const iris::DataBuffer raw_packet{p1.data(), p1.data() + p1.packet_size()};
+
+    iris::Packet p2{raw_packet};
+
+    ASSERT_FALSE(p2.is_valid());
+}
+
+TEST(packet, construct_raw_packet_unknown_type)
+{
+    iris::Packet p1{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    iris::DataBuffer raw_packet{p1.data(), p1.data() + p1.packet_size()};
+    raw_packet[0u] = static_cast<std::byte>(static_cast<std::uint8_t>(iris::PacketType::SYNC_FINISH) + 1u);
+
+    ASSERT_FALSE(iris::Packet{raw_packet}.is_valid());
+}
+
+TEST(packet, construct_raw_packet_unknown_channel)
+{
+    iris::Packet p1{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    iris::DataBuffer raw_packet{p1.data(), p1.data() + p1.packet_size()};
+
+    raw_packet[1u] = static_cast<std::byte>(static_cast<std::uint8_t>(iris::ChannelType::RELIABLE_ORDERED) + 1u);
+    ASSERT_FALSE(iris::Packet{raw_packet}.is_valid());
+
+    raw_packet[1u] = static_cast<std::byte>(iris::ChannelType::INVAlID);
+    ASSERT_FALSE(iris::Packet{raw_packet}.is_valid());
+}
+
+TEST(packet, construct_raw_packet_fragment_out_of_range)
+{
+    iris::Packet p1{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    p1.set_fragment(3u, 3u);
+    ASSERT_FALSE((iris::Packet{iris::DataBuffer{p1.data(), p1.data() + p1.packet_size()}}.is_valid()));
+
+    p1.set_fragment(0u, 0u);
+    ASSERT_FALSE((iris::Packet{iris::DataBuffer{p1.data(), p1.data() + p1.packet_size()}}.is_valid()));
+}
+
+TEST(packet, construct_raw_packet_too_many_fragments)
+{
+    iris::Packet p1{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    p1.set_fragment(0u, static_cast<std::uint8_t>(iris::Packet::max_fragments));
+    ASSERT_TRUE((iris::Packet{iris::DataBuffer{p1.data(), p1.data() + p1.packet_size()}}.is_valid()));
+
+    p1.set_fragment(0u, static_cast<std::uint8_t>(iris::Packet::max_fragments + 1u));
+    ASSERT_FALSE((iris::Packet{iris::DataBuffer{p1.data(), p1.data() + p1.packet_size()}}.is_valid()));
+}
+
 TEST(packet, sequence)
 {
     iris::Packet p{
@@ -59,6 +176,19 @@ TEST(packet, sequence)
     ASSERT_EQ(p.sequence(), 10u);
 }
 
+TEST(packet, fragment)
+{
+    iris::Packet p1{
+        iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data};
+
+    p1.set_fragment(2u, 3u);
+
+    iris::Packet p2{iris::DataBuffer{p1.data(), p1.data() + p1.packet_size()}};
+
+    ASSERT_EQ(p2.fragment(), 2u);
+    ASSERT_EQ(p2.fragment_count(), 3u);
+}
+
 TEST(packet, equality)
 {
     iris::Packet p1{
@@ -6,13 +6,183 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <vector>
 
+#include "core/data_buffer.h"
 #include "networking/channel/reliable_ordered_channel.h"
+#include "networking/data_buffer_deserialiser.h"
+#include "networking/data_buffer_serialiser.h"
 #include "networking/packet.h"
+#include "networking/simulated_socket.h"
+#include "networking/socket.h"
 
 #include "helper.h"
 
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/**
+ * One direction of an in memory network link.
+ */
+struct Link
+{
+    std::mutex mutex;
+    std::deque<iris::DataBuffer> datagrams;
+};
+
+/**
+ * Socket which reads from one link and writes to another.
+ */
+class LinkSocket : public iris::Socket
+{
+  public:
+    LinkSocket(Link &in, Link &out)
+        : in_(in)
+        , out_(out)
+    {
+    }
+
+    std::optional<iris::DataBuffer> try_read(std::size_t) override
+    {
+        std::unique_lock lock(in_.mutex);
+
+        if (in_.datagrams.empty())
+        {
+            return std::nullopt;
+        }
+
+        auto datagram = std::move(in_.datagrams.front());
+        in_.datagrams.pop_front();
+
+        return datagram;
+    }
+
+    iris::DataBuffer read(std::size_t) override
+    {
+        return {};
+    }
+
+    std::optional<iris::DataBuffer> read(std::size_t, std::chrono::milliseconds) override
+    {
+        return std::nullopt;
+    }
+
+    void write(const iris::DataBuffer &buffer) override
+    {
+        std::unique_lock lock(out_.mutex);
+        out_.datagrams.emplace_back(buffer);
+    }
+
+    void write(const std::byte *data, std::size_t size) override
+    {
+        write({data, data + size});
+    }
+
+  private:
+    Link &in_;
+    Link &out_;
+};
+
+/**
+ * Send messages through a pair of channels over a lossy link, until they
+ * have all been received or we give up.
+ *
+ * @param drop_rate
+ *   Rate at which datagrams are dropped in both directions.
+ *
+ * @param message_count
+ *   Number of messages to send.
+ *
+ * @param message_size
+ *   Size of each message, large messages are fragmented.
+ *
+ * @returns
+ *   Number of data packets sent.
+ */
+std::size_t send_over_lossy_link(float drop_rate, std::size_t message_count, std::size_t message_size = 2u)
+{
+    Link to_sender{};
+    Link to_receiver{};
+    LinkSocket sender_link{to_sender, to_receiver};
+    LinkSocket receiver_link{to_receiver, to_sender};
+    iris::SimulatedSocket sender_socket{1ms, 0ms, drop_rate, &sender_link};
+    iris::SimulatedSocket receiver_socket{1ms, 0ms, drop_rate, &receiver_link};
+
+    iris::ReliableOrderedChannel sender{};
+    iris::ReliableOrderedChannel receiver{};
+
+    // a message takes up a sequence number per fragment
+    const auto fragments =
+        message_size > iris::Packet::max_body_size
+            ? (message_size + iris::Packet::max_body_size - 1u) / iris::Packet::max_body_size
+            : 1u;
+
+    std::vector<iris::Packet> expected{};
+    for (auto i = 0u; i < message_count; ++i)
+    {
+        iris::DataBuffer body(message_size, std::byte{0x42});
+        body[0u] = static_cast<std::byte>(i);
+        body[1u] = static_cast<std::byte>(i >> 8u);
+        iris::Packet packet{iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, body};
+
+        sender.enqueue_send(packet);
+
+        packet.set_sequence(static_cast<std::uint16_t>(i * fragments));
+        expected.emplace_back(std::move(packet));
+    }
+
+    std::vector<iris::Packet> received{};
+    std::size_t data_sent = 0u;
+    const auto deadline = std::chrono::steady_clock::now() + 30s;
+
+    while ((received.size() < message_count) && (std::chrono::steady_clock::now() < deadline))
+    {
+        for (const auto &packet : sender.yield_send_queue())
+        {
+            sender_socket.write(packet.data(), packet.packet_size());
+            ++data_sent;
+        }
+
+        for (const auto &packet : receiver.yield_send_queue())
+        {
+            receiver_socket.write(packet.data(), packet.packet_size());
+        }
+
+        std::this_thread::sleep_for(1ms);
+
+        while (const auto datagram = receiver_socket.try_read(iris::Packet::max_size))
+        {
+            receiver.enqueue_receive(iris::Packet{*datagram});
+        }
+
+        while (const auto datagram = sender_socket.try_read(iris::Packet::max_size))
+        {
+            sender.enqueue_receive(iris::Packet{*datagram});
+        }
+
+        for (auto &packet : receiver.yield_receive_queue())
+        {
+            received.emplace_back(std::move(packet));
+        }
+    }
+
+    EXPECT_EQ(received, expected);
+
+    return data_sent;
+}
+
+}
+
 TEST(reliable_ordered_channel, unacked_packet_is_resent)
 {
     const auto in_packets = create_packets({
@@ -25,8 +195,11 @@ TEST(reliable_ordered_channel, unacked_packet_is_resent)
         channel.enqueue_send(packet);
     }
 
-    ASSERT_EQ(channel.yield_send_queue(), in_packets);
-    ASSERT_EQ(channel.yield_send_queue(), in_packets);
+    const auto now = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(channel.yield_send_queue(now), in_packets);
+    ASSERT_TRUE(channel.yield_send_queue(now).empty());
+    ASSERT_EQ(channel.yield_send_queue(now + channel.rto()), in_packets);
     ASSERT_TRUE(channel.yield_receive_queue().empty());
 }
 
@@ -171,9 +344,7 @@ TEST(reliable_ordered_channel, multi_ack_multi_packet)
 
 TEST(reliable_ordered_channel, single_out_acked)
 {
-    const auto in_packets = create_packets({
-        {0u, iris::PacketType::ACK},
-    });
+    const std::vector<iris::Packet> in_packets{create_ack(0u, 0b0u)};
     const auto out_packets = create_packets({
         {0u, iris::PacketType::DATA},
     });
@@ -190,11 +361,7 @@ TEST(reliable_ordered_channel, single_out_acked)
 
 TEST(reliable_ordered_channel, multi_out_acked)
 {
-    const auto in_packets = create_packets({
-        {0u, iris::PacketType::ACK},
-        {1u, iris::PacketType::ACK},
-        {2u, iris::PacketType::ACK},
-    });
+    const std::vector<iris::Packet> in_packets{create_ack(2u, 0b11u)};
     const auto out_packets = create_packets({
         {0u, iris::PacketType::DATA},
         {1u, iris::PacketType::DATA},
@@ -213,12 +380,7 @@ TEST(reliable_ordered_channel, multi_out_acked)
 
 TEST(reliable_ordered_channel, multi_out_acked_unordered)
 {
-    const auto in_packets = create_packets({
-        {2u, iris::PacketType::ACK},
-        {0u, iris::PacketType::ACK},
-        {1u, iris::PacketType::ACK},
-        {3u, iris::PacketType::ACK},
-    });
+    const std::vector<iris::Packet> in_packets{create_ack(3u, 0b111u)};
     const auto out_packets = create_packets({
         {2u, iris::PacketType::DATA},
         {0u, iris::PacketType::DATA},
@@ -244,12 +406,7 @@ TEST(reliable_ordered_channel, multi_out_acked_unordered)
 
 TEST(reliable_ordered_channel, multi_out_acked_early_yield)
 {
-    const auto in_packets = create_packets({
-        {3u, iris::PacketType::ACK},
-        {1u, iris::PacketType::ACK},
-        {0u, iris::PacketType::ACK},
-        {2u, iris::PacketType::ACK},
-    });
+    const std::vector<iris::Packet> in_packets{create_ack(3u, 0b111u)};
     const auto out_packets = create_packets({
         {3u, iris::PacketType::DATA},
         {1u, iris::PacketType::DATA},
@@ -279,3 +436,332 @@ TEST(reliable_ordered_channel, multi_out_acked_early_yield)
     ASSERT_TRUE(out_queue3.empty());
     ASSERT_EQ(channel.yield_send_queue(), in_packets);
 }
+
+TEST(reliable_ordered_channel, large_packet_fragmented)
+{
+    iris::DataBuffer message(iris::Packet::max_body_size * 2u + 10u);
+    for (auto i = 0u; i < message.size(); ++i)
+    {
+        message[i] = static_cast<std::byte>(i);
+    }
+
+    iris::ReliableOrderedChannel channel{};
+    channel.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, message});
+
+    const auto fragments = channel.yield_send_queue();
+
+    ASSERT_EQ(fragments.size(), 3u);
+
+    iris::DataBuffer reassembled{};
+    for (auto i = 0u; i < fragments.size(); ++i)
+    {
+        ASSERT_LE(fragments[i].packet_size(), iris::Packet::max_size);
+        ASSERT_EQ(fragments[i].sequence(), i);
+        ASSERT_EQ(fragments[i].fragment(), i);
+        ASSERT_EQ(fragments[i].fragment_count(), 3u);
+
+        const auto body = fragments[i].body_buffer();
+        reassembled.insert(std::end(reassembled), std::cbegin(body), std::cend(body));
+    }
+
+    ASSERT_EQ(reassembled, message);
+}
+
+TEST(reliable_ordered_channel, fragments_reassembled)
+{
+    iris::DataBuffer message(iris::Packet::max_body_size * 3u);
+    for (auto i = 0u; i < message.size(); ++i)
+    {
+        message[i] = static_cast<std::byte>(i * 7u);
+    }
+
+    iris::ReliableOrderedChannel sender{};
+    sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data});
+    sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, message});
+    sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data});
+
+    const auto packets = sender.yield_send_queue();
+    ASSERT_EQ(packets.size(), 5u);
+
+    iris::ReliableOrderedChannel receiver{};
+
+    // deliver out of order, the message can only be yielded once every
+    // fragment has arrived
+    receiver.enqueue_receive(packets[0u]);
+    receiver.enqueue_receive(packets[3u]);
+    receiver.enqueue_receive(packets[1u]);
+
+    const auto yielded1 = receiver.yield_receive_queue();
+    ASSERT_EQ(yielded1.size(), 1u);
+    ASSERT_EQ(yielded1[0u].body_buffer(), test_data);
+
+    receiver.enqueue_receive(packets[4u]);
+    receiver.enqueue_receive(packets[2u]);
+
+    const auto yielded2 = receiver.yield_receive_queue();
+    ASSERT_EQ(yielded2.size(), 2u);
+    ASSERT_EQ(yielded2[0u].body_buffer(), message);
+    ASSERT_EQ(yielded2[0u].fragment_count(), 1u);
+    ASSERT_EQ(yielded2[1u].body_buffer(), test_data);
+    ASSERT_TRUE(receiver.yield_receive_queue().empty());
+}
+
+TEST(reliable_ordered_channel, ack_bitfield)
+{
+    const auto in_packets = create_packets({
+        {0u, iris::PacketType::DATA},
+        {0u, iris::PacketType::DATA},
+        {0u, iris::PacketType::DATA},
+        {0u, iris::PacketType::DATA},
+    });
+    const auto expected = create_packets({
+        {1u, iris::PacketType::DATA},
+    });
+    iris::ReliableOrderedChannel channel{};
+
+    for (const auto &packet : in_packets)
+    {
+        channel.enqueue_send(packet);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    ASSERT_EQ(channel.yield_send_queue(now).size(), 4u);
+
+    // ack 3, with bits for 2 and 0
+    channel.enqueue_receive(create_ack(3u, 0b101u), now);
+
+    ASSERT_EQ(channel.yield_send_queue(now + channel.rto()), expected);
+}
+
+TEST(reliable_ordered_channel, send_window)
+{
+    iris::ReliableOrderedChannel channel{};
+
+    for (auto i = 0u; i < iris::ReliableOrderedChannel::window_size + 8u; ++i)
+    {
+        channel.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data});
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    const auto first = channel.yield_send_queue(now);
+    ASSERT_EQ(first.size(), iris::ReliableOrderedChannel::window_size);
+    ASSERT_EQ(first.back().sequence(), iris::ReliableOrderedChannel::window_size - 1u);
+
+    // nothing else can be sent until the window moves
+    ASSERT_TRUE(channel.yield_send_queue(now).empty());
+
+    channel.enqueue_receive(create_ack(iris::ReliableOrderedChannel::window_size - 1u, 0xffffffffu), now);
+
+    const auto second = channel.yield_send_queue(now);
+    ASSERT_EQ(second.size(), 8u);
+    ASSERT_EQ(second.front().sequence(), iris::ReliableOrderedChannel::window_size);
+}
+
+TEST(reliable_ordered_channel, resend_backs_off)
+{
+    const auto in_packets = create_packets({
+        {0u, iris::PacketType::DATA},
+    });
+    iris::ReliableOrderedChannel channel{};
+    channel.enqueue_send(in_packets.front());
+
+    const auto rto = channel.rto();
+    const auto start = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(channel.yield_send_queue(start), in_packets);
+    ASSERT_EQ(channel.yield_send_queue(start + rto), in_packets);
+
+    // second resend waits twice as long
+    ASSERT_TRUE(channel.yield_send_queue(start + rto * 2).empty());
+    ASSERT_EQ(channel.yield_send_queue(start + rto * 3), in_packets);
+}
+
+TEST(reliable_ordered_channel, rtt_measured)
+{
+    iris::ReliableOrderedChannel channel{};
+    channel.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data});
+
+    const auto start = std::chrono::steady_clock::now();
+    channel.yield_send_queue(start);
+    channel.enqueue_receive(create_ack(0u, 0u), start + 50ms);
+
+    ASSERT_EQ(channel.rtt(), 50ms);
+    ASSERT_EQ(channel.rto(), 150ms);
+}
+
+TEST(reliable_ordered_channel, resent_packet_not_measured)
+{
+    iris::ReliableOrderedChannel channel{};
+    channel.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, test_data});
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto rto = channel.rto();
+    channel.yield_send_queue(start);
+    channel.yield_send_queue(start + rto);
+    channel.enqueue_receive(create_ack(0u, 0u), start + rto + 1ms);
+
+    ASSERT_EQ(channel.rtt(), 0ms);
+    ASSERT_EQ(channel.rto(), rto);
+}
+
+TEST(reliable_ordered_channel, duplicate_reacked)
+{
+    const auto out_packets = create_packets({
+        {0u, iris::PacketType::DATA},
+    });
+    const std::vector<iris::Packet> expected{create_ack(0u, 0u)};
+    iris::ReliableOrderedChannel channel{};
+
+    channel.enqueue_receive(out_packets.front());
+    ASSERT_EQ(channel.yield_send_queue(), expected);
+    ASSERT_TRUE(channel.yield_send_queue().empty());
+
+    // our ack may have been lost, so ack again
+    channel.enqueue_receive(out_packets.front());
+    ASSERT_EQ(channel.yield_send_queue(), expected);
+    ASSERT_EQ(channel.yield_receive_queue(), out_packets);
+}
+
+TEST(reliable_ordered_channel, first_ack_has_no_bits_before_zero)
+{
+    const auto out_packets = create_packets({
+        {0u, iris::PacketType::DATA},
+        {1u, iris::PacketType::DATA},
+    });
+    const std::vector<iris::Packet> expected{create_ack(1u, 0b1u)};
+    iris::ReliableOrderedChannel channel{};
+
+    for (const auto &packet : out_packets)
+    {
+        channel.enqueue_receive(packet);
+    }
+
+    // yield so the packets are behind the next expected sequence number
+    ASSERT_EQ(channel.yield_receive_queue(), out_packets);
+    ASSERT_EQ(channel.yield_send_queue(), expected);
+}
+
+TEST(reliable_ordered_channel, one_percent_loss)
+{
+    static constexpr auto message_count = 500u;
+
+    const auto sent = send_over_lossy_link(0.01f, message_count);
+
+    ASSERT_LT(sent, message_count * 11u / 10u);
+}
+
+TEST(reliable_ordered_channel, five_percent_loss)
+{
+    static constexpr auto message_count = 500u;
+
+    const auto sent = send_over_lossy_link(0.05f, message_count);
+
+    ASSERT_LT(sent, message_count * 13u / 10u);
+}
+
+TEST(reliable_ordered_channel, twenty_percent_loss)
+{
+    static constexpr auto message_count = 500u;
+
+    const auto sent = send_over_lossy_link(0.2f, message_count);
+
+    ASSERT_LT(sent, message_count * 2u);
+}
+
+TEST(reliable_ordered_channel, fragmented_messages_over_lossy_link)
+{
+    static constexpr auto message_count = 4u;
+
+    // each message has more fragments than the send window
+    const auto fragments = (iris::Packet::max_message_size + iris::Packet::max_body_size - 1u) /
+                           iris::Packet::max_body_size;
+    ASSERT_GT(fragments, iris::ReliableOrderedChannel::window_size);
+
+    const auto sent = send_over_lossy_link(0.05f, message_count, iris::Packet::max_message_size);
+
+    ASSERT_LT(sent, fragments * message_count * 2u);
+}
+
+TEST(reliable_ordered_channel, max_size_message_reassembled)
+{
+    const iris::DataBuffer body(iris::Packet::max_message_size, std::byte{0x42});
+    iris::ReliableOrderedChannel sender{};
+    iris::ReliableOrderedChannel receiver{};
+
+    sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, body});
+
+    std::vector<iris::Packet> received{};
+    auto now = std::chrono::steady_clock::now();
+
+    // the message has more fragments than the send window, so it takes a few
+    // round trips to get them all across
+    for (auto i = 0u; (i < 10u) && received.empty(); ++i)
+    {
+        for (auto &packet : sender.yield_send_queue(now))
+        {
+            receiver.enqueue_receive(std::move(packet), now);
+        }
+
+        for (auto &packet : receiver.yield_send_queue(now))
+        {
+            sender.enqueue_receive(std::move(packet), now);
+        }
+
+        received = receiver.yield_receive_queue();
+        now += 1ms;
+    }
+
+    ASSERT_EQ(received.size(), 1u);
+    ASSERT_EQ(received.front().body_buffer(), body);
+}
+
+TEST(reliable_ordered_channel, sustained_throughput_wraparound)
+{
+    // enough to wrap the 16 bit sequence number
+    static constexpr auto message_count = 70000u;
+
+    iris::ReliableOrderedChannel sender{};
+    iris::ReliableOrderedChannel receiver{};
+
+    for (auto i = 0u; i < message_count; ++i)
+    {
+        iris::DataBufferSerialiser serialiser{};
+        serialiser.push(static_cast<std::uint32_t>(i));
+        sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::RELIABLE_ORDERED, serialiser.data()});
+    }
+
+    std::uint32_t next = 0u;
+    std::size_t sent = 0u;
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto step = 0u; (step < 100000u) && (next < message_count); ++step)
+    {
+        auto packets = sender.yield_send_queue(now);
+
+        // deliver in reverse to reorder packets, and drop some
+        for (auto iter = std::rbegin(packets); iter != std::rend(packets); ++iter)
+        {
+            if ((++sent % 101u) != 0u)
+            {
+                receiver.enqueue_receive(std::move(*iter), now);
+            }
+        }
+
+        for (auto &packet : receiver.yield_send_queue(now))
+        {
+            sender.enqueue_receive(std::move(packet), now);
+        }
+
+        for (const auto &packet : receiver.yield_receive_queue())
+        {
+            iris::DataBufferDeserialiser deserialiser{packet.body_buffer()};
+            ASSERT_EQ(deserialiser.pop<std::uint32_t>(), next);
+            ++next;
+        }
+
+        now += 1ms;
+    }
+
+    ASSERT_EQ(next, message_count);
+}
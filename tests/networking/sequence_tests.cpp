@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+
+#include "networking/sequence.h"
+
+TEST(sequence, greater_than)
+{
+    ASSERT_TRUE(iris::sequence_greater_than(1u, 0u));
+    ASSERT_TRUE(iris::sequence_greater_than(32767u, 0u));
+    ASSERT_FALSE(iris::sequence_greater_than(32768u, 0u));
+    ASSERT_FALSE(iris::sequence_greater_than(0u, 1u));
+    ASSERT_FALSE(iris::sequence_greater_than(1u, 1u));
+}
+
+TEST(sequence, greater_than_wraparound)
+{
+    ASSERT_TRUE(iris::sequence_greater_than(0u, 65535u));
+    ASSERT_TRUE(iris::sequence_greater_than(10u, 65530u));
+    ASSERT_FALSE(iris::sequence_greater_than(65535u, 0u));
+    ASSERT_FALSE(iris::sequence_greater_than(32769u, 0u));
+}
+
+TEST(sequence, less_than)
+{
+    ASSERT_TRUE(iris::sequence_less_than(0u, 1u));
+    ASSERT_TRUE(iris::sequence_less_than(65535u, 0u));
+    ASSERT_FALSE(iris::sequence_less_than(1u, 0u));
+    ASSERT_FALSE(iris::sequence_less_than(0u, 65535u));
+    ASSERT_FALSE(iris::sequence_less_than(1u, 1u));
+}
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/data_buffer.h"
+#include "core/exception.h"
+#include "networking/channel/channel_type.h"
+#include "networking/server_connection_handler.h"
+#include "networking/server_socket.h"
+#include "networking/server_socket_data.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/**
+ * ServerSocket which fails on every read.
+ */
+class FailingServerSocket : public iris::ServerSocket
+{
+  public:
+    iris::ServerSocketData read() override
+    {
+        throw std::runtime_error("read failed");
+    }
+
+    std::optional<iris::ServerSocketData> read(std::chrono::milliseconds) override
+    {
+        throw std::runtime_error("read failed");
+    }
+};
+
+}
+
+TEST(server_connection_handler, update_throws_once_reader_stops)
+{
+    iris::ServerConnectionHandler server{
+        std::make_unique<FailingServerSocket>(),
+        [](std::size_t) {},
+        [](std::size_t, const iris::DataBuffer &, iris::ChannelType) {}};
+
+    // the reader thread dies on its first read, which we only find out about
+    // on a later update
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    auto threw = false;
+
+    while (!threw && (std::chrono::steady_clock::now() < deadline))
+    {
+        try
+        {
+            server.update();
+            std::this_thread::sleep_for(1ms);
+        }
+        catch (const iris::Exception &)
+        {
+            threw = true;
+        }
+    }
+
+    ASSERT_TRUE(threw);
+}
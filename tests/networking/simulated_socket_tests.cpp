@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "core/data_buffer.h"
+#include "networking/simulated_socket.h"
+#include "networking/socket.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+/**
+ * Socket which records everything written to it.
+ */
+class RecordingSocket : public iris::Socket
+{
+  public:
+    std::optional<iris::DataBuffer> try_read(std::size_t) override
+    {
+        return std::nullopt;
+    }
+
+    iris::DataBuffer read(std::size_t) override
+    {
+        return {};
+    }
+
+    std::optional<iris::DataBuffer> read(std::size_t, std::chrono::milliseconds) override
+    {
+        return std::nullopt;
+    }
+
+    void write(const iris::DataBuffer &buffer) override
+    {
+        std::unique_lock lock(mutex_);
+        written_.emplace_back(buffer);
+    }
+
+    void write(const std::byte *data, std::size_t size) override
+    {
+        write({data, data + size});
+    }
+
+    std::vector<iris::DataBuffer> written()
+    {
+        std::unique_lock lock(mutex_);
+        return written_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<iris::DataBuffer> written_;
+};
+
+}
+
+TEST(simulated_socket, write_is_delayed)
+{
+    RecordingSocket socket{};
+    iris::SimulatedSocket simulated{20ms, 0ms, 0.0f, &socket};
+    const iris::DataBuffer buffer{std::byte{0x1}, std::byte{0x2}};
+
+    simulated.write(buffer);
+
+    ASSERT_TRUE(socket.written().empty());
+
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (socket.written().empty() && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    ASSERT_EQ(socket.written(), std::vector<iris::DataBuffer>{buffer});
+}
+
+TEST(simulated_socket, destructor_does_not_wait_for_delayed_writes)
+{
+    RecordingSocket socket{};
+    const auto start = std::chrono::steady_clock::now();
+
+    {
+        iris::SimulatedSocket simulated{60s, 0ms, 0.0f, &socket};
+        simulated.write({std::byte{0x1}});
+    }
+
+    ASSERT_LT(std::chrono::steady_clock::now() - start, 10s);
+    ASSERT_TRUE(socket.written().empty());
+}
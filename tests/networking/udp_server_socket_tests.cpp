@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "core/data_buffer.h"
+#include "networking/datagram.h"
+#include "networking/server_socket_data.h"
+#include "networking/socket.h"
+#include "networking/udp_server_socket.h"
+#include "networking/udp_socket.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+static constexpr auto port = 8898u;
+
+/**
+ * Read from a server until count datagrams have arrived or we give up.
+ *
+ * @param server
+ *   Socket to read from.
+ *
+ * @param count
+ *   Number of datagrams to wait for.
+ *
+ * @returns
+ *   All read datagrams.
+ */
+std::vector<iris::ServerSocketData> read_all(iris::UdpServerSocket &server, std::size_t count)
+{
+    std::vector<iris::ServerSocketData> batch{};
+    std::vector<iris::ServerSocketData> out{};
+
+    for (auto attempt = 0u; (attempt < 50u) && (out.size() < count); ++attempt)
+    {
+        const auto read = server.read_batch(100ms, batch);
+        out.insert(std::cend(out), std::cbegin(batch), std::cbegin(batch) + read);
+    }
+
+    return out;
+}
+
+}
+
+TEST(udp_server_socket, read_batch)
+{
+    iris::UdpServerSocket server{"127.0.0.1", port};
+    iris::UdpSocket client1{"127.0.0.1", port};
+    iris::UdpSocket client2{"127.0.0.1", port};
+
+    for (auto i = 0u; i < 3u; ++i)
+    {
+        client1.write({std::byte{0x1}, static_cast<std::byte>(i)});
+        client2.write({std::byte{0x2}, static_cast<std::byte>(i)});
+    }
+
+    const auto read = read_all(server, 6u);
+    ASSERT_EQ(read.size(), 6u);
+
+    std::set<iris::Socket *> clients{};
+    std::vector<iris::DataBuffer> data{};
+    auto new_connections = 0u;
+
+    for (const auto &[client, buffer, new_connection] : read)
+    {
+        clients.emplace(client);
+        data.emplace_back(buffer);
+        new_connections += new_connection ? 1u : 0u;
+    }
+
+    // clients on the same address are told apart by port
+    ASSERT_EQ(clients.size(), 2u);
+    ASSERT_EQ(new_connections, 2u);
+
+    const std::vector<iris::DataBuffer> expected{
+        {std::byte{0x1}, std::byte{0x0}},
+        {std::byte{0x1}, std::byte{0x1}},
+        {std::byte{0x1}, std::byte{0x2}},
+        {std::byte{0x2}, std::byte{0x0}},
+        {std::byte{0x2}, std::byte{0x1}},
+        {std::byte{0x2}, std::byte{0x2}}};
+    ASSERT_THAT(data, ::testing::UnorderedElementsAreArray(expected));
+}
+
+TEST(udp_server_socket, read_batch_timeout)
+{
+    iris::UdpServerSocket server{"127.0.0.1", port};
+    std::vector<iris::ServerSocketData> batch{};
+
+    ASSERT_EQ(server.read_batch(10ms, batch), 0u);
+}
+
+TEST(udp_server_socket, write_batch)
+{
+    iris::UdpServerSocket server{"127.0.0.1", port};
+    iris::UdpSocket client1{"127.0.0.1", port};
+    iris::UdpSocket client2{"127.0.0.1", port};
+
+    // server only knows about clients once they have sent something
+    client1.write({std::byte{0x1}});
+    client2.write({std::byte{0x2}});
+
+    const auto read = read_all(server, 2u);
+    ASSERT_EQ(read.size(), 2u);
+
+    auto *client1_server = read[0].data.front() == std::byte{0x1} ? read[0].client : read[1].client;
+    auto *client2_server = read[0].data.front() == std::byte{0x2} ? read[0].client : read[1].client;
+
+    const iris::DataBuffer reply1{std::byte{0xa}, std::byte{0xb}};
+    const iris::DataBuffer reply2{std::byte{0xc}};
+    const iris::DataBuffer reply3{std::byte{0xd}, std::byte{0xe}, std::byte{0xf}};
+
+    server.write_batch(
+        {{client1_server, reply1.data(), reply1.size()},
+         {client2_server, reply2.data(), reply2.size()},
+         {client1_server, reply3.data(), reply3.size()}});
+
+    ASSERT_EQ(client1.read(16u, 1s), reply1);
+    ASSERT_EQ(client1.read(16u, 1s), reply3);
+    ASSERT_EQ(client2.read(16u, 1s), reply2);
+}
@@ -6,6 +6,7 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <vector>
 
 #include "networking/channel/unreliable_sequenced_channel.h"
@@ -290,3 +291,54 @@ TEST(
     ASSERT_TRUE(yielded_packets[3u].empty());
     ASSERT_TRUE(yielded_packets[4u].empty());
 }
+
+TEST(unreliable_sequenced_channel, out_queue_wraparound)
+{
+    const auto out_packets = create_packets({
+        {32767u, iris::PacketType::DATA},
+        {65534u, iris::PacketType::DATA},
+        {65535u, iris::PacketType::DATA},
+        {0u, iris::PacketType::DATA},
+        {65533u, iris::PacketType::DATA},
+        {1u, iris::PacketType::DATA},
+        {65535u, iris::PacketType::DATA},
+    });
+    const auto expected = create_packets({
+        {32767u, iris::PacketType::DATA},
+        {65534u, iris::PacketType::DATA},
+        {65535u, iris::PacketType::DATA},
+        {0u, iris::PacketType::DATA},
+        {1u, iris::PacketType::DATA},
+    });
+    iris::UnreliableSequencedChannel channel{};
+
+    for (const auto &packet : out_packets)
+    {
+        channel.enqueue_receive(packet);
+    }
+
+    ASSERT_EQ(channel.yield_receive_queue(), expected);
+}
+
+TEST(unreliable_sequenced_channel, sustained_throughput)
+{
+    static constexpr auto message_count = 70000u;
+
+    iris::UnreliableSequencedChannel sender{};
+    iris::UnreliableSequencedChannel receiver{};
+    std::size_t received = 0u;
+
+    for (auto i = 0u; i < message_count; ++i)
+    {
+        sender.enqueue_send({iris::PacketType::DATA, iris::ChannelType::UNRELIABLE_SEQUENCED, test_data});
+
+        for (auto &packet : sender.yield_send_queue())
+        {
+            receiver.enqueue_receive(std::move(packet));
+        }
+
+        received += receiver.yield_receive_queue().size();
+    }
+
+    ASSERT_EQ(received, message_count);
+}
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "core/data_buffer.h"
+#include "core/exception.h"
 #include "networking/channel/unreliable_unordered_channel.h"
 #include "networking/packet.h"
 
@@ -150,3 +151,13 @@ TEST(unreliable_unordered_channel, out_queue_multi_early_yield)
             std::cbegin(out_packets) + 2u, std::cend(out_packets)));
     ASSERT_TRUE(yielded_packets[3u].empty());
 }
+
+TEST(unreliable_unordered_channel, large_packet_rejected)
+{
+    const iris::DataBuffer body(iris::Packet::max_body_size + 1u, std::byte{0xaa});
+    iris::UnreliableUnorderedChannel channel{};
+
+    ASSERT_THROW(
+        channel.enqueue_send({iris::PacketType::DATA, iris::ChannelType::UNRELIABLE_UNORDERED, body}),
+        iris::Exception);
+}
@@ -0,0 +1,26 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/cpu_topology.h"
+
+#include <sched.h>
+
+#include <gtest/gtest.h>
+
+TEST(cpu_topology, detect_respects_affinity)
+{
+    ::cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    ASSERT_EQ(::sched_getaffinity(0, sizeof(cpu_set), &cpu_set), 0);
+
+    const auto topology = iris::CpuTopology::detect();
+
+    ASSERT_FALSE(topology.cpus().empty());
+    for (const auto &cpu : topology.cpus())
+    {
+        ASSERT_TRUE(CPU_ISSET(cpu.id, &cpu_set));
+    }
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+//         Distributed under the Boost Software License, Version 1.0.         //
+//            (See accompanying file LICENSE or copy at                       //
+//                 https://www.boost.org/LICENSE_1_0.txt)                     //
+////////////////////////////////////////////////////////////////////////////////
+
+#include "core/thread.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+#include <gtest/gtest.h>
+
+#include "core/exception.h"
+
+namespace
+{
+
+/**
+ * Helper to get the cpus the calling thread is allowed to run on.
+ */
+std::vector<std::size_t> allowed_cpus()
+{
+    ::cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    ::sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+
+    std::vector<std::size_t> cpus{};
+    for (auto i = 0u; i < CPU_SETSIZE; ++i)
+    {
+        if (CPU_ISSET(i, &cpu_set))
+        {
+            cpus.emplace_back(i);
+        }
+    }
+
+    return cpus;
+}
+
+}
+
+TEST(thread, invalid_bind)
+{
+    iris::Thread thrd{};
+    ASSERT_THROW(thrd.bind_to_core(CPU_SETSIZE), iris::Exception);
+}
+
+TEST(thread, bind_to_allowed_cpu)
+{
+    // the highest allowed id is the one most likely to be past the cpu count
+    // if ids are sparse
+    const auto cpu = allowed_cpus().back();
+    std::atomic<bool> bound = false;
+    std::atomic<int> ran_on = -1;
+
+    iris::Thread thrd{[&bound, &ran_on]()
+                      {
+                          while (!bound)
+                          {
+                              std::this_thread::yield();
+                          }
+
+                          ran_on = ::sched_getcpu();
+                      }};
+
+    thrd.bind_to_core(cpu);
+    bound = true;
+    thrd.join();
+
+    ASSERT_EQ(ran_on, static_cast<int>(cpu));
+}
+
+TEST(thread, bind_to_disallowed_cpu)
+{
+    const auto cpus = allowed_cpus();
+    if (cpus.size() == CPU_SETSIZE)
+    {
+        GTEST_SKIP() << "every cpu is allowed";
+    }
+
+    auto cpu = 0u;
+    while (cpu < cpus.size() && cpus[cpu] == cpu)
+    {
+        ++cpu;
+    }
+
+    std::atomic<bool> done = false;
+    iris::Thread thrd{[&done]()
+                      {
+                          while (!done)
+                          {
+                              std::this_thread::yield();
+                          }
+                      }};
+
+    // don't return before joining
+    EXPECT_THROW(thrd.bind_to_core(cpu), iris::Exception);
+
+    done = true;
+    thrd.join();
+}